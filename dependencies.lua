@@ -5,9 +5,12 @@ includes["GLAD"] = "%{wks.location}/dependencies/glfw/include"
 includes["IMGUI"] = "%{wks.location}/dependencies/imgui"
 includes["IMGUIZMO"] = "%{wks.location}/dependencies/imguizmo"
 includes["FREETYPE"] = "%{wks.location}/dependencies/freetype/include"
+includes["LUA"] = "%{wks.location}/dependencies/lua/src"
+includes["LZ4"] = "%{wks.location}/dependencies/lz4/lib"
 
 -- vendor
 includes["GLM"] = "%{wks.location}/dependencies/vendor/glm/include"
 includes["STB"] = "%{wks.location}/dependencies/vendor/stb"
-includes["SOL"] = "%{wks.location}/dependencies/vendor/sol"
+-- sol.hpp includes <sol/config.hpp>, so the parent directory is the include root
+includes["SOL"] = "%{wks.location}/dependencies/vendor"
 includes["ENTT"] = "%{wks.location}/dependencies/vendor/entt"
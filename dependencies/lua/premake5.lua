@@ -0,0 +1,64 @@
+-- Lua 5.4, built from the official release sources in src/. They are not part of the repository:
+-- the pinned release is downloaded and unpacked on the first generation of a fresh clone.
+local LuaVersion = "5.4.6"
+local luaDir = path.getdirectory(_SCRIPT)
+
+if not os.isfile(path.join(luaDir, "src/lua.h")) then
+	local archive = path.join(luaDir, "lua-" .. LuaVersion .. ".tar.gz")
+	print("Downloading Lua " .. LuaVersion .. "...")
+
+	local result, code = http.download("https://www.lua.org/ftp/lua-" .. LuaVersion .. ".tar.gz", archive)
+	if result ~= "OK" or code ~= 200 then
+		error("Failed to download Lua " .. LuaVersion .. " (" .. tostring(result) .. "), place its src/ folder in " .. luaDir .. "/src")
+	end
+
+	-- tar ships with Windows 10 and later, Linux and macOS
+	if not os.execute('tar -xzf "' .. archive .. '" -C "' .. luaDir .. '"') then
+		error("Failed to extract " .. archive)
+	end
+
+	os.rename(path.join(luaDir, "lua-" .. LuaVersion .. "/src"), path.join(luaDir, "src"))
+	os.rmdir(path.join(luaDir, "lua-" .. LuaVersion))
+	os.remove(archive)
+end
+
+project "LUA"
+	kind "StaticLib"
+	language "C"
+	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
+	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
+
+	files
+	{
+		"src/*.h",
+		"src/*.hpp",
+		"src/*.c"
+	}
+
+	removefiles
+	{
+		-- standalone interpreter and compiler
+		"src/lua.c",
+		"src/luac.c"
+	}
+
+	includedirs
+	{
+		"src"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+        runtime "Debug"
+        symbols "on"
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "on"
@@ -0,0 +1,35 @@
+-- LZ4, built from the official release sources placed in lib/ (only with --with-lz4)
+project "LZ4"
+	kind "StaticLib"
+	language "C"
+	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
+	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
+
+	files
+	{
+		"lib/lz4.h",
+		"lib/lz4.c",
+		"lib/lz4hc.h",
+		"lib/lz4hc.c"
+	}
+
+	includedirs
+	{
+		"lib"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
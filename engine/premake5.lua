@@ -1,7 +1,7 @@
 project "Hyper"
 	kind "StaticLib"
 	language "C++"
-	cppdialect "C++17"
+	cppdialect "C++20"
 	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
 	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
 
@@ -30,19 +30,31 @@ project "Hyper"
 		"%{includes.IMGUI}",
 		"%{includes.ENTT}",
 		"%{includes.IMGUIZMO}",
-		"%{includes.FREETYPE}"
+		"%{includes.FREETYPE}",
+		"%{includes.SOL}",
+		"%{includes.LUA}"
 	}
 	
 	links
 	{
-		"GLFW", "GLAD", "IMGUI", "opengl32.lib", "FREETYPE"
+		"GLFW", "GLAD", "IMGUI", "opengl32.lib", "FREETYPE", "LUA"
 	}
 
 	filter "files:vendor/imguizmo/**.cpp"
 	flags {"NoPCH"}
 
+	filter "options:track-allocations"
+		defines "HYPER_TRACK_ALLOCATIONS"
+
+	filter "options:with-lz4"
+		defines "HYPER_ARCHIVE_LZ4"
+		includedirs "%{includes.LZ4}"
+		links "LZ4"
+
 	filter "system:windows"
 		systemversion "latest"
+		-- metrics exporter socket
+		links "ws2_32"
 
 	filter "configurations:Debug"
 		defines {"HYPER_DEBUG", "HYPER_ASSERTION_ENABLED"}
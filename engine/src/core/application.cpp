@@ -1,51 +1,204 @@
 #include <core/application.hpp>
 #include <core/timer.hpp>
+#include <core/job_system.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <debug/metrics.hpp>
+#include <io/file_system.hpp>
+#include <opengl/debug_output.hpp>
+#include <renderer/resources.hpp>
+#include <scripting/script_engine.hpp>
+#include <scripting/script_scheduler.hpp>
+#include <ui/performance_overlay.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <utils/logger.hpp>
 
 hyp::Application* hyp::Application::sInstance = nullptr;
 
+namespace {
+	// feeds FrameTimings, cheap enough to stay on in release builds
+	class PhaseTimer {
+	public:
+		PhaseTimer(hyp::FrameTimings& timings, hyp::FramePhase phase)
+		    : m_target(timings.phaseMs[(size_t)phase]), m_start(std::chrono::steady_clock::now()) {}
+
+		~PhaseTimer() {
+			m_target += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+		}
+
+	private:
+		float& m_target;
+		std::chrono::steady_clock::time_point m_start;
+	};
+}
+
 hyp::Application::Application(const WindowProps& ws) {
 	HYP_ASSERT_CORE(sInstance == nullptr, "application already exists");
 	sInstance = this;
+	HYP_PROFILE_SCOPE("Application::init");
+
+	hyp::JobSystem::init();
+
+	// packaged builds ship their assets in one archive, development reads the loose files
+	if (std::filesystem::exists("assets.hpak"))
+	{
+		hyp::FileSystem::mount("assets.hpak");
+	}
+
+	// rasterized on the workers while the window and the GL context come up
+	hyp::Resources::preloadFont(hyp::Font::DefaultPath);
+
+	{
+		HYP_PROFILE_SCOPE("ScriptEngine::init");
+		hyp::ScriptEngine::init();
+	}
 
-	m_window = hyp::Window::create(ws);
+	{
+		HYP_PROFILE_SCOPE("Window::create");
+		m_window = hyp::Window::create(ws);
+	}
 	m_running = true;
 	m_window->setEventCallback(BIND_EVENT_FN(Application::onEvent));
 
 	this->m_uiLayer = new hyp::ImGuiLayer();
+	this->m_performanceOverlay = new hyp::PerformanceOverlay();
 
 	pushOverlay(this->m_uiLayer);
+	// after the UI layer, so it sees input first and draws on top
+	pushOverlay(this->m_performanceOverlay);
+
+	// Lua garbage is collected in the frame's slack, the automatic collector only backs it up
+	m_idleScheduler.post(
+	    "script-gc", []() {
+		    hyp::ScriptEngine::collectGarbage(0.25);
+		    return false;
+	    },
+	    hyp::IdlePriority::Low);
+}
+
+hyp::Application::~Application() {
+	// finish in-flight jobs before the schedulers waiting on them go away
+	hyp::JobSystem::deinit();
+	m_coroutineScheduler.stopAll();
+	hyp::ScriptEngine::deinit();
+	hyp::FileSystem::unmountAll();
+	hyp::Metrics::stopExporter();
 }
 
 void hyp::Application::run() {
 	float last_frame = 0.f;
+	hyp::Histogram& frameTime = hyp::Metrics::histogram("frame.time_us");
+	hyp::Counter& frameCount = hyp::Metrics::counter("frame.count");
+
+	// scoped to the loop: its queries need the context, which Device::deinit destroys before the Application goes
+	m_gpuTimer = hyp::CreateScope<hyp::GpuTimer>();
+
 	while (m_running && m_window->isRunning())
 	{
 		hyp::Timer::postTick();
-
+		auto frameStart = std::chrono::steady_clock::now();
+		hyp::FlightRecorder::beginFrame();
+		hyp::MemoryTracker::newFrame();
+		hyp::OpenglDebugOutput::newFrame();
+		hyp::Resources::newFrame();
+		m_gpuTimer->begin();
+
+		FrameTimings timings;
 		float dt = hyp::Timer::getDeltaTime();
 
 		if (!this->m_minimized)
 		{
+			m_fixedAccumulator += dt;
+
+			HYP_PROFILE_SCOPE("Application::update");
+
+			{
+				PhaseTimer phase(timings, FramePhase::FixedUpdate);
+				uint32_t steps = 0;
+				while (m_fixedAccumulator >= m_fixedTimeStep && steps < m_maxFixedSteps)
+				{
+					HYP_PROFILE_SCOPE("Application::fixedUpdate");
+					m_timers.tick();
+					for (auto layer : m_layerStack)
+					{
+						layer->onFixedUpdate(m_fixedTimeStep);
+					}
+
+					m_coroutineScheduler.resumeFixedStep();
+					m_fixedAccumulator -= m_fixedTimeStep;
+					steps++;
+				}
+
+				if (steps == m_maxFixedSteps)
+				{
+					m_fixedAccumulator = std::min(m_fixedAccumulator, m_fixedTimeStep);
+				}
+			}
+
+			{
+				HYP_PROFILE_SCOPE("Coroutines");
+				PhaseTimer phase(timings, FramePhase::Coroutines);
+				m_coroutineScheduler.resumeFrame(dt);
+			}
+
+			{
+				PhaseTimer phase(timings, FramePhase::Scripts);
+				hyp::ScriptEngine::getScheduler().run(m_scriptBudgetMs);
+			}
+
+			PhaseTimer phase(timings, FramePhase::Update);
 			for (auto layer : m_layerStack)
 			{
+				HYP_PROFILE_SCOPE("Layer::onUpdate");
 				layer->onUpdate(dt);
 			}
 		}
 
-		m_uiLayer->begin();
-
 		{
+			HYP_PROFILE_SCOPE("ImGui");
+			PhaseTimer phase(timings, FramePhase::UI);
+			m_uiLayer->begin();
+
 			for (auto layer : m_layerStack)
 			{
 				layer->onUIRender();
 			}
+
+			m_uiLayer->end();
+		}
+
+		// spend what is left of the frame on deferred work
+		{
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+			float budget = hyp::Timer::getTargetFrameTimeMs() - elapsed - m_idleMarginMs;
+
+			HYP_PROFILE_SCOPE("IdleScheduler");
+			PhaseTimer phase(timings, FramePhase::Idle);
+			m_idleScheduler.run(budget);
 		}
 
-		m_uiLayer->end();
+		m_gpuTimer->end();
 
-		m_window->onUpdate();
+		{
+			HYP_PROFILE_SCOPE("Window::swap");
+			PhaseTimer phase(timings, FramePhase::Swap);
+			m_window->onUpdate();
+		}
+
+		hyp::FlightRecorder::endFrame();
+
+		auto frameDuration = std::chrono::steady_clock::now() - frameStart;
+		timings.cpuMs = std::chrono::duration<float, std::milli>(frameDuration).count();
+		timings.gpuMs = m_gpuTimer->getLastMs();
+		m_frameTimings = timings;
+
+		frameTime.record(std::chrono::duration_cast<std::chrono::microseconds>(frameDuration).count());
+		frameCount.add();
 	}
+
+	m_gpuTimer.reset();
 }
 
 const hyp::Unique<hyp::Window>& hyp::Application::getWindow() const {
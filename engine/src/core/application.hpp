@@ -3,17 +3,48 @@
 // clang-format off
 #include <glad/glad.h>
 #include <core/layer_stack.hpp>
+#include <core/coroutine.hpp>
+#include <core/idle_scheduler.hpp>
+#include <core/timer_wheel.hpp>
 #include <core/window.hpp>
+#include <opengl/gpu_timer.hpp>
 #include <ui/imgui_layer.hpp>
+#include <array>
 // clang-format on
 
 int main(int argc, char** argv);
 
 namespace hyp {
 
+	class PerformanceOverlay;
+
+	enum class FramePhase : uint8_t
+	{
+		FixedUpdate = 0,
+		Coroutines,
+		Scripts,
+		Update,
+		UI,
+		Idle,
+		Swap,
+		Count
+	};
+
+	/**
+	* \brief where the last completed frame spent its time
+	*/
+	struct FrameTimings
+	{
+		std::array<float, (size_t)FramePhase::Count> phaseMs {};
+		float cpuMs = 0.f;
+		// the GPU result lags a few frames behind, negative until one is available
+		float gpuMs = -1.f;
+	};
+
 	class HYPER_API Application : public hyp::NonCopyable {
 	public:
 		Application(const WindowProps& ws);
+		~Application();
 
 		static Application& get() { return *sInstance; }
 
@@ -27,6 +58,35 @@ namespace hyp {
 		void pushOverlay(Layer* overlay);
 
 		hyp::ImGuiLayer* getUILayer() { return m_uiLayer; }
+		hyp::PerformanceOverlay* getPerformanceOverlay() { return m_performanceOverlay; }
+
+		const FrameTimings& getFrameTimings() const { return m_frameTimings; }
+
+		hyp::IdleScheduler& getIdleScheduler() { return m_idleScheduler; }
+		hyp::CoroutineScheduler& getCoroutineScheduler() { return m_coroutineScheduler; }
+		/**
+		* \brief gameplay timers, ticked once per fixed step before the layers' onFixedUpdate
+		*/
+		hyp::TimerWheel& getTimers() { return m_timers; }
+
+		/**
+		* \brief duration of a fixed update step in seconds (1/60 by default)
+		*/
+		void setFixedTimeStep(float seconds) {
+			m_fixedTimeStep = seconds;
+			m_timers.setTickDuration(seconds);
+		}
+		float getFixedTimeStep() const { return m_fixedTimeStep; }
+
+		/**
+		* \brief time kept free at the end of each frame for the swap and event polling (ms)
+		*/
+		void setIdleMargin(float ms) { m_idleMarginMs = ms; }
+
+		/**
+		* \brief time given to the spawned Lua tasks every frame (ms)
+		*/
+		void setScriptBudget(float ms) { m_scriptBudgetMs = ms; }
 
 	private:
 		bool onResize(const WindowResizeEvent&);
@@ -38,7 +98,20 @@ namespace hyp {
 		bool m_running = false;
 		hyp::Scope<Window> m_window;
 		hyp::ImGuiLayer* m_uiLayer;
+		hyp::PerformanceOverlay* m_performanceOverlay;
+		hyp::Scope<hyp::GpuTimer> m_gpuTimer;
+		FrameTimings m_frameTimings;
 		hyp::LayerStack m_layerStack;
+		hyp::IdleScheduler m_idleScheduler;
+		hyp::CoroutineScheduler m_coroutineScheduler;
+		hyp::TimerWheel m_timers;
+		float m_idleMarginMs = 1.f;
+		float m_scriptBudgetMs = 2.f;
+
+		float m_fixedTimeStep = 1.f / 60.f;
+		float m_fixedAccumulator = 0.f;
+		// caps the catch-up after a long frame so a slow step can't snowball
+		uint32_t m_maxFixedSteps = 5;
 
 	private:
 		friend int ::main(int, char**);
@@ -0,0 +1,261 @@
+#include "coroutine.hpp"
+#include <debug/flight_recorder.hpp>
+#include <utils/assert.hpp>
+#include <utils/logger.hpp>
+#include <utils/pool_allocator.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace hyp {
+
+	namespace {
+		// frames are allocated and freed on the main thread in practice, the lock only
+		// keeps the pool sane if a coroutine is ever created elsewhere.
+		std::mutex s_frameMutex;
+
+		PoolAllocator& getFramePool() {
+			static PoolAllocator pool({ 128, 256, 512, 1024, 2048, 4096 });
+			return pool;
+		}
+	}
+
+	void* Coroutine::promise_type::operator new(size_t size) {
+		std::lock_guard<std::mutex> lock(s_frameMutex);
+		return getFramePool().allocate(size);
+	}
+
+	void Coroutine::promise_type::operator delete(void* ptr, size_t size) {
+		std::lock_guard<std::mutex> lock(s_frameMutex);
+		getFramePool().deallocate(ptr, size);
+	}
+
+	void Coroutine::promise_type::unhandled_exception() {
+		HYP_ERROR("unhandled exception in coroutine");
+		std::terminate();
+	}
+
+	Coroutine::~Coroutine() {
+		if (m_handle)
+		{
+			m_handle.destroy();
+		}
+	}
+
+	Coroutine& Coroutine::operator=(Coroutine&& other) noexcept {
+		if (this != &other)
+		{
+			if (m_handle) m_handle.destroy();
+			m_handle = other.m_handle;
+			other.m_handle = nullptr;
+		}
+		return *this;
+	}
+
+	Coroutine::Handle Coroutine::release() {
+		Handle handle = m_handle;
+		m_handle = nullptr;
+		return handle;
+	}
+
+	CoroutineScheduler::CoroutineScheduler() {
+		m_due.reserve(64);
+		m_woken.reserve(64);
+	}
+
+	CoroutineScheduler::~CoroutineScheduler() {
+		stopAll();
+	}
+
+	CoroutineId CoroutineScheduler::start(Coroutine&& coroutine) {
+		if (!coroutine.isValid()) return {};
+
+		uint32_t index;
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			HYP_ASSERT_CORE(m_slots.size() <= CoroutineId::IndexMask, "too many coroutines");
+			index = (uint32_t)m_slots.size();
+			m_slots.emplace_back();
+		}
+
+		Slot& slot = m_slots[index];
+		slot.handle = coroutine.release();
+		slot.cancelled = false;
+		m_runningCount++;
+
+		CoroutineId id(index, slot.generation);
+		slot.handle.promise().scheduler = this;
+		slot.handle.promise().id = id;
+
+		resume(id);
+		return id;
+	}
+
+	bool CoroutineScheduler::cancel(CoroutineId id) {
+		if (!isRunning(id)) return false;
+
+		// a running coroutine (the caller itself, or one further up the stack that started or
+		// resumed the caller) is destroyed by `resume` once it suspends
+		if (m_slots[id.getIndex()].running)
+		{
+			m_slots[id.getIndex()].cancelled = true;
+			return true;
+		}
+
+		destroy(id.getIndex());
+		return true;
+	}
+
+	void CoroutineScheduler::stopAll() {
+		for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++)
+		{
+			if (!m_slots[i].handle) continue;
+
+			if (m_slots[i].running)
+				m_slots[i].cancelled = true;
+			else
+				destroy(i);
+		}
+
+		m_frameWaits.clear();
+		m_timeWaits.clear();
+		m_fixedStepWaits.clear();
+
+		std::lock_guard<std::mutex> lock(m_wokenMutex);
+		m_woken.clear();
+	}
+
+	bool CoroutineScheduler::isRunning(CoroutineId id) const {
+		uint32_t index = id.getIndex();
+		if (id.isNull() || index >= m_slots.size()) return false;
+
+		const Slot& slot = m_slots[index];
+		return slot.handle && slot.generation == id.getGeneration();
+	}
+
+	void CoroutineScheduler::resumeFrame(float dt) {
+		m_frame++;
+		m_time += dt;
+		m_deltaTime = dt;
+
+		{
+			std::lock_guard<std::mutex> lock(m_wokenMutex);
+			m_due.insert(m_due.end(), m_woken.begin(), m_woken.end());
+			m_woken.clear();
+		}
+
+		popDue(m_frameWaits, m_frame);
+		popDue(m_timeWaits, m_time);
+		resumeCollected();
+	}
+
+	void CoroutineScheduler::resumeFixedStep() {
+		m_fixedStep++;
+
+		popDue(m_fixedStepWaits, m_fixedStep);
+		resumeCollected();
+	}
+
+	void CoroutineScheduler::waitFrame(CoroutineId id, uint64_t frame) {
+		m_frameWaits.push_back({ frame, id });
+		std::push_heap(m_frameWaits.begin(), m_frameWaits.end());
+	}
+
+	void CoroutineScheduler::waitTime(CoroutineId id, double time) {
+		m_timeWaits.push_back({ time, id });
+		std::push_heap(m_timeWaits.begin(), m_timeWaits.end());
+	}
+
+	void CoroutineScheduler::waitFixedStep(CoroutineId id, uint64_t step) {
+		m_fixedStepWaits.push_back({ step, id });
+		std::push_heap(m_fixedStepWaits.begin(), m_fixedStepWaits.end());
+	}
+
+	void CoroutineScheduler::wakeUp(CoroutineId id) {
+		std::lock_guard<std::mutex> lock(m_wokenMutex);
+		m_woken.push_back(id);
+	}
+
+	template <typename Key>
+	void CoroutineScheduler::popDue(std::vector<Wait<Key>>& heap, Key now) {
+		while (!heap.empty() && heap.front().key <= now)
+		{
+			m_due.push_back(heap.front().id);
+			std::pop_heap(heap.begin(), heap.end());
+			heap.pop_back();
+		}
+	}
+
+	void CoroutineScheduler::resumeCollected() {
+		// waits registered while resuming land in the heaps, never in m_due, so
+		// a coroutine waiting on the current frame/step can't spin here
+		for (size_t i = 0; i < m_due.size(); i++)
+		{
+			resume(m_due[i]);
+		}
+		m_due.clear();
+	}
+
+	void CoroutineScheduler::resume(CoroutineId id) {
+		// stale ids of cancelled coroutines are left in the heaps and skipped here
+		if (!isRunning(id)) return;
+
+		// by index: coroutines started while this one runs may grow m_slots
+		uint32_t index = id.getIndex();
+		m_slots[index].running = true;
+		m_slots[index].handle.resume();
+		m_slots[index].running = false;
+
+		if (m_slots[index].handle.done() || m_slots[index].cancelled)
+		{
+			destroy(index);
+		}
+	}
+
+	void CoroutineScheduler::destroy(uint32_t index) {
+		Slot& slot = m_slots[index];
+		slot.handle.destroy();
+		slot.handle = nullptr;
+		slot.cancelled = false;
+		slot.running = false;
+		m_runningCount--;
+
+		// like the resource registries, retire slots whose generation saturated
+		if (slot.generation < CoroutineId::MaxGeneration)
+		{
+			slot.generation++;
+			m_freeSlots.push_back(index);
+		}
+	}
+
+	void loadTextureAsync::await_suspend(Coroutine::Handle handle) {
+		CoroutineScheduler* scheduler = handle.promise().scheduler;
+		CoroutineId id = handle.promise().id;
+
+		// the job keeps its own reference to the image, the coroutine may be cancelled meanwhile
+		hyp::Ref<ImageData> target = image;
+		std::string file = path;
+
+		JobHandle job = JobSystem::schedule([target, file]() {
+			HYP_PROFILE_ASSET(file);
+			Texture::decode(file, *target);
+		});
+		job.then([scheduler, id]() { scheduler->wakeUp(id); });
+	}
+
+	TextureHandle loadTextureAsync::await_resume() {
+		if (!image->isValid())
+		{
+			HYP_WARN("Failed to load texture %s", path.c_str());
+			return {};
+		}
+
+		auto texture = hyp::CreateRef<Texture2D>(*image, path);
+		image.reset();
+		return Resources::addTexture(texture);
+	}
+}
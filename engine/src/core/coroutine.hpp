@@ -0,0 +1,253 @@
+#pragma once
+#ifndef HYPER_COROUTINE_HPP
+	#define HYPER_COROUTINE_HPP
+
+	#include <core/handle.hpp>
+	#include <core/job_system.hpp>
+	#include <renderer/resources.hpp>
+	#include <renderer/texture.hpp>
+	#include <coroutine>
+	#include <cstddef>
+	#include <cstdint>
+	#include <mutex>
+	#include <string>
+	#include <vector>
+
+namespace hyp {
+
+	class Coroutine;
+	class CoroutineScheduler;
+
+	using CoroutineId = hyp::Handle<Coroutine>;
+
+	/**
+	* \brief a gameplay coroutine, started suspended and driven by a CoroutineScheduler.
+	*
+	* Frames are allocated from a size-class pool, so once a game reached its steady state
+	* starting and finishing coroutines does not touch the heap.
+	*/
+	class Coroutine {
+	public:
+		struct promise_type
+		{
+			CoroutineScheduler* scheduler = nullptr;
+			CoroutineId id;
+
+			Coroutine get_return_object() {
+				return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+			void unhandled_exception();
+
+			static void* operator new(size_t size);
+			static void operator delete(void* ptr, size_t size);
+		};
+
+		using Handle = std::coroutine_handle<promise_type>;
+
+	public:
+		Coroutine() = default;
+		explicit Coroutine(Handle handle) : m_handle(handle) {}
+		~Coroutine();
+
+		Coroutine(Coroutine&& other) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+		Coroutine& operator=(Coroutine&& other) noexcept;
+
+		Coroutine(const Coroutine&) = delete;
+		Coroutine& operator=(const Coroutine&) = delete;
+
+		bool isValid() const { return (bool)m_handle; }
+
+	private:
+		Handle release();
+
+	private:
+		Handle m_handle;
+
+		friend class CoroutineScheduler;
+	};
+
+	/**
+	* \brief owns running coroutines and resumes them at fixed points of the frame:
+	* `resumeFixedStep` once per fixed step and `resumeFrame` once per frame, before the layers update.
+	*
+	* Suspended coroutines sit in min-heaps keyed by their wake-up frame/time/step, so a frame only
+	* costs what the coroutines that actually wake up do. Not thread-safe, except for the job
+	* completions which are queued from worker threads.
+	*/
+	class CoroutineScheduler {
+	public:
+		CoroutineScheduler();
+		~CoroutineScheduler();
+
+		CoroutineScheduler(const CoroutineScheduler&) = delete;
+		CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+		/**
+		* \brief runs the coroutine until its first suspension point
+		*/
+		CoroutineId start(Coroutine&& coroutine);
+
+		/**
+		* \brief destroys a suspended coroutine; a running one (cancelling itself, or further up the stack of
+		* the caller) is destroyed at its next suspension
+		*/
+		bool cancel(CoroutineId id);
+		void stopAll();
+
+		bool isRunning(CoroutineId id) const;
+		uint32_t getRunningCount() const { return m_runningCount; }
+
+		void resumeFrame(float dt);
+		void resumeFixedStep();
+
+		uint64_t getFrame() const { return m_frame; }
+		uint64_t getFixedStep() const { return m_fixedStep; }
+		double getTime() const { return m_time; }
+		float getDeltaTime() const { return m_deltaTime; }
+
+		/**
+		* \brief scheduling primitives used by the awaitables
+		*/
+		void waitFrame(CoroutineId id, uint64_t frame);
+		void waitTime(CoroutineId id, double time);
+		void waitFixedStep(CoroutineId id, uint64_t step);
+		// may be called from any thread
+		void wakeUp(CoroutineId id);
+
+	private:
+		struct Slot
+		{
+			Coroutine::Handle handle;
+			uint32_t generation = 1;
+			bool cancelled = false; // destroyed once it suspends
+			bool running = false;   // inside handle.resume(), possibly further down the stack
+		};
+
+		template <typename Key>
+		struct Wait
+		{
+			Key key;
+			CoroutineId id;
+
+			// std heap functions build max-heaps
+			bool operator<(const Wait& other) const { return key > other.key; }
+		};
+
+		template <typename Key>
+		void popDue(std::vector<Wait<Key>>& heap, Key now);
+
+		void resume(CoroutineId id);
+		void destroy(uint32_t index);
+		void resumeCollected();
+
+	private:
+		std::vector<Slot> m_slots;
+		std::vector<uint32_t> m_freeSlots;
+		uint32_t m_runningCount = 0;
+
+		std::vector<Wait<uint64_t>> m_frameWaits;
+		std::vector<Wait<double>> m_timeWaits;
+		std::vector<Wait<uint64_t>> m_fixedStepWaits;
+
+		std::mutex m_wokenMutex;
+		std::vector<CoroutineId> m_woken;
+		std::vector<CoroutineId> m_due;
+
+		uint64_t m_frame = 0;
+		uint64_t m_fixedStep = 0;
+		double m_time = 0.0;
+		float m_deltaTime = 0.f;
+	};
+
+	namespace detail {
+		template <typename Fn>
+		struct SchedulerAwaitable
+		{
+			Fn schedule;
+			CoroutineScheduler* scheduler = nullptr;
+
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(Coroutine::Handle handle) {
+				scheduler = handle.promise().scheduler;
+				schedule(*scheduler, handle.promise().id);
+			}
+
+			float await_resume() const noexcept { return scheduler->getDeltaTime(); }
+		};
+
+		template <typename Fn>
+		SchedulerAwaitable<Fn> makeAwaitable(Fn&& fn) {
+			return SchedulerAwaitable<Fn> { std::forward<Fn>(fn) };
+		}
+	}
+
+	/**
+	* \brief resumes on the next frame; `co_await` yields the delta time of that frame
+	*/
+	inline auto nextFrame() {
+		return detail::makeAwaitable([](CoroutineScheduler& scheduler, CoroutineId id) {
+			scheduler.waitFrame(id, scheduler.getFrame() + 1);
+		});
+	}
+
+	inline auto waitFrames(uint32_t frames) {
+		return detail::makeAwaitable([frames](CoroutineScheduler& scheduler, CoroutineId id) {
+			scheduler.waitFrame(id, scheduler.getFrame() + (frames ? frames : 1));
+		});
+	}
+
+	inline auto waitSeconds(float seconds) {
+		return detail::makeAwaitable([seconds](CoroutineScheduler& scheduler, CoroutineId id) {
+			scheduler.waitTime(id, scheduler.getTime() + seconds);
+		});
+	}
+
+	inline auto waitFixedSteps(uint32_t steps) {
+		return detail::makeAwaitable([steps](CoroutineScheduler& scheduler, CoroutineId id) {
+			scheduler.waitFixedStep(id, scheduler.getFixedStep() + (steps ? steps : 1));
+		});
+	}
+
+	/**
+	* \brief resumes at the start of the first frame after the job completed
+	*/
+	struct waitJob
+	{
+		JobHandle job;
+
+		bool await_ready() const noexcept { return job.isDone(); }
+
+		void await_suspend(Coroutine::Handle handle) {
+			CoroutineScheduler* scheduler = handle.promise().scheduler;
+			CoroutineId id = handle.promise().id;
+			job.then([scheduler, id]() { scheduler->wakeUp(id); });
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	/**
+	* \brief decodes the image on a worker thread, then uploads it on the main thread;
+	* `co_await` yields the texture handle, null when the image could not be loaded.
+	*/
+	struct loadTextureAsync
+	{
+		std::string path;
+
+		hyp::Ref<ImageData> image = hyp::CreateRef<ImageData>();
+
+		bool await_ready() const noexcept { return false; }
+
+		void await_suspend(Coroutine::Handle handle);
+
+		TextureHandle await_resume();
+	};
+}
+
+#endif // !HYPER_COROUTINE_HPP
@@ -17,11 +17,9 @@ void hyp::Device::init(const DeviceSetting& ds) {
 	}
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, ds.majorVersion);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, ds.majorVersion);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, ds.minorVersion);
 	glfwWindowHint(GLFW_SAMPLES, ds.samples);
-#ifdef HYPER_DEBUG
-	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);
-#endif // HYP_DEBUG
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, ds.debugContext);
 
 	HYP_INFO("OpenGL Version %.d.%.d", ds.majorVersion, ds.minorVersion);
 }
@@ -12,6 +12,13 @@ namespace hyp {
 		int8_t majorVersion = 3;
 		int8_t minorVersion = 3;
 		int8_t samples = 4;
+
+		// lets the driver report errors and performance warnings through OpenglDebugOutput
+	#ifdef HYPER_DEBUG
+		bool debugContext = true;
+	#else
+		bool debugContext = false;
+	#endif
 	};
 	class HYPER_API Device {
 	public:
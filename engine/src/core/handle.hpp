@@ -0,0 +1,162 @@
+#pragma once
+#ifndef HYPER_HANDLE_HPP
+	#define HYPER_HANDLE_HPP
+
+	#include <core/base.hpp>
+	#include <utils/assert.hpp>
+	#include <cstdint>
+	#include <deque>
+	#include <functional>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief 32-bit generational handle: the low 20 bits index a registry slot,
+	* the high 12 bits hold the slot's generation at the time the handle was issued.
+	* Generations start at 1, so a zero handle is never valid.
+	*/
+	template <typename T>
+	struct Handle
+	{
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t GenerationBits = 12;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
+		uint32_t value = 0;
+
+		Handle() = default;
+		Handle(uint32_t index, uint32_t generation)
+		    : value((generation << IndexBits) | (index & IndexMask)) {}
+
+		uint32_t getIndex() const { return value & IndexMask; }
+		uint32_t getGeneration() const { return value >> IndexBits; }
+
+		bool isNull() const { return value == 0; }
+		explicit operator bool() const { return value != 0; }
+
+		bool operator==(const Handle& other) const { return value == other.value; }
+		bool operator!=(const Handle& other) const { return value != other.value; }
+	};
+
+	/**
+	* \brief owns resources behind generational handles.
+	*
+	* `get` resolves a handle to a raw pointer without touching any reference count and
+	* returns nullptr for stale handles. Released resources are kept alive for
+	* `destructionDelay` frames, as the GPU may still be using them.
+	*/
+	template <typename T>
+	class ResourceRegistry {
+	public:
+		ResourceRegistry(uint32_t destructionDelay = 3) : m_destructionDelay(destructionDelay) {}
+
+		Handle<T> add(hyp::Ref<T> resource) {
+			if (!resource) return {};
+
+			uint32_t index;
+			if (!m_freeSlots.empty())
+			{
+				index = m_freeSlots.back();
+				m_freeSlots.pop_back();
+			}
+			else
+			{
+				HYP_ASSERT_CORE(m_slots.size() <= Handle<T>::IndexMask, "resource registry is full");
+				index = (uint32_t)m_slots.size();
+				m_slots.emplace_back();
+			}
+
+			Slot& slot = m_slots[index];
+			slot.resource = std::move(resource);
+			slot.raw = slot.resource.get();
+			m_liveCount++;
+
+			return Handle<T>(index, slot.generation);
+		}
+
+		T* get(Handle<T> handle) const {
+			uint32_t index = handle.getIndex();
+			if (index >= m_slots.size()) return nullptr;
+
+			const Slot& slot = m_slots[index];
+			return slot.generation == handle.getGeneration() ? slot.raw : nullptr;
+		}
+
+		hyp::Ref<T> getRef(Handle<T> handle) const {
+			return isValid(handle) ? m_slots[handle.getIndex()].resource : nullptr;
+		}
+
+		bool isValid(Handle<T> handle) const {
+			return get(handle) != nullptr;
+		}
+
+		/**
+		* \brief invalidates every outstanding copy of `handle` right away; the resource itself
+		* is destroyed by `collect` once the destruction delay has elapsed.
+		*/
+		void release(Handle<T> handle, uint64_t frame) {
+			if (!isValid(handle)) return;
+
+			uint32_t index = handle.getIndex();
+			Slot& slot = m_slots[index];
+			m_pending.push_back({ std::move(slot.resource), frame });
+			slot.raw = nullptr;
+			m_liveCount--;
+
+			// a saturated generation would alias old handles; retire the slot instead.
+			if (slot.generation < Handle<T>::MaxGeneration)
+			{
+				slot.generation++;
+				m_freeSlots.push_back(index);
+			}
+		}
+
+		void collect(uint64_t frame) {
+			while (!m_pending.empty() && frame - m_pending.front().frame >= m_destructionDelay)
+			{
+				m_pending.pop_front();
+			}
+		}
+
+		void clear() {
+			m_slots.clear();
+			m_freeSlots.clear();
+			m_pending.clear();
+			m_liveCount = 0;
+		}
+
+		uint32_t getLiveCount() const { return m_liveCount; }
+		size_t getPendingCount() const { return m_pending.size(); }
+
+		void forEach(const std::function<void(Handle<T>, T&)>& fn) const {
+			for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++)
+			{
+				if (m_slots[i].raw) fn(Handle<T>(i, m_slots[i].generation), *m_slots[i].raw);
+			}
+		}
+
+	private:
+		struct Slot
+		{
+			hyp::Ref<T> resource;
+			T* raw = nullptr;
+			uint32_t generation = 1;
+		};
+
+		struct PendingDestruction
+		{
+			hyp::Ref<T> resource;
+			uint64_t frame;
+		};
+
+		std::vector<Slot> m_slots;
+		std::vector<uint32_t> m_freeSlots;
+		std::deque<PendingDestruction> m_pending;
+		uint32_t m_destructionDelay;
+		uint32_t m_liveCount = 0;
+	};
+}
+
+#endif // !HYPER_HANDLE_HPP
@@ -0,0 +1,121 @@
+#include "idle_scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	double elapsedMs(Clock::time_point since) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+	}
+}
+
+hyp::IdleScheduler::TaskId hyp::IdleScheduler::post(const std::string& name, const IdleTaskFn& task, IdlePriority priority) {
+	TaskId id = m_nextId++;
+	m_queues[static_cast<size_t>(priority)].push_back({ id, name, task });
+	return id;
+}
+
+hyp::IdleScheduler::TaskId hyp::IdleScheduler::postOnce(const std::string& name, const std::function<void()>& task, IdlePriority priority) {
+	return post(
+	    name, [task]() {
+		    task();
+		    return true;
+	    },
+	    priority);
+}
+
+bool hyp::IdleScheduler::cancel(TaskId id) {
+	for (auto& queue : m_queues)
+	{
+		auto it = std::find_if(queue.begin(), queue.end(), [id](const Task& task) { return task.id == id; });
+		if (it != queue.end())
+		{
+			queue.erase(it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+double hyp::IdleScheduler::run(double budgetMs) {
+	auto start = Clock::now();
+	m_lastBudgetMs = budgetMs;
+
+	bool starved = budgetMs < m_minimumSliceMs;
+	if (starved && getPendingCount() && ++m_starvedFrames >= m_maxStarvedFrames)
+	{
+		// guarantee forward progress on frames that never have slack: exactly one slice of the
+		// first pending task, highest priority first, whatever the budget
+		for (auto& queue : m_queues)
+		{
+			if (queue.empty()) continue;
+
+			Task task = std::move(queue.front());
+			queue.pop_front();
+
+			if (!runSlice(task))
+			{
+				queue.push_back(std::move(task));
+			}
+			break;
+		}
+
+		m_starvedFrames = 0;
+		m_lastUsedMs = elapsedMs(start);
+		return m_lastUsedMs;
+	}
+
+	if (starved)
+	{
+		m_lastUsedMs = 0.0;
+		return 0.0;
+	}
+
+	for (auto& queue : m_queues)
+	{
+		// only the tasks queued at this point are run, so an unfinished task is resumed
+		// after its siblings instead of monopolizing the budget.
+		size_t count = queue.size();
+		while (count-- && budgetMs - elapsedMs(start) >= m_minimumSliceMs)
+		{
+			Task task = std::move(queue.front());
+			queue.pop_front();
+
+			if (!runSlice(task))
+			{
+				queue.push_back(std::move(task));
+			}
+
+			m_starvedFrames = 0;
+		}
+
+		if (budgetMs - elapsedMs(start) < m_minimumSliceMs) break;
+	}
+
+	m_lastUsedMs = elapsedMs(start);
+	return m_lastUsedMs;
+}
+
+size_t hyp::IdleScheduler::getPendingCount() const {
+	size_t count = 0;
+	for (const auto& queue : m_queues)
+		count += queue.size();
+	return count;
+}
+
+bool hyp::IdleScheduler::runSlice(Task& task) {
+	auto start = Clock::now();
+	bool finished = task.fn();
+	double ms = elapsedMs(start);
+
+	auto& stats = m_stats[task.name];
+	stats.slices++;
+	stats.totalMs += ms;
+	stats.lastMs = ms;
+	stats.maxMs = std::max(stats.maxMs, ms);
+	if (finished) stats.completed++;
+
+	return finished;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef HYPER_IDLE_SCHEDULER_HPP
+	#define HYPER_IDLE_SCHEDULER_HPP
+
+	#include <array>
+	#include <cstdint>
+	#include <deque>
+	#include <functional>
+	#include <string>
+	#include <unordered_map>
+	#include <vector>
+
+namespace hyp {
+
+	enum class IdlePriority : uint8_t
+	{
+		High = 0,
+		Normal,
+		Low,
+		Count
+	};
+
+	/**
+	* \brief an idle task runs one slice of work per call and returns true once it is finished;
+	* unfinished tasks are carried over to the next slice (or frame).
+	*/
+	using IdleTaskFn = std::function<bool()>;
+
+	struct IdleTaskStats
+	{
+		uint64_t slices = 0;
+		uint64_t completed = 0;
+		double totalMs = 0.0;
+		double lastMs = 0.0;
+		double maxMs = 0.0;
+	};
+
+	/**
+	* \brief runs deferred, low-priority engine work (uploads, cache cleanup, GC steps...)
+	* in the time left in the frame once update and render are done.
+	*/
+	class IdleScheduler {
+	public:
+		using TaskId = uint64_t;
+
+		TaskId post(const std::string& name, const IdleTaskFn& task, IdlePriority priority = IdlePriority::Normal);
+		TaskId postOnce(const std::string& name, const std::function<void()>& task, IdlePriority priority = IdlePriority::Normal);
+
+		bool cancel(TaskId id);
+
+		/**
+		* \brief runs queued tasks until `budgetMs` is spent; returns the time used in milliseconds
+		*/
+		double run(double budgetMs);
+
+		// slices are not started when less than this remains of the budget
+		void setMinimumSliceMs(double ms) { m_minimumSliceMs = ms; }
+
+		// after this many frames without any idle time, one slice runs regardless of the budget
+		void setMaxStarvedFrames(uint32_t frames) { m_maxStarvedFrames = frames; }
+
+		size_t getPendingCount() const;
+		double getLastBudgetMs() const { return m_lastBudgetMs; }
+		double getLastUsedMs() const { return m_lastUsedMs; }
+
+		const std::unordered_map<std::string, IdleTaskStats>& getStats() const { return m_stats; }
+
+	private:
+		struct Task
+		{
+			TaskId id;
+			std::string name;
+			IdleTaskFn fn;
+		};
+
+		bool runSlice(Task& task);
+
+	private:
+		std::array<std::deque<Task>, static_cast<size_t>(IdlePriority::Count)> m_queues;
+		std::unordered_map<std::string, IdleTaskStats> m_stats;
+
+		TaskId m_nextId = 1;
+		double m_minimumSliceMs = 0.25;
+		uint32_t m_maxStarvedFrames = 30;
+		uint32_t m_starvedFrames = 0;
+
+		double m_lastBudgetMs = 0.0;
+		double m_lastUsedMs = 0.0;
+	};
+}
+
+#endif // !HYPER_IDLE_SCHEDULER_HPP
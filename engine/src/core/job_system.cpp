@@ -0,0 +1,170 @@
+#include "job_system.hpp"
+#include <utils/logger.hpp>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace hyp {
+
+	namespace {
+		struct Job
+		{
+			JobFn fn;
+			JobHandle handle;
+		};
+
+		std::vector<std::thread> s_workers;
+		std::deque<Job> s_queue;
+		std::mutex s_queueMutex;
+		std::condition_variable s_queueCondition;
+		bool s_running = false;
+
+		thread_local bool t_isWorker = false;
+	}
+
+	void JobHandle::then(const JobFn& continuation) const {
+		if (!m_state)
+		{
+			continuation();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			if (!m_state->done.load(std::memory_order_acquire))
+			{
+				m_state->continuations.push_back(continuation);
+				return;
+			}
+		}
+
+		continuation();
+	}
+
+	void JobSystem::complete(const JobHandle& handle) {
+		std::vector<JobFn> continuations;
+		{
+			std::lock_guard<std::mutex> lock(handle.m_state->mutex);
+			handle.m_state->done.store(true, std::memory_order_release);
+			continuations.swap(handle.m_state->continuations);
+		}
+
+		for (auto& continuation : continuations)
+		{
+			continuation();
+		}
+	}
+
+	static void execute(Job& job) {
+		job.fn();
+		JobSystem::complete(job.handle);
+	}
+
+	static void workerLoop() {
+		t_isWorker = true;
+
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(s_queueMutex);
+				s_queueCondition.wait(lock, [] { return !s_running || !s_queue.empty(); });
+
+				if (!s_running && s_queue.empty()) return;
+
+				job = std::move(s_queue.front());
+				s_queue.pop_front();
+			}
+
+			execute(job);
+		}
+	}
+
+	void JobSystem::init(uint32_t workerCount) {
+		if (s_running) return;
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_running = true;
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			s_workers.emplace_back(workerLoop);
+		}
+
+		HYP_INFO("Job system started with %d workers", workerCount);
+	}
+
+	void JobSystem::deinit() {
+		{
+			std::lock_guard<std::mutex> lock(s_queueMutex);
+			if (!s_running) return;
+			s_running = false;
+		}
+
+		s_queueCondition.notify_all();
+		for (auto& worker : s_workers)
+		{
+			worker.join();
+		}
+		s_workers.clear();
+	}
+
+	JobHandle JobSystem::schedule(const JobFn& fn) {
+		JobHandle handle;
+		handle.m_state = CreateRef<JobHandle::State>();
+
+		Job job { fn, handle };
+
+		{
+			std::unique_lock<std::mutex> lock(s_queueMutex);
+			if (!s_running)
+			{
+				// no workers (yet): run inline so callers never wait forever
+				lock.unlock();
+				execute(job);
+				return handle;
+			}
+
+			s_queue.push_back(std::move(job));
+		}
+
+		s_queueCondition.notify_one();
+		return handle;
+	}
+
+	void JobSystem::wait(const JobHandle& handle) {
+		while (!handle.isDone())
+		{
+			if (!runOne())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool JobSystem::runOne() {
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(s_queueMutex);
+			if (s_queue.empty()) return false;
+
+			job = std::move(s_queue.front());
+			s_queue.pop_front();
+		}
+
+		execute(job);
+		return true;
+	}
+
+	uint32_t JobSystem::getWorkerCount() {
+		return (uint32_t)s_workers.size();
+	}
+
+	bool JobSystem::isWorkerThread() {
+		return t_isWorker;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef HYPER_JOB_SYSTEM_HPP
+	#define HYPER_JOB_SYSTEM_HPP
+
+	#include <core/base.hpp>
+	#include <atomic>
+	#include <cstdint>
+	#include <functional>
+	#include <mutex>
+	#include <vector>
+
+namespace hyp {
+
+	using JobFn = std::function<void()>;
+
+	/**
+	* \brief completion state shared between a job and everyone waiting on it
+	*/
+	class JobHandle {
+	public:
+		JobHandle() = default;
+
+		bool isValid() const { return m_state != nullptr; }
+		bool isDone() const { return !m_state || m_state->done.load(std::memory_order_acquire); }
+
+		/**
+		* \brief runs `continuation` once the job completed: immediately if it already did,
+		* otherwise on the worker thread that finishes it.
+		*/
+		void then(const JobFn& continuation) const;
+
+	private:
+		struct State
+		{
+			std::atomic<bool> done { false };
+			std::mutex mutex;
+			std::vector<JobFn> continuations;
+		};
+
+		hyp::Ref<State> m_state;
+
+		friend class JobSystem;
+	};
+
+	/**
+	* \brief fixed pool of worker threads executing fire-and-forget jobs
+	*/
+	class JobSystem {
+	public:
+		// 0 -> one worker per hardware thread, minus the main thread
+		static void init(uint32_t workerCount = 0);
+		static void deinit();
+
+		static JobHandle schedule(const JobFn& job);
+
+		/**
+		* \brief blocks until `handle` completed, executing queued jobs in the meantime
+		*/
+		static void wait(const JobHandle& handle);
+
+		/**
+		* \brief executes one queued job on the calling thread, false when the queue was empty
+		*/
+		static bool runOne();
+
+		static uint32_t getWorkerCount();
+		static bool isWorkerThread();
+
+		/**
+		* \brief marks `handle` done and runs its continuations on the calling thread
+		*/
+		static void complete(const JobHandle& handle);
+	};
+}
+
+#endif // !HYPER_JOB_SYSTEM_HPP
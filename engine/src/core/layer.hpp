@@ -12,6 +12,10 @@ namespace hyp {
 		virtual ~Layer() = default;
 		virtual void onEvent(hyp::Event& event) = 0;
 		virtual void onUpdate(float dt) {};
+		/**
+		* \brief called zero or more times per frame, every `dt` seconds of simulated time
+		*/
+		virtual void onFixedUpdate(float dt) {}
 
 		virtual void onAttach() {}
 		virtual void onDetach() {}
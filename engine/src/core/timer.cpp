@@ -33,6 +33,10 @@ namespace hyp {
 		return delta_time;
 	}
 
+	float Timer::getTargetFrameTimeMs() {
+		return 1000.f / m_fps;
+	}
+
 	void hyp::Timer::postTick() {
 		if (last_tick.time_since_epoch() == chrono::steady_clock::duration::zero())
 		{
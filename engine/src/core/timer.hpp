@@ -18,6 +18,11 @@ namespace hyp {
 		*/
 		static float getDeltaTimeMs();
 
+		/**
+		* \brief frame duration targeted by the frame limiter in milliseconds
+		*/
+		static float getTargetFrameTimeMs();
+
 	private:
 		static void postTick();
 		friend class Application;
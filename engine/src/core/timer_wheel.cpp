@@ -0,0 +1,206 @@
+#include "timer_wheel.hpp"
+#include <debug/metrics.hpp>
+#include <algorithm>
+#include <cmath>
+
+hyp::TimerWheel::TimerWheel() {
+	m_heads.fill(Null);
+}
+
+hyp::TimerId hyp::TimerWheel::schedule(uint64_t ticks, const TimerFn& callback, uint64_t interval) {
+	TimerId id = allocate(ticks, interval);
+	m_nodes[(uint32_t)id].callback = callback;
+	return id;
+}
+
+hyp::TimerId hyp::TimerWheel::scheduleEvent(uint64_t ticks, entt::entity entity, uint32_t tag, uint64_t interval) {
+	TimerId id = allocate(ticks, interval);
+	Node& node = m_nodes[(uint32_t)id];
+	node.entity = entity;
+	node.tag = tag;
+	return id;
+}
+
+hyp::TimerId hyp::TimerWheel::allocate(uint64_t ticks, uint64_t interval) {
+	uint32_t index = m_heads[FreeList];
+	if (index != Null)
+	{
+		unlink(index);
+	}
+	else
+	{
+		index = (uint32_t)m_nodes.size();
+		m_nodes.emplace_back();
+	}
+
+	Node& node = m_nodes[index];
+	node.expiry = m_tick + std::clamp<uint64_t>(ticks, 1, MaxDelay);
+	node.interval = std::min(interval, MaxDelay);
+	insert(index);
+	m_pendingCount++;
+
+	return ((TimerId)node.generation << 32) | index;
+}
+
+void hyp::TimerWheel::insert(uint32_t index) {
+	// the expiry may be the current tick when cascading, the level 0 slot about to fire then takes it
+	uint64_t delta = m_nodes[index].expiry - m_tick;
+
+	uint32_t level = 0;
+	while (level < Levels - 1 && delta >= (1ull << (SlotBits * (level + 1))))
+	{
+		level++;
+	}
+
+	uint32_t slot = (uint32_t)(m_nodes[index].expiry >> (SlotBits * level)) & (Slots - 1);
+	link(index, level * Slots + slot);
+}
+
+void hyp::TimerWheel::link(uint32_t index, uint32_t list) {
+	Node& node = m_nodes[index];
+	node.list = list;
+	node.prev = Null;
+	node.next = m_heads[list];
+	if (node.next != Null) m_nodes[node.next].prev = index;
+	m_heads[list] = index;
+}
+
+void hyp::TimerWheel::unlink(uint32_t index) {
+	Node& node = m_nodes[index];
+	if (node.prev != Null)
+		m_nodes[node.prev].next = node.next;
+	else
+		m_heads[node.list] = node.next;
+
+	if (node.next != Null) m_nodes[node.next].prev = node.prev;
+	node.prev = node.next = Null;
+}
+
+void hyp::TimerWheel::release(uint32_t index) {
+	unlink(index);
+
+	Node& node = m_nodes[index];
+	node.callback = nullptr;
+	node.entity = entt::null;
+	node.tag = 0;
+	// 0 is skipped so that a zero id is never valid
+	if (++node.generation == 0) node.generation = 1;
+
+	link(index, FreeList);
+	m_pendingCount--;
+}
+
+const hyp::TimerWheel::Node* hyp::TimerWheel::find(TimerId id) const {
+	uint32_t index = (uint32_t)id;
+	if (index >= m_nodes.size()) return nullptr;
+
+	const Node& node = m_nodes[index];
+	if (node.list == FreeList || node.generation != (uint32_t)(id >> 32)) return nullptr;
+	return &node;
+}
+
+bool hyp::TimerWheel::cancel(TimerId id) {
+	if (!find(id)) return false;
+
+	release((uint32_t)id);
+	return true;
+}
+
+bool hyp::TimerWheel::isPending(TimerId id) const {
+	return find(id) != nullptr;
+}
+
+uint64_t hyp::TimerWheel::getRemainingTicks(TimerId id) const {
+	const Node* node = find(id);
+	return node ? node->expiry - m_tick : 0;
+}
+
+uint64_t hyp::TimerWheel::toTicks(float seconds) const {
+	if (seconds <= 0.f) return 0;
+	return (uint64_t)std::llround(seconds / m_tickDuration);
+}
+
+void hyp::TimerWheel::cascade(uint32_t level) {
+	uint32_t list = level * Slots + ((uint32_t)(m_tick >> (SlotBits * level)) & (Slots - 1));
+
+	uint32_t index = m_heads[list];
+	m_heads[list] = Null;
+	while (index != Null)
+	{
+		uint32_t next = m_nodes[index].next;
+		insert(index);
+		index = next;
+	}
+}
+
+void hyp::TimerWheel::tick() {
+	m_events.clear();
+	m_tick++;
+
+	// highest wheel first, its timers may land in the slot of the wheel below that cascades next
+	for (uint32_t level = Levels - 1; level > 0; level--)
+	{
+		if ((m_tick & ((1ull << (SlotBits * level)) - 1)) == 0) cascade(level);
+	}
+
+	// the due slot becomes the firing list, callbacks cancelling a timer of it just unlink it from there
+	uint32_t slot = (uint32_t)m_tick & (Slots - 1);
+	m_heads[FiringList] = m_heads[slot];
+	m_heads[slot] = Null;
+	for (uint32_t index = m_heads[FiringList]; index != Null; index = m_nodes[index].next)
+	{
+		m_nodes[index].list = FiringList;
+	}
+
+	uint64_t fired = 0;
+	while (m_heads[FiringList] != Null)
+	{
+		uint32_t index = m_heads[FiringList];
+		Node& node = m_nodes[index];
+		TimerId id = ((TimerId)node.generation << 32) | index;
+		fired++;
+
+		if (!node.callback)
+		{
+			m_events.push_back({ id, node.entity, node.tag });
+			if (node.interval)
+			{
+				unlink(index);
+				node.expiry = m_tick + node.interval;
+				insert(index);
+			}
+			else
+			{
+				release(index);
+			}
+			continue;
+		}
+
+		// the callback may schedule timers and reallocate the pool, it can't run from the node
+		TimerFn callback;
+		if (node.interval)
+		{
+			callback = node.callback;
+			unlink(index);
+			node.expiry = m_tick + node.interval;
+			insert(index);
+		}
+		else
+		{
+			callback = std::move(node.callback);
+			release(index);
+		}
+
+		callback(id);
+	}
+
+	static hyp::Counter& s_fired = hyp::Metrics::counter("timers.fired");
+	if (fired) s_fired.add(fired);
+}
+
+void hyp::TimerWheel::clear() {
+	for (uint32_t index = 0; index < m_nodes.size(); index++)
+	{
+		if (m_nodes[index].list != FreeList) release(index);
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef HYPER_TIMER_WHEEL_HPP
+	#define HYPER_TIMER_WHEEL_HPP
+
+	#include <entt.hpp>
+	#include <array>
+	#include <cstdint>
+	#include <functional>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief 64-bit generational id: the low 32 bits index the timer pool, the high 32 bits hold
+	* the slot's generation. Ids of fired or cancelled timers never match a new timer.
+	*/
+	using TimerId = uint64_t;
+
+	using TimerFn = std::function<void(TimerId)>;
+
+	/**
+	* \brief delivered by timers scheduled for an entity, see TimerWheel::scheduleEvent
+	*/
+	struct TimerEvent
+	{
+		TimerId id;
+		entt::entity entity;
+		uint32_t tag;
+	};
+
+	/**
+	* \brief schedules gameplay timers on a hierarchical timing wheel driven by ticks.
+	*
+	* Four wheels of 256 slots cover 2^32 ticks; a timer sits in the wheel matching how far away it is
+	* and moves down (at most three times) when the lower wheel wraps. Scheduling and cancelling are O(1),
+	* and a tick only costs the timers that fire or cascade in it, however many are pending.
+	*
+	* The Application ticks its wheel once per fixed step, before the layers' onFixedUpdate. Timers fire
+	* either a callback or a TimerEvent, collected in `getEvents` until the next tick, so systems can
+	* react to them in bulk (the entity may have been destroyed meanwhile).
+	*/
+	class TimerWheel {
+	public:
+		static constexpr uint32_t SlotBits = 8;
+		static constexpr uint32_t Slots = 1u << SlotBits;
+		static constexpr uint32_t Levels = 4;
+		static constexpr uint64_t MaxDelay = (1ull << (SlotBits * Levels)) - 1; // ticks
+
+		TimerWheel();
+
+		/**
+		* \brief fires `callback` in `ticks` ticks (at least one), then every `interval` ticks if non zero.
+		* Callbacks may schedule and cancel timers, including their own.
+		*/
+		TimerId schedule(uint64_t ticks, const TimerFn& callback, uint64_t interval = 0);
+		TimerId scheduleEvent(uint64_t ticks, entt::entity entity, uint32_t tag = 0, uint64_t interval = 0);
+
+		bool cancel(TimerId id);
+		bool isPending(TimerId id) const;
+		uint64_t getRemainingTicks(TimerId id) const;
+
+		/**
+		* \brief advances the wheel by one tick and fires the timers due
+		*/
+		void tick();
+
+		/**
+		* \brief cancels every pending timer, the tick count is kept
+		*/
+		void clear();
+
+		// used by `toTicks`, the Application sets it to its fixed time step
+		void setTickDuration(float seconds) { m_tickDuration = seconds; }
+		float getTickDuration() const { return m_tickDuration; }
+		uint64_t toTicks(float seconds) const;
+
+		uint64_t getTick() const { return m_tick; }
+		size_t getPendingCount() const { return m_pendingCount; }
+		const std::vector<TimerEvent>& getEvents() const { return m_events; }
+
+	private:
+		static constexpr uint32_t Null = UINT32_MAX;
+		// list heads after the wheel slots: the timers being fired, and the free nodes
+		static constexpr uint32_t FiringList = Levels * Slots;
+		static constexpr uint32_t FreeList = FiringList + 1;
+
+		struct Node
+		{
+			uint64_t expiry = 0;
+			uint64_t interval = 0;
+			uint32_t prev = Null;
+			uint32_t next = Null;
+			uint32_t list = FreeList;
+			uint32_t generation = 1;
+
+			TimerFn callback; // empty for events
+			entt::entity entity = entt::null;
+			uint32_t tag = 0;
+		};
+
+		TimerId allocate(uint64_t ticks, uint64_t interval);
+		void insert(uint32_t index);
+		void link(uint32_t index, uint32_t list);
+		void unlink(uint32_t index);
+		void release(uint32_t index);
+		void cascade(uint32_t level);
+		const Node* find(TimerId id) const;
+
+	private:
+		std::vector<Node> m_nodes;
+		std::array<uint32_t, Levels * Slots + 2> m_heads;
+
+		uint64_t m_tick = 0;
+		size_t m_pendingCount = 0;
+		float m_tickDuration = 1.f / 60.f;
+
+		std::vector<TimerEvent> m_events;
+	};
+}
+
+#endif // !HYPER_TIMER_WHEEL_HPP
@@ -0,0 +1,377 @@
+#include "flight_recorder.hpp"
+#include <core/job_system.hpp>
+#include <debug/metrics.hpp>
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace hyp {
+
+	namespace {
+		enum class EventType : uint8_t
+		{
+			Scope,
+			Counter,
+			Frame,
+		};
+
+		struct Event
+		{
+			const char* name;
+			uint64_t start;
+			uint64_t duration;
+			double value;
+			uint32_t thread;
+			EventType type;
+		};
+
+		enum class MessageType : uint8_t
+		{
+			Log,
+			AssetLoad,
+		};
+
+		struct Message
+		{
+			uint64_t start;
+			uint64_t duration;
+			uint32_t thread;
+			int level;
+			MessageType type;
+			char text[192];
+		};
+
+		// ~2.5MB of events: a few seconds of a busy frame at 60 fps
+		constexpr size_t EventCapacity = 1 << 16;
+		constexpr size_t MessageCapacity = 1024;
+
+		template <typename T, size_t Capacity>
+		struct Ring
+		{
+			std::vector<T> items = std::vector<T>(Capacity);
+			uint64_t written = 0;
+
+			T& push() { return items[written++ % Capacity]; }
+
+			template <typename Fn>
+			void forEach(Fn fn) const {
+				uint64_t count = std::min<uint64_t>(written, Capacity);
+				for (uint64_t i = written - count; i < written; i++)
+				{
+					fn(items[i % Capacity]);
+				}
+			}
+		};
+
+		const auto s_epoch = std::chrono::steady_clock::now();
+
+		std::mutex s_mutex;
+		Ring<Event, EventCapacity> s_events;
+		Ring<Message, MessageCapacity> s_messages;
+
+		float s_frameBudgetMs = 50.f;
+		float s_windowSeconds = 5.f;
+		float s_dumpCooldownSeconds = 10.f;
+		bool s_autoDump = true;
+		bool s_startupTrace = true;
+		uint64_t s_timeToFirstFrame = 0;
+		std::filesystem::path s_dumpDirectory = "hitches";
+
+		uint64_t s_frameIndex = 0;
+		uint64_t s_frameStart = 0;
+		uint64_t s_lastDump = 0;
+		bool s_hasDumped = false;
+		std::atomic<uint64_t> s_hitchCount { 0 };
+
+		std::atomic<uint32_t> s_nextThread { 0 };
+		thread_local uint32_t t_thread = s_nextThread++;
+
+		const char* s_logLevels[] = { "fatal", "error", "warn", "info", "debug", "trace" };
+
+		struct Snapshot
+		{
+			std::vector<Event> events;
+			std::vector<Message> messages;
+			uint64_t frameIndex = 0;
+			uint64_t frameDuration = 0;
+			float budgetMs = 0.f;
+		};
+
+		void writeEscaped(std::ostream& out, const char* text) {
+			for (const char* c = text; *c; c++)
+			{
+				switch (*c)
+				{
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				case '\r': break;
+				case '\t': out << "\\t"; break;
+				default:
+					if ((unsigned char)*c >= 0x20) out << *c;
+					break;
+				}
+			}
+		}
+
+		Snapshot takeSnapshot(float seconds) {
+			Snapshot snapshot;
+			uint64_t from = 0;
+			uint64_t now = FlightRecorder::now();
+			uint64_t window = (uint64_t)((seconds > 0.f ? seconds : s_windowSeconds) * 1e6f);
+			if (now > window) from = now - window;
+
+			std::lock_guard<std::mutex> lock(s_mutex);
+			snapshot.events.reserve(std::min<uint64_t>(s_events.written, EventCapacity));
+			s_events.forEach([&](const Event& event) {
+				if (event.start >= from) snapshot.events.push_back(event);
+			});
+			s_messages.forEach([&](const Message& message) {
+				if (message.start >= from) snapshot.messages.push_back(message);
+			});
+
+			snapshot.frameIndex = s_frameIndex;
+			snapshot.budgetMs = s_frameBudgetMs;
+			return snapshot;
+		}
+
+		bool writeTrace(const std::filesystem::path& path, const Snapshot& snapshot) {
+			std::ofstream file(path, std::ios::out | std::ios::trunc);
+			if (!file.is_open())
+			{
+				HYP_ERROR("Failed to write flight recorder trace to %s", path.string().c_str());
+				return false;
+			}
+
+			file << "{\"displayTimeUnit\":\"ms\",\"otherData\":{"
+			     << "\"frame\":" << snapshot.frameIndex << ","
+			     << "\"frameMs\":" << snapshot.frameDuration / 1000.0 << ","
+			     << "\"budgetMs\":" << snapshot.budgetMs << "},\n";
+			file << "\"traceEvents\":[\n";
+
+			bool first = true;
+			auto separator = [&]() {
+				if (!first) file << ",\n";
+				first = false;
+			};
+
+			for (const auto& event : snapshot.events)
+			{
+				separator();
+				switch (event.type)
+				{
+				case EventType::Scope:
+					file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+					     << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+					break;
+				case EventType::Frame:
+					file << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+					     << ",\"ts\":" << event.start << ",\"dur\":" << event.duration
+					     << ",\"args\":{\"index\":" << (uint64_t)event.value << "}}";
+					break;
+				case EventType::Counter:
+					file << "{\"name\":\"" << event.name << "\",\"ph\":\"C\",\"pid\":0,\"ts\":" << event.start
+					     << ",\"args\":{\"value\":" << event.value << "}}";
+					break;
+				}
+			}
+
+			for (const auto& message : snapshot.messages)
+			{
+				separator();
+				if (message.type == MessageType::Log)
+				{
+					file << "{\"name\":\"";
+					writeEscaped(file, message.text);
+					file << "\",\"cat\":\"log\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << message.thread
+					     << ",\"ts\":" << message.start << ",\"args\":{\"level\":\"" << s_logLevels[message.level] << "\"}}";
+				}
+				else
+				{
+					file << "{\"name\":\"load ";
+					writeEscaped(file, message.text);
+					file << "\",\"cat\":\"asset\",\"ph\":\"X\",\"pid\":0,\"tid\":" << message.thread
+					     << ",\"ts\":" << message.start << ",\"dur\":" << message.duration << "}";
+				}
+			}
+
+			file << "\n]}\n";
+			return true;
+		}
+
+		void pushMessage(MessageType type, int level, const char* text, uint64_t start, uint64_t duration) {
+			std::lock_guard<std::mutex> lock(s_mutex);
+			Message& message = s_messages.push();
+			message.start = start;
+			message.duration = duration;
+			message.thread = t_thread;
+			message.level = level;
+			message.type = type;
+
+			// keep the tail of long paths, it's the part that tells them apart
+			size_t length = std::strlen(text);
+			const char* begin = (type == MessageType::AssetLoad && length >= sizeof(message.text))
+			    ? text + length - (sizeof(message.text) - 1)
+			    : text;
+			std::strncpy(message.text, begin, sizeof(message.text) - 1);
+			message.text[sizeof(message.text) - 1] = '\0';
+		}
+	}
+
+	void recordLogLine(hyp::LOG_TYPE type, const char* line) {
+		FlightRecorder::recordLog((int)type, line);
+	}
+
+	void FlightRecorder::setFrameBudget(float ms) {
+		s_frameBudgetMs = ms;
+	}
+
+	float FlightRecorder::getFrameBudget() {
+		return s_frameBudgetMs;
+	}
+
+	void FlightRecorder::setWindow(float seconds) {
+		s_windowSeconds = seconds;
+	}
+
+	void FlightRecorder::setDumpDirectory(const std::filesystem::path& directory) {
+		s_dumpDirectory = directory;
+	}
+
+	const std::filesystem::path& FlightRecorder::getDumpDirectory() {
+		return s_dumpDirectory;
+	}
+
+	void FlightRecorder::setAutoDump(bool value) {
+		s_autoDump = value;
+	}
+
+	void FlightRecorder::setDumpCooldown(float seconds) {
+		s_dumpCooldownSeconds = seconds;
+	}
+
+	void FlightRecorder::setStartupTrace(bool value) {
+		s_startupTrace = value;
+	}
+
+	uint64_t FlightRecorder::getTimeToFirstFrame() {
+		return s_timeToFirstFrame;
+	}
+
+	void FlightRecorder::beginFrame() {
+		s_frameStart = now();
+	}
+
+	void FlightRecorder::endFrame() {
+		uint64_t end = now();
+		uint64_t duration = end - s_frameStart;
+
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			Event& event = s_events.push();
+			event = { "Frame", s_frameStart, duration, (double)s_frameIndex, t_thread, EventType::Frame };
+		}
+
+		s_frameIndex++;
+
+		// the first frame pays for shader warm-up and uploads, report it as startup instead
+		if (s_frameIndex == 1)
+		{
+			s_timeToFirstFrame = end;
+			HYP_INFO("Time to first frame: %.2fms", end / 1000.0);
+			if (!s_startupTrace) return;
+
+			auto snapshot = hyp::CreateRef<Snapshot>(takeSnapshot(end / 1e6f + 1.f));
+			snapshot->frameIndex = 0;
+			snapshot->frameDuration = duration;
+
+			std::filesystem::path path = s_dumpDirectory / "startup.json";
+			JobSystem::schedule([snapshot, path]() {
+				std::error_code error;
+				std::filesystem::create_directories(path.parent_path(), error);
+				writeTrace(path, *snapshot);
+			});
+			return;
+		}
+
+		if (duration <= (uint64_t)(s_frameBudgetMs * 1000.f)) return;
+
+		s_hitchCount++;
+		if (!s_autoDump) return;
+		if (s_hasDumped && end - s_lastDump < (uint64_t)(s_dumpCooldownSeconds * 1e6f)) return;
+
+		s_hasDumped = true;
+		s_lastDump = end;
+
+		auto snapshot = hyp::CreateRef<Snapshot>(takeSnapshot(0.f));
+		snapshot->frameIndex = s_frameIndex - 1;
+		snapshot->frameDuration = duration;
+
+		std::filesystem::path path = s_dumpDirectory / ("hitch_frame_" + std::to_string(snapshot->frameIndex) + ".json");
+		HYP_WARN("Frame %llu took %.2fms (budget %.2fms), dumping trace to %s",
+		    (unsigned long long)snapshot->frameIndex, duration / 1000.0, s_frameBudgetMs, path.string().c_str());
+
+		// writing the file would stretch the next frame as well
+		JobSystem::schedule([snapshot, path]() {
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+			writeTrace(path, *snapshot);
+		});
+	}
+
+	void FlightRecorder::recordScope(const char* name, uint64_t startUs, uint64_t durationUs) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_events.push() = { name, startUs, durationUs, 0.0, t_thread, EventType::Scope };
+	}
+
+	void FlightRecorder::recordCounter(const char* name, double value) {
+		uint64_t time = now();
+
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_events.push() = { name, time, 0, value, t_thread, EventType::Counter };
+	}
+
+	void FlightRecorder::recordLog(int level, const char* line) {
+		pushMessage(MessageType::Log, std::clamp(level, 0, 5), line, now(), 0);
+	}
+
+	void FlightRecorder::recordAssetLoad(const std::string& path, uint64_t startUs, uint64_t durationUs) {
+		pushMessage(MessageType::AssetLoad, 0, path.c_str(), startUs, durationUs);
+
+		static hyp::Counter& s_loads = hyp::Metrics::counter("assets.loads");
+		static hyp::Histogram& s_loadTime = hyp::Metrics::histogram("assets.load_time_us");
+		s_loads.add();
+		s_loadTime.record(durationUs);
+	}
+
+	bool FlightRecorder::dump(const std::filesystem::path& path, float seconds) {
+		Snapshot snapshot = takeSnapshot(seconds);
+
+		if (path.has_parent_path())
+		{
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+		}
+
+		return writeTrace(path, snapshot);
+	}
+
+	uint64_t FlightRecorder::now() {
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+	}
+
+	uint64_t FlightRecorder::getFrameIndex() {
+		return s_frameIndex;
+	}
+
+	uint64_t FlightRecorder::getHitchCount() {
+		return s_hitchCount;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+#ifndef HYP_FLIGHT_RECORDER_HPP
+	#define HYP_FLIGHT_RECORDER_HPP
+
+	#include <cstdint>
+	#include <filesystem>
+	#include <string>
+
+namespace hyp {
+
+	/**
+	* \brief always-on recorder of the last few seconds of frame timings, counters, log lines
+	* and asset loads, kept in fixed-size rings.
+	*
+	* Whenever a frame exceeds the budget, the recorded window is written to a Chrome trace
+	* (chrome://tracing, ui.perfetto.dev) in the dump directory, off the main thread.
+	*/
+	class FlightRecorder {
+	public:
+		static void setFrameBudget(float ms);
+		static float getFrameBudget();
+
+		// how much history (seconds) goes into a dump
+		static void setWindow(float seconds);
+		static void setDumpDirectory(const std::filesystem::path& directory);
+		static const std::filesystem::path& getDumpDirectory();
+		static void setAutoDump(bool value);
+
+		// minimum time between two automatic dumps, a dump is a hitch of its own
+		static void setDumpCooldown(float seconds);
+
+		/**
+		* \brief when on (default), everything recorded from process start to the end of the first
+		* frame is written to startup.json in the dump directory. The first frame never counts as a hitch.
+		*/
+		static void setStartupTrace(bool value);
+		static uint64_t getTimeToFirstFrame();
+
+		/**
+		* \brief frame boundaries, called by the Application
+		*/
+		static void beginFrame();
+		static void endFrame();
+
+		static void recordScope(const char* name, uint64_t startUs, uint64_t durationUs);
+		static void recordCounter(const char* name, double value);
+		static void recordLog(int level, const char* line);
+		static void recordAssetLoad(const std::string& path, uint64_t startUs, uint64_t durationUs);
+
+		/**
+		* \brief writes the last `seconds` of history to `path` (the full window when <= 0)
+		*/
+		static bool dump(const std::filesystem::path& path, float seconds = 0.f);
+
+		// microseconds since the recorder started
+		static uint64_t now();
+
+		static uint64_t getFrameIndex();
+		static uint64_t getHitchCount();
+	};
+
+	/**
+	* \brief times the enclosing scope; `name` must outlive the recorder (string literal)
+	*/
+	class ProfileScope {
+	public:
+		ProfileScope(const char* name) : m_name(name), m_start(FlightRecorder::now()) {}
+		~ProfileScope() { FlightRecorder::recordScope(m_name, m_start, FlightRecorder::now() - m_start); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_name;
+		uint64_t m_start;
+	};
+
+	class AssetLoadScope {
+	public:
+		AssetLoadScope(const std::string& path) : m_path(path), m_start(FlightRecorder::now()) {}
+		~AssetLoadScope() { FlightRecorder::recordAssetLoad(m_path, m_start, FlightRecorder::now() - m_start); }
+
+		AssetLoadScope(const AssetLoadScope&) = delete;
+		AssetLoadScope& operator=(const AssetLoadScope&) = delete;
+
+	private:
+		std::string m_path;
+		uint64_t m_start;
+	};
+}
+
+	#define HYP_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define HYP_PROFILE_CONCAT(a, b) HYP_PROFILE_CONCAT_IMPL(a, b)
+	#define HYP_PROFILE_SCOPE(name) hyp::ProfileScope HYP_PROFILE_CONCAT(hypProfileScope, __LINE__)(name)
+	#define HYP_PROFILE_ASSET(path) hyp::AssetLoadScope HYP_PROFILE_CONCAT(hypAssetScope, __LINE__)(path)
+
+#endif // !HYP_FLIGHT_RECORDER_HPP
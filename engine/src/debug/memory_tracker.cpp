@@ -0,0 +1,370 @@
+#include "memory_tracker.hpp"
+#include <utils/logger.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace hyp {
+
+	namespace {
+
+		struct TagCounters
+		{
+			std::atomic<int64_t> currentBytes { 0 };
+			std::atomic<int64_t> peakBytes { 0 };
+			std::atomic<uint64_t> allocations { 0 };
+			std::atomic<uint64_t> frees { 0 };
+
+			std::atomic<uint64_t> frameAllocations { 0 };
+			std::atomic<uint64_t> frameBytes { 0 };
+			uint64_t lastFrameAllocations = 0;
+			uint64_t lastFrameBytes = 0;
+
+			std::atomic<uint64_t> budgetBytes { 0 };
+			std::atomic<bool> budgetWarned { false };
+		};
+
+		struct GpuCounters
+		{
+			std::atomic<int64_t> currentBytes { 0 };
+			std::atomic<int64_t> peakBytes { 0 };
+			std::atomic<int64_t> liveCount { 0 };
+			std::atomic<uint64_t> created { 0 };
+		};
+
+		std::atomic<bool> s_enabled { false };
+		std::atomic<uint64_t> s_frameIndex { 0 };
+
+		TagCounters s_tags[MemoryTagCount];
+		GpuCounters s_gpu[GpuResourceTypeCount];
+		std::atomic<int64_t> s_gpuBytes { 0 };
+		std::atomic<uint64_t> s_gpuBudget { 0 };
+		std::atomic<bool> s_gpuBudgetWarned { false };
+
+		thread_local MemoryTag t_currentTag = MemoryTag::Unknown;
+
+		// prefixes tracked blocks: frees go to the allocating tag, and only blocks counted when
+		// allocated are uncounted, so toggling tracking can't unbalance the totals
+		struct alignas(alignof(std::max_align_t)) AllocationHeader
+		{
+			size_t size;
+			MemoryTag tag;
+			bool tracked;
+		};
+
+		void updatePeak(std::atomic<int64_t>& peak, int64_t value) {
+			int64_t previous = peak.load(std::memory_order_relaxed);
+			while (value > previous && !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		const char* s_tagNames[] = { "unknown", "renderer", "scene", "assets", "scripting", "ui" };
+		const char* s_gpuNames[] = { "texture", "vertex_buffer", "element_buffer", "uniform_buffer", "framebuffer" };
+
+		static_assert(sizeof(s_tagNames) / sizeof(s_tagNames[0]) == MemoryTagCount, "missing memory tag name");
+		static_assert(sizeof(s_gpuNames) / sizeof(s_gpuNames[0]) == GpuResourceTypeCount, "missing gpu resource name");
+	}
+
+	int64_t MemoryStats::getCpuBytes() const {
+		int64_t total = 0;
+		for (const auto& tag : tags)
+			total += tag.currentBytes;
+		return total;
+	}
+
+	int64_t MemoryStats::getGpuBytes() const {
+		int64_t total = 0;
+		for (const auto& resource : gpu)
+			total += resource.currentBytes;
+		return total;
+	}
+
+	void MemoryTracker::enable(bool value) {
+		s_enabled.store(value, std::memory_order_relaxed);
+	}
+
+	bool MemoryTracker::isEnabled() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::newFrame() {
+		for (auto& tag : s_tags)
+		{
+			tag.lastFrameAllocations = tag.frameAllocations.exchange(0, std::memory_order_relaxed);
+			tag.lastFrameBytes = tag.frameBytes.exchange(0, std::memory_order_relaxed);
+		}
+
+		s_frameIndex.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::onAllocate(MemoryTag tag, size_t size) {
+		auto& counters = s_tags[static_cast<size_t>(tag)];
+		int64_t current = counters.currentBytes.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+		updatePeak(counters.peakBytes, current);
+
+		counters.allocations.fetch_add(1, std::memory_order_relaxed);
+		counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+		uint64_t budget = counters.budgetBytes.load(std::memory_order_relaxed);
+		if (budget && current > (int64_t)budget && !counters.budgetWarned.exchange(true))
+		{
+			HYP_WARN("memory budget of '%s' exceeded: %lld / %llu bytes", getTagName(tag), (long long)current, (unsigned long long)budget);
+		}
+	}
+
+	void MemoryTracker::onFree(MemoryTag tag, size_t size) {
+		auto& counters = s_tags[static_cast<size_t>(tag)];
+		counters.currentBytes.fetch_sub((int64_t)size, std::memory_order_relaxed);
+		counters.frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::onGpuAllocate(GpuResourceType type, size_t size) {
+		auto& counters = s_gpu[static_cast<size_t>(type)];
+		int64_t current = counters.currentBytes.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+		updatePeak(counters.peakBytes, current);
+
+		counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+		counters.created.fetch_add(1, std::memory_order_relaxed);
+
+		int64_t total = s_gpuBytes.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+		uint64_t budget = s_gpuBudget.load(std::memory_order_relaxed);
+		if (budget && total > (int64_t)budget && !s_gpuBudgetWarned.exchange(true))
+		{
+			HYP_WARN("GPU memory budget exceeded: %lld / %llu bytes", (long long)total, (unsigned long long)budget);
+		}
+	}
+
+	void MemoryTracker::onGpuFree(GpuResourceType type, size_t size) {
+		auto& counters = s_gpu[static_cast<size_t>(type)];
+		counters.currentBytes.fetch_sub((int64_t)size, std::memory_order_relaxed);
+		counters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+		s_gpuBytes.fetch_sub((int64_t)size, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::setBudget(MemoryTag tag, uint64_t bytes) {
+		auto& counters = s_tags[static_cast<size_t>(tag)];
+		counters.budgetBytes.store(bytes, std::memory_order_relaxed);
+		counters.budgetWarned.store(false);
+	}
+
+	void MemoryTracker::setGpuBudget(uint64_t bytes) {
+		s_gpuBudget.store(bytes, std::memory_order_relaxed);
+		s_gpuBudgetWarned.store(false);
+	}
+
+	bool MemoryTracker::isOverBudget(MemoryTag tag) {
+		const auto& counters = s_tags[static_cast<size_t>(tag)];
+		uint64_t budget = counters.budgetBytes.load(std::memory_order_relaxed);
+		return budget && counters.currentBytes.load(std::memory_order_relaxed) > (int64_t)budget;
+	}
+
+	bool MemoryTracker::isGpuOverBudget() {
+		uint64_t budget = s_gpuBudget.load(std::memory_order_relaxed);
+		return budget && s_gpuBytes.load(std::memory_order_relaxed) > (int64_t)budget;
+	}
+
+	MemoryStats MemoryTracker::getStats() {
+		MemoryStats stats;
+		stats.frameIndex = s_frameIndex.load(std::memory_order_relaxed);
+
+		for (size_t i = 0; i < MemoryTagCount; i++)
+		{
+			const auto& counters = s_tags[i];
+			auto& tag = stats.tags[i];
+			tag.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+			tag.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			tag.allocations = counters.allocations.load(std::memory_order_relaxed);
+			tag.frees = counters.frees.load(std::memory_order_relaxed);
+			tag.frameAllocations = counters.lastFrameAllocations;
+			tag.frameBytes = counters.lastFrameBytes;
+			tag.budgetBytes = counters.budgetBytes.load(std::memory_order_relaxed);
+
+			stats.frameAllocations += tag.frameAllocations;
+			stats.frameBytes += tag.frameBytes;
+		}
+
+		for (size_t i = 0; i < GpuResourceTypeCount; i++)
+		{
+			const auto& counters = s_gpu[i];
+			auto& resource = stats.gpu[i];
+			resource.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+			resource.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			resource.liveCount = counters.liveCount.load(std::memory_order_relaxed);
+			resource.created = counters.created.load(std::memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
+	std::string MemoryTracker::toJson() {
+		MemoryStats stats = getStats();
+		std::stringstream ss;
+
+		ss << "{\n";
+		ss << "  \"enabled\": " << (isEnabled() ? "true" : "false") << ",\n";
+		ss << "  \"frame\": " << stats.frameIndex << ",\n";
+		ss << "  \"frameAllocations\": " << stats.frameAllocations << ",\n";
+		ss << "  \"frameBytes\": " << stats.frameBytes << ",\n";
+
+		ss << "  \"cpu\": {\n";
+		ss << "    \"totalBytes\": " << stats.getCpuBytes() << ",\n";
+		ss << "    \"tags\": {\n";
+		for (size_t i = 0; i < MemoryTagCount; i++)
+		{
+			const auto& tag = stats.tags[i];
+			ss << "      \"" << s_tagNames[i] << "\": { "
+			   << "\"currentBytes\": " << tag.currentBytes << ", "
+			   << "\"peakBytes\": " << tag.peakBytes << ", "
+			   << "\"allocations\": " << tag.allocations << ", "
+			   << "\"frees\": " << tag.frees << ", "
+			   << "\"frameAllocations\": " << tag.frameAllocations << ", "
+			   << "\"frameBytes\": " << tag.frameBytes << ", "
+			   << "\"budgetBytes\": " << tag.budgetBytes << " }"
+			   << (i + 1 < MemoryTagCount ? ",\n" : "\n");
+		}
+		ss << "    }\n";
+		ss << "  },\n";
+
+		ss << "  \"gpu\": {\n";
+		ss << "    \"totalBytes\": " << stats.getGpuBytes() << ",\n";
+		ss << "    \"budgetBytes\": " << s_gpuBudget.load(std::memory_order_relaxed) << ",\n";
+		ss << "    \"resources\": {\n";
+		for (size_t i = 0; i < GpuResourceTypeCount; i++)
+		{
+			const auto& resource = stats.gpu[i];
+			ss << "      \"" << s_gpuNames[i] << "\": { "
+			   << "\"currentBytes\": " << resource.currentBytes << ", "
+			   << "\"peakBytes\": " << resource.peakBytes << ", "
+			   << "\"liveCount\": " << resource.liveCount << ", "
+			   << "\"created\": " << resource.created << " }"
+			   << (i + 1 < GpuResourceTypeCount ? ",\n" : "\n");
+		}
+		ss << "    }\n";
+		ss << "  }\n";
+		ss << "}\n";
+
+		return ss.str();
+	}
+
+	bool MemoryTracker::dumpJson(const std::filesystem::path& path) {
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			HYP_ERROR("Failed to write memory report to %s", path.string().c_str());
+			return false;
+		}
+
+		file << toJson();
+		return true;
+	}
+
+	const char* MemoryTracker::getTagName(MemoryTag tag) {
+		return s_tagNames[static_cast<size_t>(tag)];
+	}
+
+	const char* MemoryTracker::getGpuResourceName(GpuResourceType type) {
+		return s_gpuNames[static_cast<size_t>(type)];
+	}
+
+	MemoryTag MemoryTracker::getCurrentTag() {
+		return t_currentTag;
+	}
+
+	void MemoryTracker::setCurrentTag(MemoryTag tag) {
+		t_currentTag = tag;
+	}
+
+#if defined(HYPER_TRACK_ALLOCATIONS)
+
+	void* MemoryTracker::allocate(MemoryTag tag, size_t size) {
+		// the global operator new does the accounting, it only needs the right tag
+		MemoryScope scope(tag);
+		return ::operator new(size);
+	}
+
+	void MemoryTracker::deallocate(MemoryTag, void* ptr, size_t) {
+		::operator delete(ptr);
+	}
+
+#else
+
+	void* MemoryTracker::allocate(MemoryTag tag, size_t size) {
+		auto* header = static_cast<AllocationHeader*>(::operator new(size + sizeof(AllocationHeader)));
+		header->size = size;
+		header->tag = tag;
+		header->tracked = isEnabled();
+
+		if (header->tracked) onAllocate(tag, size);
+
+		return header + 1;
+	}
+
+	void MemoryTracker::deallocate(MemoryTag, void* ptr, size_t) {
+		if (!ptr) return;
+
+		auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+		if (header->tracked) onFree(header->tag, header->size);
+
+		::operator delete(header);
+	}
+
+#endif
+}
+
+#if defined(HYPER_TRACK_ALLOCATIONS)
+
+namespace {
+	using hyp::AllocationHeader;
+
+	void* trackedNew(size_t size) {
+		void* block = std::malloc(size + sizeof(AllocationHeader));
+		if (!block) throw std::bad_alloc();
+
+		auto* header = static_cast<AllocationHeader*>(block);
+		header->size = size;
+		header->tag = hyp::MemoryTracker::getCurrentTag();
+		header->tracked = hyp::MemoryTracker::isEnabled();
+
+		if (header->tracked) hyp::MemoryTracker::onAllocate(header->tag, size);
+
+		return header + 1;
+	}
+
+	void trackedDelete(void* ptr) noexcept {
+		if (!ptr) return;
+
+		auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+		if (header->tracked) hyp::MemoryTracker::onFree(header->tag, header->size);
+
+		std::free(header);
+	}
+}
+
+void* operator new(size_t size) {
+	return trackedNew(size);
+}
+
+void* operator new[](size_t size) {
+	return trackedNew(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	trackedDelete(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	trackedDelete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	trackedDelete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+	trackedDelete(ptr);
+}
+
+#endif
@@ -0,0 +1,190 @@
+#pragma once
+#ifndef HYP_MEMORY_TRACKER_HPP
+	#define HYP_MEMORY_TRACKER_HPP
+
+	#include <array>
+	#include <cstddef>
+	#include <cstdint>
+	#include <filesystem>
+	#include <limits>
+	#include <new>
+	#include <string>
+
+namespace hyp {
+
+	enum class MemoryTag : uint8_t
+	{
+		Unknown = 0,
+		Renderer,
+		Scene,
+		Assets,
+		Scripting,
+		UI,
+		Count
+	};
+
+	enum class GpuResourceType : uint8_t
+	{
+		Texture = 0,
+		VertexBuffer,
+		ElementBuffer,
+		UniformBuffer,
+		Framebuffer,
+		Count
+	};
+
+	constexpr size_t MemoryTagCount = static_cast<size_t>(MemoryTag::Count);
+	constexpr size_t GpuResourceTypeCount = static_cast<size_t>(GpuResourceType::Count);
+
+	struct MemoryTagStats
+	{
+		int64_t currentBytes = 0;
+		int64_t peakBytes = 0;
+		uint64_t allocations = 0;
+		uint64_t frees = 0;
+
+		// values of the last completed frame
+		uint64_t frameAllocations = 0;
+		uint64_t frameBytes = 0;
+
+		uint64_t budgetBytes = 0; // 0 -> no budget
+	};
+
+	struct GpuResourceStats
+	{
+		int64_t currentBytes = 0;
+		int64_t peakBytes = 0;
+		int64_t liveCount = 0;
+		uint64_t created = 0;
+	};
+
+	struct MemoryStats
+	{
+		std::array<MemoryTagStats, MemoryTagCount> tags {};
+		std::array<GpuResourceStats, GpuResourceTypeCount> gpu {};
+
+		uint64_t frameIndex = 0;
+		uint64_t frameAllocations = 0;
+		uint64_t frameBytes = 0;
+
+		int64_t getCpuBytes() const;
+		int64_t getGpuBytes() const;
+	};
+
+	/**
+	* \brief opt-in CPU/GPU memory accounting.
+	*
+	* CPU allocations are attributed to the tag of the innermost MemoryScope on the
+	* allocating thread; containers can also use hyp::TrackedAllocator directly.
+	* Every allocation going through the global operator new is tracked when the
+	* engine is built with HYPER_TRACK_ALLOCATIONS (premake --track-allocations).
+	* GPU resources are always accounted, as they are created rarely.
+	*/
+	class MemoryTracker {
+	public:
+		static void enable(bool value);
+		static bool isEnabled();
+
+		/**
+		* \brief closes the per-frame counters, called once per frame by the Application
+		*/
+		static void newFrame();
+
+		/**
+		* \brief count unconditionally; check isEnabled when allocating and report the free
+		* only for blocks that were counted, otherwise toggling tracking skews the totals
+		*/
+		static void onAllocate(MemoryTag tag, size_t size);
+		static void onFree(MemoryTag tag, size_t size);
+
+		/**
+		* \brief allocates from the global heap on behalf of `tag`
+		*/
+		static void* allocate(MemoryTag tag, size_t size);
+		static void deallocate(MemoryTag tag, void* ptr, size_t size);
+
+		static void onGpuAllocate(GpuResourceType type, size_t size);
+		static void onGpuFree(GpuResourceType type, size_t size);
+
+		/**
+		* \brief a budget of 0 disables it; exceeding a budget logs a warning once.
+		*/
+		static void setBudget(MemoryTag tag, uint64_t bytes);
+		static void setGpuBudget(uint64_t bytes);
+		static bool isOverBudget(MemoryTag tag);
+		static bool isGpuOverBudget();
+
+		static MemoryStats getStats();
+
+		static std::string toJson();
+		static bool dumpJson(const std::filesystem::path& path);
+
+		static const char* getTagName(MemoryTag tag);
+		static const char* getGpuResourceName(GpuResourceType type);
+
+		static MemoryTag getCurrentTag();
+
+	private:
+		static void setCurrentTag(MemoryTag tag);
+		friend class MemoryScope;
+	};
+
+	/**
+	* \brief attributes the allocations made on this thread to `tag` until it goes out of scope
+	*/
+	class MemoryScope {
+	public:
+		MemoryScope(MemoryTag tag) : m_previous(MemoryTracker::getCurrentTag()) {
+			MemoryTracker::setCurrentTag(tag);
+		}
+
+		~MemoryScope() {
+			MemoryTracker::setCurrentTag(m_previous);
+		}
+
+		MemoryScope(const MemoryScope&) = delete;
+		MemoryScope& operator=(const MemoryScope&) = delete;
+
+	private:
+		MemoryTag m_previous;
+	};
+
+	template <typename T, MemoryTag Tag>
+	struct TrackedAllocator
+	{
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = TrackedAllocator<U, Tag>;
+		};
+
+		TrackedAllocator() = default;
+
+		template <typename U>
+		TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+		T* allocate(size_t count) {
+			if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+
+			return static_cast<T*>(MemoryTracker::allocate(Tag, count * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept {
+			MemoryTracker::deallocate(Tag, ptr, count * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const TrackedAllocator<U, Tag>&) const noexcept { return true; }
+
+		template <typename U>
+		bool operator!=(const TrackedAllocator<U, Tag>&) const noexcept { return false; }
+	};
+}
+
+	#define HYP_MEMORY_CONCAT_IMPL(a, b) a##b
+	#define HYP_MEMORY_CONCAT(a, b) HYP_MEMORY_CONCAT_IMPL(a, b)
+	#define HYP_MEMORY_SCOPE(tag) hyp::MemoryScope HYP_MEMORY_CONCAT(hypMemoryScope, __LINE__)(tag)
+
+#endif // !HYP_MEMORY_TRACKER_HPP
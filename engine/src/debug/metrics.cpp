@@ -0,0 +1,506 @@
+#include "metrics.hpp"
+
+#ifdef _WIN32
+	// winsock2 has to come before windows.h (pulled in by the logger)
+	#define WIN32_LEAN_AND_MEAN
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#else
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <netinet/in.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+#endif
+
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace {
+	enum class MetricType
+	{
+		Counter,
+		Gauge,
+		Histogram
+	};
+
+	struct Entry
+	{
+		MetricType type;
+		void* metric;
+		// what the exporter saw at its previous write, for interval percentiles
+		hyp::HistogramSnapshot previous;
+	};
+
+	std::mutex s_registryMutex;
+	std::deque<hyp::Counter> s_counters;
+	std::deque<hyp::Gauge> s_gauges;
+	std::deque<hyp::Histogram> s_histograms;
+	std::map<std::string, Entry> s_entries;
+
+	std::mutex s_exporterMutex;
+	std::condition_variable s_exporterWake;
+	std::thread s_exporter;
+	bool s_exporting = false;
+
+	const char* s_typeNames[] = { "counter", "gauge", "histogram" };
+	const double s_percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+	const char* s_percentileNames[] = { "p50", "p90", "p99", "p999" };
+
+#ifdef _WIN32
+	using Socket = SOCKET;
+	const Socket InvalidSocket = INVALID_SOCKET;
+	void closeSocket(Socket socket) { closesocket(socket); }
+#else
+	using Socket = int;
+	const Socket InvalidSocket = -1;
+	void closeSocket(Socket socket) { close(socket); }
+#endif
+
+	template <typename T>
+	T& findOrAdd(const std::string& name, MetricType type, std::deque<T>& storage) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+
+		auto it = s_entries.find(name);
+		if (it != s_entries.end())
+		{
+			HYP_ASSERT_CORE(it->second.type == type, "metric %s is already registered as a %s", name.c_str(), s_typeNames[(int)it->second.type]);
+			return *(T*)it->second.metric;
+		}
+
+		T& metric = storage.emplace_back();
+		s_entries.emplace(name, Entry { type, &metric, {} });
+		return metric;
+	}
+
+	uint64_t unixMilliseconds() {
+		using namespace std::chrono;
+		return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+	}
+
+	void writeHistogramJson(std::ostream& out, const hyp::HistogramSnapshot& snapshot) {
+		out << "{\"count\":" << snapshot.count << ",\"mean\":" << snapshot.getMean()
+		    << ",\"min\":" << snapshot.min << ",\"max\":" << snapshot.max;
+		for (size_t i = 0; i < std::size(s_percentiles); i++)
+		{
+			out << ",\"" << s_percentileNames[i] << "\":" << snapshot.getPercentile(s_percentiles[i]);
+		}
+		out << "}";
+	}
+
+	// `advance` moves the interval baseline forward, only the exporter does that
+	std::string buildJson(uint64_t time, bool advance) {
+		std::ostringstream out;
+		out << "{\"time\":" << time;
+
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		for (auto& [name, entry] : s_entries)
+		{
+			out << ",\"" << name << "\":";
+			switch (entry.type)
+			{
+			case MetricType::Counter:
+				out << ((hyp::Counter*)entry.metric)->get();
+				break;
+			case MetricType::Gauge:
+				out << ((hyp::Gauge*)entry.metric)->get();
+				break;
+			case MetricType::Histogram:
+			{
+				hyp::HistogramSnapshot snapshot = ((hyp::Histogram*)entry.metric)->snapshot();
+				hyp::HistogramSnapshot interval = snapshot.since(entry.previous);
+
+				out << "{\"total\":";
+				writeHistogramJson(out, snapshot);
+				out << ",\"interval\":";
+				writeHistogramJson(out, interval);
+				out << "}";
+
+				if (advance) entry.previous = std::move(snapshot);
+				break;
+			}
+			}
+		}
+
+		out << "}";
+		return out.str();
+	}
+
+	void writeCsv(std::ostream& out, uint64_t time) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+
+		auto writeHistogram = [&](const std::string& name, const hyp::HistogramSnapshot& snapshot) {
+			out << time << "," << name << ",histogram," << snapshot.getMean() << "," << snapshot.count << "," << snapshot.min;
+			for (double p : s_percentiles)
+			{
+				out << "," << snapshot.getPercentile(p);
+			}
+			out << "," << snapshot.max << "\n";
+		};
+
+		for (auto& [name, entry] : s_entries)
+		{
+			switch (entry.type)
+			{
+			case MetricType::Counter:
+				out << time << "," << name << ",counter," << ((hyp::Counter*)entry.metric)->get() << ",,,,,,,\n";
+				break;
+			case MetricType::Gauge:
+				out << time << "," << name << ",gauge," << ((hyp::Gauge*)entry.metric)->get() << ",,,,,,,\n";
+				break;
+			case MetricType::Histogram:
+			{
+				hyp::HistogramSnapshot snapshot = ((hyp::Histogram*)entry.metric)->snapshot();
+				writeHistogram(name, snapshot);
+				writeHistogram(name + ".interval", snapshot.since(entry.previous));
+				entry.previous = std::move(snapshot);
+				break;
+			}
+			}
+		}
+	}
+
+	void exportTo(const hyp::MetricsExportSettings& settings) {
+		bool exists = std::filesystem::exists(settings.path);
+		std::ofstream file(settings.path, std::ios::out | std::ios::app);
+		if (!file.is_open())
+		{
+			HYP_ERROR("Failed to open metrics export %s", settings.path.string().c_str());
+			return;
+		}
+
+		uint64_t time = unixMilliseconds();
+		if (settings.format == hyp::MetricsFormat::JsonLines)
+		{
+			file << buildJson(time, true) << "\n";
+		}
+		else
+		{
+			if (!exists) file << "time,name,type,value,count,min,p50,p90,p99,p999,max\n";
+			writeCsv(file, time);
+		}
+	}
+
+	Socket openListener(uint16_t port) {
+#ifdef _WIN32
+		WSADATA data;
+		if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return InvalidSocket;
+#endif
+
+		Socket listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (listener == InvalidSocket)
+		{
+#ifdef _WIN32
+			WSACleanup();
+#endif
+			return InvalidSocket;
+		}
+
+#ifndef _WIN32
+		// a restarted instance shouldn't have to wait for the old connections' TIME_WAIT
+		int reuse = 1;
+		setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+		sockaddr_in address {};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		// local scrapers only
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 4) != 0)
+		{
+			closeSocket(listener);
+#ifdef _WIN32
+			// balances the WSAStartup above, the exporter only cleans up after a listener it got
+			WSACleanup();
+#endif
+			return InvalidSocket;
+		}
+
+		// the exporter polls between its writes, accept must not block
+#ifdef _WIN32
+		u_long nonBlocking = 1;
+		ioctlsocket(listener, FIONBIO, &nonBlocking);
+#else
+		fcntl(listener, F_SETFL, fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+		return listener;
+	}
+
+	void serveClients(Socket listener) {
+		while (true)
+		{
+			Socket client = accept(listener, nullptr, nullptr);
+			if (client == InvalidSocket) return;
+
+			std::string line = buildJson(unixMilliseconds(), false) + "\n";
+			send(client, line.data(), (int)line.size(), 0);
+			closeSocket(client);
+		}
+	}
+
+	void runExporter(hyp::MetricsExportSettings settings) {
+		if (settings.path.has_parent_path())
+		{
+			std::error_code error;
+			std::filesystem::create_directories(settings.path.parent_path(), error);
+		}
+
+		Socket listener = InvalidSocket;
+		if (settings.port > 0)
+		{
+			listener = openListener(settings.port);
+			if (listener == InvalidSocket) HYP_WARN("Metrics: couldn't listen on 127.0.0.1:%u", settings.port);
+		}
+
+		using clock = std::chrono::steady_clock;
+		auto interval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(settings.intervalSeconds));
+		// a scraper shouldn't wait for the next write to be answered
+		auto poll = listener != InvalidSocket ? std::chrono::duration_cast<clock::duration>(std::chrono::milliseconds(100)) : interval;
+		auto nextExport = clock::now() + interval;
+
+		std::unique_lock<std::mutex> lock(s_exporterMutex);
+		while (s_exporting)
+		{
+			s_exporterWake.wait_until(lock, std::min(nextExport, clock::now() + poll));
+			if (!s_exporting) break;
+
+			lock.unlock();
+			if (listener != InvalidSocket) serveClients(listener);
+			if (clock::now() >= nextExport)
+			{
+				exportTo(settings);
+				nextExport += interval;
+			}
+			lock.lock();
+		}
+		lock.unlock();
+
+		// the last partial interval
+		exportTo(settings);
+
+		if (listener != InvalidSocket)
+		{
+			closeSocket(listener);
+#ifdef _WIN32
+			WSACleanup();
+#endif
+		}
+	}
+}
+
+void hyp::Gauge::add(double value) {
+	double current = m_value.load(std::memory_order_relaxed);
+	while (!m_value.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+	{
+	}
+}
+
+uint32_t hyp::Histogram::getBucketIndex(uint64_t value) {
+	constexpr uint64_t maxValue = (1ull << (MaxShift + SubBucketBits + 1)) - 1;
+	value = std::min(value, maxValue);
+	if (value < SubBucketCount) return (uint32_t)value;
+
+	// keep the top SubBucketBits + 1 bits, the rest is the bucket's width
+	uint32_t shift = (uint32_t)std::bit_width(value) - 1 - SubBucketBits;
+	uint32_t top = (uint32_t)(value >> shift);
+	return SubBucketCount * (shift + 1) + (top - SubBucketCount);
+}
+
+uint64_t hyp::Histogram::getBucketValue(uint32_t index) {
+	uint32_t group = index / SubBucketCount;
+	if (group == 0) return index;
+
+	uint64_t top = SubBucketCount + index % SubBucketCount;
+	return top << (group - 1);
+}
+
+void hyp::Histogram::record(uint64_t value) {
+	m_buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t current = m_min.load(std::memory_order_relaxed);
+	while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+	{
+	}
+
+	current = m_max.load(std::memory_order_relaxed);
+	while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+hyp::HistogramSnapshot hyp::Histogram::snapshot() const {
+	HistogramSnapshot snapshot;
+	snapshot.buckets.resize(BucketCount);
+	// concurrent records may land between these loads; off by a sample at most
+	for (uint32_t i = 0; i < BucketCount; i++)
+	{
+		snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		snapshot.count += snapshot.buckets[i];
+	}
+
+	snapshot.sum = m_sum.load(std::memory_order_relaxed);
+	snapshot.max = m_max.load(std::memory_order_relaxed);
+	snapshot.min = snapshot.count ? m_min.load(std::memory_order_relaxed) : 0;
+	return snapshot;
+}
+
+uint64_t hyp::HistogramSnapshot::getPercentile(double p) const {
+	if (count == 0) return 0;
+
+	uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * count));
+	uint64_t seen = 0;
+	for (uint32_t i = 0; i < (uint32_t)buckets.size(); i++)
+	{
+		seen += buckets[i];
+		if (seen >= target)
+		{
+			// report the bucket's upper edge, a percentile should never be flattering
+			uint64_t upper = hyp::Histogram::getBucketValue(i + 1) - 1;
+			return std::clamp(upper, min, max);
+		}
+	}
+
+	return max;
+}
+
+hyp::HistogramSnapshot hyp::HistogramSnapshot::since(const HistogramSnapshot& previous) const {
+	HistogramSnapshot interval = *this;
+	if (previous.buckets.size() != buckets.size()) return interval;
+
+	interval.count = 0;
+	for (size_t i = 0; i < buckets.size(); i++)
+	{
+		interval.buckets[i] -= std::min(interval.buckets[i], previous.buckets[i]);
+		interval.count += interval.buckets[i];
+	}
+	interval.sum -= std::min(interval.sum, previous.sum);
+	return interval;
+}
+
+hyp::Counter& hyp::Metrics::counter(const std::string& name) {
+	return findOrAdd(name, MetricType::Counter, s_counters);
+}
+
+hyp::Gauge& hyp::Metrics::gauge(const std::string& name) {
+	return findOrAdd(name, MetricType::Gauge, s_gauges);
+}
+
+hyp::Histogram& hyp::Metrics::histogram(const std::string& name) {
+	return findOrAdd(name, MetricType::Histogram, s_histograms);
+}
+
+void hyp::Metrics::startExporter(const MetricsExportSettings& settings) {
+	stopExporter();
+
+	{
+		std::lock_guard<std::mutex> lock(s_exporterMutex);
+		s_exporting = true;
+	}
+
+	s_exporter = std::thread(runExporter, settings);
+	HYP_INFO("Exporting metrics to %s every %.1fs", settings.path.string().c_str(), settings.intervalSeconds);
+}
+
+void hyp::Metrics::stopExporter() {
+	{
+		std::lock_guard<std::mutex> lock(s_exporterMutex);
+		if (!s_exporting) return;
+		s_exporting = false;
+	}
+
+	// the exporter writes a last line on its way out
+	s_exporterWake.notify_all();
+	if (s_exporter.joinable()) s_exporter.join();
+}
+
+bool hyp::Metrics::startExporter(int argc, char** argv) {
+	MetricsExportSettings settings;
+	bool enabled = false;
+	bool customPath = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg = argv[i];
+		if (arg.rfind("--metrics", 0) != 0) continue;
+
+		size_t equals = arg.find('=');
+		std::string_view option = arg.substr(0, equals);
+		std::string value(equals == std::string_view::npos ? std::string_view() : arg.substr(equals + 1));
+
+		if (option == "--metrics")
+		{
+			enabled = true;
+			if (!value.empty())
+			{
+				settings.path = value;
+				customPath = true;
+			}
+		}
+		else if (option == "--metrics-format")
+		{
+			enabled = true;
+			if (value == "csv")
+				settings.format = MetricsFormat::Csv;
+			else if (value == "jsonl")
+				settings.format = MetricsFormat::JsonLines;
+			else
+				HYP_WARN("Metrics: unknown format '%s', expected jsonl or csv", value.c_str());
+		}
+		else if (option == "--metrics-interval")
+		{
+			enabled = true;
+			float seconds = std::strtof(value.c_str(), nullptr);
+			if (seconds > 0.f) settings.intervalSeconds = seconds;
+		}
+		else if (option == "--metrics-port")
+		{
+			enabled = true;
+			unsigned long port = std::strtoul(value.c_str(), nullptr, 10);
+			if (port > 0 && port <= UINT16_MAX) settings.port = (uint16_t)port;
+		}
+		else
+		{
+			HYP_WARN("Metrics: unknown option %s", argv[i]);
+		}
+	}
+
+	if (!enabled) return false;
+
+	if (!customPath && settings.format == MetricsFormat::Csv) settings.path.replace_extension(".csv");
+	startExporter(settings);
+	return true;
+}
+
+bool hyp::Metrics::isExporting() {
+	std::lock_guard<std::mutex> lock(s_exporterMutex);
+	return s_exporting;
+}
+
+std::string hyp::Metrics::toJson() {
+	return buildJson(unixMilliseconds(), false);
+}
+
+void hyp::Metrics::recordGpuUpload(size_t bytes) {
+	static hyp::Counter& s_uploads = counter("gpu.uploads");
+	static hyp::Counter& s_uploadBytes = counter("gpu.upload_bytes");
+
+	s_uploads.add();
+	s_uploadBytes.add(bytes);
+}
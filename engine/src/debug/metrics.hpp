@@ -0,0 +1,144 @@
+#pragma once
+#ifndef HYP_METRICS_HPP
+	#define HYP_METRICS_HPP
+
+	#include <array>
+	#include <atomic>
+	#include <cstdint>
+	#include <filesystem>
+	#include <string>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief monotonically increasing count, e.g. draw calls or bytes uploaded
+	*/
+	class Counter {
+	public:
+		void add(uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+		uint64_t get() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_value { 0 };
+	};
+
+	/**
+	* \brief last written value, e.g. the number of live entities
+	*/
+	class Gauge {
+	public:
+		void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+		void add(double value);
+		double get() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<double> m_value { 0.0 };
+	};
+
+	struct HistogramSnapshot;
+
+	/**
+	* \brief HDR-style histogram of integer values (by convention microseconds).
+	*
+	* Every power of two is split into SubBucketCount linear buckets, so any recorded
+	* value is known within ~3% across 1us .. several hours. Recording is a few
+	* relaxed atomic increments and never allocates.
+	*/
+	class Histogram {
+	public:
+		static constexpr uint32_t SubBucketBits = 5;
+		static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+		static constexpr uint32_t MaxShift = 36; // values are clamped to 2^42 - 1 (~50 days in us)
+		static constexpr uint32_t BucketCount = SubBucketCount * (MaxShift + 2);
+
+		void record(uint64_t value);
+		void recordMs(double ms) { record(ms <= 0.0 ? 0 : (uint64_t)(ms * 1000.0)); }
+
+		HistogramSnapshot snapshot() const;
+
+		static uint32_t getBucketIndex(uint64_t value);
+		// smallest value that falls into `index`
+		static uint64_t getBucketValue(uint32_t index);
+
+	private:
+		std::array<std::atomic<uint64_t>, BucketCount> m_buckets {};
+		std::atomic<uint64_t> m_count { 0 };
+		std::atomic<uint64_t> m_sum { 0 };
+		std::atomic<uint64_t> m_min { UINT64_MAX };
+		std::atomic<uint64_t> m_max { 0 };
+	};
+
+	struct HistogramSnapshot
+	{
+		std::vector<uint64_t> buckets;
+		uint64_t count = 0;
+		uint64_t sum = 0;
+		uint64_t min = 0;
+		uint64_t max = 0;
+
+		double getMean() const { return count ? (double)sum / count : 0.0; }
+		// `p` in [0, 100]
+		uint64_t getPercentile(double p) const;
+
+		/**
+		* \brief the values recorded since `previous` was taken; min and max stay those of the whole run
+		*/
+		HistogramSnapshot since(const HistogramSnapshot& previous) const;
+	};
+
+	enum class MetricsFormat
+	{
+		JsonLines,
+		Csv
+	};
+
+	struct MetricsExportSettings
+	{
+		std::filesystem::path path = "metrics/metrics.jsonl";
+		MetricsFormat format = MetricsFormat::JsonLines;
+		float intervalSeconds = 10.f;
+
+		// > 0: serve the latest export as a JSON line to whoever connects to 127.0.0.1:port
+		uint16_t port = 0;
+	};
+
+	/**
+	* \brief process-wide registry of named counters, gauges and histograms.
+	*
+	* Looking a metric up takes a lock, so subsystems look theirs up once and keep the
+	* reference (a function-local static works well); updating it afterwards is lock-free.
+	* Metrics live until the process exits.
+	*
+	* The exporter thread appends a line per interval to the export file: the running totals,
+	* and for histograms the percentiles of both the whole run and the last interval.
+	*/
+	class Metrics {
+	public:
+		static Counter& counter(const std::string& name);
+		static Gauge& gauge(const std::string& name);
+		static Histogram& histogram(const std::string& name);
+
+		static void startExporter(const MetricsExportSettings& settings = {});
+		/**
+		* \brief starts the exporter when the command line asks for it:
+		* --metrics[=path] --metrics-format=jsonl|csv --metrics-interval=seconds --metrics-port=port
+		* (any of them enables it); returns whether it was started
+		*/
+		static bool startExporter(int argc, char** argv);
+		static void stopExporter();
+		static bool isExporting();
+
+		/**
+		* \brief a JSON line with the current value of every metric
+		*/
+		static std::string toJson();
+
+		/**
+		* \brief counts a CPU to GPU transfer into gpu.uploads and gpu.upload_bytes
+		*/
+		static void recordGpuUpload(size_t bytes);
+	};
+}
+
+#endif // !HYP_METRICS_HPP
@@ -0,0 +1,212 @@
+#include "archive.hpp"
+#include <debug/memory_tracker.hpp>
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <cstring>
+
+#ifdef HYPER_ARCHIVE_LZ4
+	#include <lz4.h>
+#endif
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+hyp::FileData::FileData(FileData&& other) noexcept {
+	*this = std::move(other);
+}
+
+hyp::FileData& hyp::FileData::operator=(FileData&& other) noexcept {
+	if (this == &other) return *this;
+
+	bool owned = !other.m_buffer.empty() && other.m_data == other.m_buffer.data();
+	m_buffer = std::move(other.m_buffer);
+	m_owner = std::move(other.m_owner);
+	m_data = owned ? m_buffer.data() : other.m_data;
+	m_size = other.m_size;
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	return *this;
+}
+
+hyp::FileData hyp::FileData::view(const uint8_t* data, size_t size, hyp::Ref<const void> owner) {
+	FileData file;
+	file.m_data = data;
+	file.m_size = size;
+	file.m_owner = std::move(owner);
+	return file;
+}
+
+hyp::FileData hyp::FileData::own(std::vector<uint8_t>&& buffer) {
+	FileData file;
+	file.m_buffer = std::move(buffer);
+	file.m_size = file.m_buffer.size();
+	// an empty file is still a file, point at something non-null
+	static const uint8_t s_empty = 0;
+	file.m_data = file.m_buffer.empty() ? &s_empty : file.m_buffer.data();
+	return file;
+}
+
+hyp::Ref<hyp::Archive> hyp::Archive::open(const std::string& path) {
+	hyp::Ref<Archive> archive(new Archive());
+
+	if (!archive->map(path))
+	{
+		HYP_WARN("Couldn't map archive %s", path.c_str());
+		return nullptr;
+	}
+
+	if (!archive->validate())
+	{
+		HYP_ERROR("%s is not a valid archive", path.c_str());
+		return nullptr;
+	}
+
+	archive->m_path = path;
+	HYP_INFO("Mapped archive %s: %u entries, %zu bytes", path.c_str(), archive->m_header->entryCount, archive->m_size);
+	return archive;
+}
+
+hyp::Archive::~Archive() {
+	unmap();
+}
+
+bool hyp::Archive::map(const std::string& path) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	m_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return false;
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) return false;
+	m_mapping = mapping;
+
+	m_base = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	m_size = (size_t)size.QuadPart;
+#else
+	m_fd = ::open(path.c_str(), O_RDONLY);
+	if (m_fd < 0) return false;
+
+	struct stat st;
+	if (fstat(m_fd, &st) != 0 || st.st_size == 0) return false;
+
+	void* base = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+	if (base == MAP_FAILED) return false;
+
+	m_base = (const uint8_t*)base;
+	m_size = (size_t)st.st_size;
+#endif
+
+	return m_base != nullptr;
+}
+
+void hyp::Archive::unmap() {
+#ifdef _WIN32
+	if (m_base) UnmapViewOfFile(m_base);
+	if (m_mapping) CloseHandle((HANDLE)m_mapping);
+	if (m_file) CloseHandle((HANDLE)m_file);
+	m_mapping = nullptr;
+	m_file = nullptr;
+#else
+	if (m_base) munmap((void*)m_base, m_size);
+	if (m_fd >= 0) ::close(m_fd);
+	m_fd = -1;
+#endif
+
+	m_base = nullptr;
+	m_size = 0;
+}
+
+bool hyp::Archive::validate() {
+	if (m_size < sizeof(archive::Header)) return false;
+
+	m_header = (const archive::Header*)m_base;
+	if (std::memcmp(m_header->magic, archive::Magic, sizeof(archive::Magic)) != 0) return false;
+
+	if (m_header->version != archive::Version)
+	{
+		HYP_ERROR("Archive version %u, expected %u", m_header->version, archive::Version);
+		return false;
+	}
+
+	uint64_t tocSize = (uint64_t)m_header->entryCount * sizeof(archive::Entry);
+	if (m_header->tocOffset > m_size || tocSize > m_size - m_header->tocOffset) return false;
+	if (m_header->stringsOffset > m_size || m_header->stringsSize > m_size - m_header->stringsOffset) return false;
+
+	m_entries = (const archive::Entry*)(m_base + m_header->tocOffset);
+	m_strings = (const char*)(m_base + m_header->stringsOffset);
+
+	// reject entries pointing outside the file once, so reads don't have to
+	for (const archive::Entry& entry : getEntries())
+	{
+		// compared without adding, so huge values can't wrap around
+		if (entry.offset > m_size || entry.storedSize > m_size - entry.offset) return false;
+		// uncompressed entries are returned in place, `size` bytes of the blob
+		if ((entry.flags & archive::EntryLZ4) == 0 && entry.size != entry.storedSize) return false;
+		if ((uint64_t)entry.pathOffset + entry.pathLength > m_header->stringsSize) return false;
+	}
+
+	return true;
+}
+
+const hyp::archive::Entry* hyp::Archive::find(std::string_view path) const {
+	std::string normalized = archive::normalizePath(path);
+	uint64_t hash = archive::hashPath(normalized);
+
+	auto entries = getEntries();
+	auto it = std::lower_bound(entries.begin(), entries.end(), hash,
+	    [](const archive::Entry& entry, uint64_t value) { return entry.pathHash < value; });
+
+	// walk the (rare) hash collisions and compare the stored path
+	for (; it != entries.end() && it->pathHash == hash; ++it)
+	{
+		if (getEntryPath(*it) == normalized) return &*it;
+	}
+
+	return nullptr;
+}
+
+hyp::FileData hyp::Archive::read(std::string_view path) const {
+	const archive::Entry* entry = find(path);
+	return entry ? read(*entry) : FileData();
+}
+
+hyp::FileData hyp::Archive::read(const archive::Entry& entry) const {
+	const uint8_t* blob = m_base + entry.offset;
+
+	if ((entry.flags & archive::EntryLZ4) == 0)
+	{
+		return FileData::view(blob, (size_t)entry.size, shared_from_this());
+	}
+
+#ifdef HYPER_ARCHIVE_LZ4
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+
+	std::vector<uint8_t> buffer((size_t)entry.size);
+	int written = LZ4_decompress_safe((const char*)blob, (char*)buffer.data(), (int)entry.storedSize, (int)entry.size);
+	if (written < 0 || (uint64_t)written != entry.size)
+	{
+		HYP_ERROR("Corrupted archive entry %.*s", (int)entry.pathLength, m_strings + entry.pathOffset);
+		return {};
+	}
+
+	return FileData::own(std::move(buffer));
+#else
+	HYP_ERROR("%.*s is LZ4-compressed, but the engine was built without LZ4 support", (int)entry.pathLength, m_strings + entry.pathOffset);
+	return {};
+#endif
+}
+
+std::string_view hyp::Archive::getEntryPath(const archive::Entry& entry) const {
+	return { m_strings + entry.pathOffset, entry.pathLength };
+}
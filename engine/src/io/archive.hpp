@@ -0,0 +1,99 @@
+#pragma once
+#ifndef HYPER_ARCHIVE_HPP
+	#define HYPER_ARCHIVE_HPP
+
+	#include <core/base.hpp>
+	#include <io/archive_format.hpp>
+	#include <cstdint>
+	#include <span>
+	#include <string>
+	#include <string_view>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief the bytes of a file, either a view into a mapped archive or a buffer it owns.
+	* A view keeps its archive mapped for as long as the FileData lives.
+	*/
+	class FileData {
+	public:
+		FileData() = default;
+
+		// an owned FileData points into its own buffer, copies would point into the original
+		FileData(const FileData&) = delete;
+		FileData& operator=(const FileData&) = delete;
+		FileData(FileData&& other) noexcept;
+		FileData& operator=(FileData&& other) noexcept;
+
+		static FileData view(const uint8_t* data, size_t size, hyp::Ref<const void> owner);
+		static FileData own(std::vector<uint8_t>&& buffer);
+
+		const uint8_t* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool isValid() const { return m_data != nullptr; }
+		/** \brief true when the data points into a mapped archive rather than a copy */
+		bool isMapped() const { return m_owner != nullptr; }
+
+		std::span<const uint8_t> getSpan() const { return { m_data, m_size }; }
+		std::string_view getText() const { return { (const char*)m_data, m_size }; }
+
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+		std::vector<uint8_t> m_buffer;
+		hyp::Ref<const void> m_owner;
+	};
+
+	/**
+	* \brief a read-only, memory-mapped .hpak archive (see io/archive_format.hpp).
+	* Lookups binary-search the hashed table of contents in place, nothing is parsed up front.
+	*/
+	class Archive : public std::enable_shared_from_this<Archive> {
+	public:
+		static hyp::Ref<Archive> open(const std::string& path);
+
+		~Archive();
+
+		Archive(const Archive&) = delete;
+		Archive& operator=(const Archive&) = delete;
+
+		const archive::Entry* find(std::string_view path) const;
+		bool contains(std::string_view path) const { return find(path) != nullptr; }
+
+		/**
+		* \brief uncompressed entries are returned in place, compressed ones are decompressed into a new buffer
+		*/
+		FileData read(const archive::Entry& entry) const;
+		FileData read(std::string_view path) const;
+
+		std::string_view getEntryPath(const archive::Entry& entry) const;
+		std::span<const archive::Entry> getEntries() const { return { m_entries, m_header->entryCount }; }
+		const std::string& getPath() const { return m_path; }
+		size_t getMappedSize() const { return m_size; }
+
+	private:
+		Archive() = default;
+
+		bool map(const std::string& path);
+		void unmap();
+		bool validate();
+
+	private:
+		std::string m_path;
+		const uint8_t* m_base = nullptr;
+		size_t m_size = 0;
+		const archive::Header* m_header = nullptr;
+		const archive::Entry* m_entries = nullptr;
+		const char* m_strings = nullptr;
+
+	#ifdef _WIN32
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+	#else
+		int m_fd = -1;
+	#endif
+	};
+}
+
+#endif // !HYPER_ARCHIVE_HPP
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef HYPER_ARCHIVE_FORMAT_HPP
+	#define HYPER_ARCHIVE_FORMAT_HPP
+
+	#include <cstdint>
+	#include <string>
+	#include <string_view>
+
+// on-disk layout of a .hpak archive, shared by the engine and tools/asset-packer.
+// Keep this header free of engine includes, the packer builds without the engine.
+namespace hyp::archive {
+
+	constexpr char Magic[4] = { 'H', 'P', 'A', 'K' };
+	constexpr uint32_t Version = 1;
+
+	// blobs start on a cache line so uncompressed data can be handed out in place
+	constexpr uint32_t DefaultAlignment = 64;
+
+	enum EntryFlags : uint32_t
+	{
+		EntryNone = 0,
+		EntryLZ4 = 1 << 0,
+	};
+
+	/**
+	* \brief file header, followed by the blobs; the table of contents and the path strings sit at the end
+	*/
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t alignment;
+		uint64_t tocOffset;
+		uint64_t stringsOffset;
+		uint64_t stringsSize;
+	};
+
+	/**
+	* \brief table of contents entry, the table is sorted by `pathHash` for binary search
+	*/
+	struct Entry
+	{
+		uint64_t pathHash;
+		uint64_t offset;
+		uint64_t storedSize;
+		uint64_t size;
+		uint32_t pathOffset;
+		uint32_t pathLength;
+		uint32_t flags;
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 40, "archive header layout changed");
+	static_assert(sizeof(Entry) == 48, "archive entry layout changed");
+
+	/**
+	* \brief forward slashes, no leading "./" - the form paths are hashed and stored in
+	*/
+	inline std::string normalizePath(std::string_view path) {
+		std::string result(path);
+		for (char& c : result)
+		{
+			if (c == '\\') c = '/';
+		}
+
+		while (result.rfind("./", 0) == 0)
+		{
+			result.erase(0, 2);
+		}
+
+		return result;
+	}
+
+	// FNV-1a over the normalized path
+	constexpr uint64_t hashPath(std::string_view path) {
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : path)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+#endif // !HYPER_ARCHIVE_FORMAT_HPP
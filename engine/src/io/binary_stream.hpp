@@ -0,0 +1,82 @@
+#pragma once
+#ifndef HYP_BINARY_STREAM_HPP
+	#define HYP_BINARY_STREAM_HPP
+
+	#include <cstdint>
+	#include <cstring>
+	#include <span>
+	#include <string>
+	#include <type_traits>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief reads native-endian values from a byte span. Reading past the end yields zeroed values
+	* and clears `ok`, so a parser can check once at the end.
+	*/
+	struct BinaryReader
+	{
+		std::span<const uint8_t> bytes;
+		size_t offset = 0;
+		bool ok = true;
+
+		template <typename T>
+		T read() {
+			static_assert(std::is_trivially_copyable_v<T>);
+			T value {};
+			readBytes(&value, sizeof(T));
+			return value;
+		}
+
+		bool readBytes(void* destination, size_t size) {
+			if (!ok || size > remaining())
+			{
+				ok = false;
+				return false;
+			}
+
+			if (size) std::memcpy(destination, bytes.data() + offset, size);
+			offset += size;
+			return true;
+		}
+
+		std::string readString() {
+			uint32_t length = read<uint32_t>();
+			if (!ok || length > remaining())
+			{
+				ok = false;
+				return {};
+			}
+
+			std::string text((const char*)bytes.data() + offset, length);
+			offset += length;
+			return text;
+		}
+
+		size_t remaining() const { return bytes.size() - offset; }
+	};
+
+	struct BinaryWriter
+	{
+		std::vector<uint8_t> bytes;
+
+		template <typename T>
+		void write(const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			writeBytes(&value, sizeof(T));
+		}
+
+		void writeBytes(const void* data, size_t size) {
+			const uint8_t* begin = (const uint8_t*)data;
+			bytes.insert(bytes.end(), begin, begin + size);
+		}
+
+		void writeString(const std::string& text) {
+			write((uint32_t)text.size());
+			bytes.insert(bytes.end(), text.begin(), text.end());
+		}
+	};
+}
+
+#endif // !HYP_BINARY_STREAM_HPP
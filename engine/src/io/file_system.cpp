@@ -0,0 +1,92 @@
+#include "file_system.hpp"
+#include <debug/memory_tracker.hpp>
+#include <utils/logger.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace {
+	std::shared_mutex s_mountMutex;
+	std::vector<hyp::Ref<hyp::Archive>> s_archives;
+	std::atomic<bool> s_looseFallback = true;
+
+	hyp::FileData readLoose(std::string_view path) {
+		HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+
+		std::ifstream file(std::string(path), std::ios::binary | std::ios::ate);
+		if (!file.is_open()) return {};
+
+		std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+
+		std::vector<uint8_t> buffer((size_t)size);
+		if (size > 0 && !file.read((char*)buffer.data(), size)) return {};
+
+		return hyp::FileData::own(std::move(buffer));
+	}
+}
+
+bool hyp::FileSystem::mount(const std::string& archivePath) {
+	hyp::Ref<hyp::Archive> archive = hyp::Archive::open(archivePath);
+	if (!archive) return false;
+
+	std::unique_lock lock(s_mountMutex);
+	s_archives.push_back(std::move(archive));
+	return true;
+}
+
+void hyp::FileSystem::unmount(const std::string& archivePath) {
+	std::unique_lock lock(s_mountMutex);
+	std::erase_if(s_archives, [&](const hyp::Ref<hyp::Archive>& archive) { return archive->getPath() == archivePath; });
+}
+
+void hyp::FileSystem::unmountAll() {
+	// outstanding FileData views keep their archive mapped until they are dropped
+	std::unique_lock lock(s_mountMutex);
+	s_archives.clear();
+}
+
+hyp::FileData hyp::FileSystem::read(std::string_view path) {
+	{
+		std::shared_lock lock(s_mountMutex);
+		for (auto it = s_archives.rbegin(); it != s_archives.rend(); ++it)
+		{
+			if (const archive::Entry* entry = (*it)->find(path))
+			{
+				return (*it)->read(*entry);
+			}
+		}
+	}
+
+	if (!s_looseFallback.load(std::memory_order_relaxed))
+	{
+		HYP_WARN("%.*s is not in any mounted archive", (int)path.size(), path.data());
+		return {};
+	}
+
+	return readLoose(path);
+}
+
+bool hyp::FileSystem::exists(std::string_view path) {
+	{
+		std::shared_lock lock(s_mountMutex);
+		for (const auto& archive : s_archives)
+		{
+			if (archive->contains(path)) return true;
+		}
+	}
+
+	std::error_code ec;
+	return s_looseFallback.load(std::memory_order_relaxed) && std::filesystem::exists(std::filesystem::path(path), ec);
+}
+
+void hyp::FileSystem::setLooseFallback(bool enabled) {
+	s_looseFallback.store(enabled, std::memory_order_relaxed);
+}
+
+bool hyp::FileSystem::isLooseFallbackEnabled() {
+	return s_looseFallback.load(std::memory_order_relaxed);
+}
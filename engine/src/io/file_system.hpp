@@ -0,0 +1,33 @@
+#pragma once
+#ifndef HYPER_FILE_SYSTEM_HPP
+	#define HYPER_FILE_SYSTEM_HPP
+
+	#include <io/archive.hpp>
+	#include <string>
+	#include <string_view>
+
+namespace hyp {
+
+	/**
+	* \brief virtual file system the asset loaders read through.
+	*
+	* Mounted archives are searched newest first, so a patch archive mounted later overrides
+	* the base one. Paths no archive contains are read from disk when the loose file
+	* fallback is on, which keeps the edit-reload loop working during development.
+	* Safe to read from any thread.
+	*/
+	class FileSystem {
+	public:
+		static bool mount(const std::string& archivePath);
+		static void unmount(const std::string& archivePath);
+		static void unmountAll();
+
+		static FileData read(std::string_view path);
+		static bool exists(std::string_view path);
+
+		static void setLooseFallback(bool enabled);
+		static bool isLooseFallbackEnabled();
+	};
+}
+
+#endif // !HYPER_FILE_SYSTEM_HPP
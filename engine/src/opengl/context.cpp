@@ -1,4 +1,6 @@
 #include <opengl/context.hpp>
+#include <opengl/debug_output.hpp>
+#include <opengl/extensions.hpp>
 #include <utils/assert.hpp>
 
 hyp::OpenglContext::OpenglContext(GLFWwindow* window) {
@@ -11,6 +13,9 @@ void hyp::OpenglContext::init() {
 	int val = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
 	HYP_ASSERT_CORE(val, "Failed to initialize GLAD (graphics API)");
+
+	hyp::OpenglExtensions::load();
+	hyp::OpenglDebugOutput::install();
 }
 
 void hyp::OpenglContext::swapBuffer() {
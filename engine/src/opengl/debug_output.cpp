@@ -0,0 +1,249 @@
+#include "debug_output.hpp"
+#include <GLFW/glfw3.h>
+#include <debug/flight_recorder.hpp>
+#include <debug/metrics.hpp>
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	using DebugMessageCallbackFn = void(APIENTRYP)(GLDEBUGPROC callback, const void* userParam);
+	using DebugMessageControlFn = void(APIENTRYP)(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled);
+
+	DebugMessageControlFn s_debugMessageControl = nullptr;
+	// ARB_debug_output has no GL_DEBUG_OUTPUT switch and no notification severity
+	bool s_khrDebug = false;
+	bool s_installed = false;
+
+	GLenum s_minimumSeverity = GL_DEBUG_SEVERITY_LOW;
+	std::vector<GLuint> s_ignored;
+	std::atomic<bool> s_failOnPerformance = false;
+
+	// synchronous output: the callback runs on the thread that made the offending call,
+	// which is always the render thread, so none of this needs a lock
+	std::unordered_map<uint64_t, uint32_t> s_seen;
+	constexpr size_t MaxSeen = 4096;
+
+	uint32_t s_framePerformance = 0;
+	uint32_t s_lastFramePerformance = 0;
+	uint64_t s_totalPerformance = 0;
+
+	thread_local const char* s_tag = nullptr;
+
+	int getSeverityRank(GLenum severity) {
+		switch (severity)
+		{
+		case GL_DEBUG_SEVERITY_HIGH: return 3;
+		case GL_DEBUG_SEVERITY_MEDIUM: return 2;
+		case GL_DEBUG_SEVERITY_LOW: return 1;
+		default: return 0;
+		}
+	}
+
+	const char* getSourceName(GLenum source) {
+		switch (source)
+		{
+		case GL_DEBUG_SOURCE_API: return "api";
+		case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+		case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+		case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+		case GL_DEBUG_SOURCE_APPLICATION: return "application";
+		default: return "other";
+		}
+	}
+
+	const char* getTypeName(GLenum type) {
+		switch (type)
+		{
+		case GL_DEBUG_TYPE_ERROR: return "error";
+		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+		case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+		case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+		default: return "other";
+		}
+	}
+
+	uint64_t getMessageKey(GLenum source, GLenum type, GLuint id, std::string_view message) {
+		// some drivers reuse id 0 for everything, so the text is part of the key
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : message)
+		{
+			hash = (hash ^ (uint8_t)c) * 1099511628211ull;
+		}
+		return hash ^ ((uint64_t)source << 48) ^ ((uint64_t)type << 32) ^ id;
+	}
+
+	bool shouldLog(uint32_t count) {
+		if (count == 1) return true;
+		while (count % 10 == 0) count /= 10;
+		return count == 1;
+	}
+
+	void applyFilter() {
+		if (!s_debugMessageControl) return;
+
+		const GLenum severities[] = { GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH };
+		int minimum = getSeverityRank(s_minimumSeverity);
+		for (GLenum severity : severities)
+		{
+			if (severity == GL_DEBUG_SEVERITY_NOTIFICATION && !s_khrDebug) continue;
+			GLboolean enabled = getSeverityRank(severity) >= minimum ? GL_TRUE : GL_FALSE;
+			s_debugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severity, 0, nullptr, enabled);
+		}
+
+		// performance hints are often reported as low/notification, they are the point of this
+		s_debugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PERFORMANCE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+	}
+
+	// every message goes to the flight recorder, release builds included; the console only exists in debug builds
+	void report(hyp::LOG_TYPE level, const char* line) {
+		hyp::recordLogLine(level, line);
+	#if defined(HYPER_DEBUG)
+		hyp::print_line(level, line);
+	#endif
+	}
+
+	void APIENTRY onDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam) {
+		if (type == GL_DEBUG_TYPE_PUSH_GROUP || type == GL_DEBUG_TYPE_POP_GROUP || type == GL_DEBUG_TYPE_MARKER) return;
+		if (std::find(s_ignored.begin(), s_ignored.end(), id) != s_ignored.end()) return;
+
+		std::string_view text = length >= 0 ? std::string_view(message, (size_t)length) : std::string_view(message);
+		while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.remove_suffix(1);
+
+		static hyp::Counter& messages = hyp::Metrics::counter("gl.debug_messages");
+		messages.add();
+
+		bool performance = type == GL_DEBUG_TYPE_PERFORMANCE;
+		if (performance)
+		{
+			static hyp::Counter& warnings = hyp::Metrics::counter("gl.performance_warnings");
+			warnings.add();
+			s_framePerformance++;
+			s_totalPerformance++;
+		}
+
+		unsigned long long frame = (unsigned long long)hyp::FlightRecorder::getFrameIndex();
+		const char* tag = s_tag ? s_tag : "-";
+
+		if (performance && s_failOnPerformance.load(std::memory_order_relaxed))
+		{
+			char line[1024];
+			std::snprintf(line, sizeof(line), "GL performance warning #%u (frame %llu, %s): %.*s", id, frame, tag, (int)text.size(), text.data());
+			report(hyp::LOG_TYPE::FATAL, line);
+
+			// release builds have no console, the trace carries the message and the frames before it
+			hyp::FlightRecorder::dump(hyp::FlightRecorder::getDumpDirectory() / "gl_performance_warning.json");
+			std::terminate();
+		}
+
+		if (s_seen.size() >= MaxSeen) s_seen.clear();
+		uint32_t count = ++s_seen[getMessageKey(source, type, id, text)];
+		if (!shouldLog(count)) return;
+
+		char repeats[32] = "";
+		if (count > 1) std::snprintf(repeats, sizeof(repeats), " [x%u]", count);
+
+		hyp::LOG_TYPE level = hyp::LOG_TYPE::INFO;
+		if (type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH)
+			level = hyp::LOG_TYPE::H_ERROR;
+		else if (performance || severity == GL_DEBUG_SEVERITY_MEDIUM)
+			level = hyp::LOG_TYPE::WARN;
+
+		char line[1024];
+		std::snprintf(line, sizeof(line), "GL %s %s #%u (frame %llu, %s)%s: %.*s", getSourceName(source), getTypeName(type), id, frame, tag, repeats, (int)text.size(), text.data());
+		report(level, line);
+	}
+}
+
+bool hyp::OpenglDebugOutput::install() {
+	s_installed = false;
+
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+	{
+		HYP_INFO("GL debug output: off (not a debug context)");
+		return false;
+	}
+
+	DebugMessageCallbackFn debugMessageCallback = nullptr;
+	s_khrDebug = glfwExtensionSupported("GL_KHR_debug");
+	if (s_khrDebug)
+	{
+		// KHR_debug entry points carry no suffix on desktop GL
+		debugMessageCallback = (DebugMessageCallbackFn)glfwGetProcAddress("glDebugMessageCallback");
+		s_debugMessageControl = (DebugMessageControlFn)glfwGetProcAddress("glDebugMessageControl");
+	}
+	else if (glfwExtensionSupported("GL_ARB_debug_output"))
+	{
+		debugMessageCallback = (DebugMessageCallbackFn)glfwGetProcAddress("glDebugMessageCallbackARB");
+		s_debugMessageControl = (DebugMessageControlFn)glfwGetProcAddress("glDebugMessageControlARB");
+	}
+
+	if (!debugMessageCallback)
+	{
+		HYP_WARN("GL debug output: unavailable (no KHR_debug or ARB_debug_output)");
+		return false;
+	}
+
+	if (s_khrDebug) glEnable(GL_DEBUG_OUTPUT);
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	debugMessageCallback(onDebugMessage, nullptr);
+	applyFilter();
+
+	s_installed = true;
+	HYP_INFO("GL debug output: on (%s)", s_khrDebug ? "KHR_debug" : "ARB_debug_output");
+	return true;
+}
+
+bool hyp::OpenglDebugOutput::isInstalled() {
+	return s_installed;
+}
+
+void hyp::OpenglDebugOutput::setMinimumSeverity(GLenum severity) {
+	s_minimumSeverity = severity;
+	applyFilter();
+}
+
+void hyp::OpenglDebugOutput::ignore(GLuint id) {
+	if (std::find(s_ignored.begin(), s_ignored.end(), id) == s_ignored.end()) s_ignored.push_back(id);
+}
+
+void hyp::OpenglDebugOutput::setFailOnPerformanceWarning(bool value) {
+	s_failOnPerformance.store(value, std::memory_order_relaxed);
+}
+
+bool hyp::OpenglDebugOutput::isFailOnPerformanceWarning() {
+	return s_failOnPerformance.load(std::memory_order_relaxed);
+}
+
+void hyp::OpenglDebugOutput::newFrame() {
+	s_lastFramePerformance = s_framePerformance;
+	s_framePerformance = 0;
+
+	if (s_installed) hyp::FlightRecorder::recordCounter("gl.performance_warnings", (double)s_lastFramePerformance);
+}
+
+uint32_t hyp::OpenglDebugOutput::getFramePerformanceWarnings() {
+	return s_lastFramePerformance;
+}
+
+uint64_t hyp::OpenglDebugOutput::getTotalPerformanceWarnings() {
+	return s_totalPerformance;
+}
+
+const char* hyp::OpenglDebugOutput::setTag(const char* tag) {
+	const char* previous = s_tag;
+	s_tag = tag;
+	return previous;
+}
+
+const char* hyp::OpenglDebugOutput::getTag() {
+	return s_tag;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#ifndef HYPER_GL_DEBUG_OUTPUT_HPP
+	#define HYPER_GL_DEBUG_OUTPUT_HPP
+
+	#include <glad/glad.h>
+	#include <cstdint>
+
+	// KHR_debug, the bundled glad loader is a 3.3 core profile without it
+	#ifndef GL_CONTEXT_FLAG_DEBUG_BIT
+		#define GL_CONTEXT_FLAG_DEBUG_BIT 0x00000002
+	#endif
+	#ifndef GL_DEBUG_OUTPUT
+		#define GL_DEBUG_OUTPUT 0x92E0
+	#endif
+	#ifndef GL_DEBUG_OUTPUT_SYNCHRONOUS
+		#define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
+	#endif
+	#ifndef GL_DEBUG_SOURCE_API
+		#define GL_DEBUG_SOURCE_API 0x8246
+		#define GL_DEBUG_SOURCE_WINDOW_SYSTEM 0x8247
+		#define GL_DEBUG_SOURCE_SHADER_COMPILER 0x8248
+		#define GL_DEBUG_SOURCE_THIRD_PARTY 0x8249
+		#define GL_DEBUG_SOURCE_APPLICATION 0x824A
+		#define GL_DEBUG_SOURCE_OTHER 0x824B
+	#endif
+	#ifndef GL_DEBUG_TYPE_ERROR
+		#define GL_DEBUG_TYPE_ERROR 0x824C
+		#define GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR 0x824D
+		#define GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR 0x824E
+		#define GL_DEBUG_TYPE_PORTABILITY 0x824F
+		#define GL_DEBUG_TYPE_PERFORMANCE 0x8250
+		#define GL_DEBUG_TYPE_OTHER 0x8251
+	#endif
+	#ifndef GL_DEBUG_TYPE_MARKER
+		#define GL_DEBUG_TYPE_MARKER 0x8268
+		#define GL_DEBUG_TYPE_PUSH_GROUP 0x8269
+		#define GL_DEBUG_TYPE_POP_GROUP 0x826A
+	#endif
+	#ifndef GL_DEBUG_SEVERITY_HIGH
+		#define GL_DEBUG_SEVERITY_HIGH 0x9146
+		#define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+		#define GL_DEBUG_SEVERITY_LOW 0x9148
+	#endif
+	#ifndef GL_DEBUG_SEVERITY_NOTIFICATION
+		#define GL_DEBUG_SEVERITY_NOTIFICATION 0x826B
+	#endif
+
+namespace hyp {
+
+	/**
+	* \brief routes the driver's GL debug messages into the engine log (and so the FlightRecorder).
+	*
+	* Installed by the OpenglContext when the context was created with the debug flag
+	* (DeviceSetting::debugContext). Output is synchronous, so every message is tagged with
+	* the frame index and the innermost HYP_GL_DEBUG_TAG that was active when the driver
+	* raised it. Identical messages are logged once and then only at 10, 100, 1000... repeats.
+	*/
+	class OpenglDebugOutput {
+	public:
+		static bool install();
+		static bool isInstalled();
+
+		/**
+		* \brief messages below `severity` are dropped by the driver, GL_DEBUG_SEVERITY_LOW by default.
+		* Performance messages are kept at every severity.
+		*/
+		static void setMinimumSeverity(GLenum severity);
+		static void ignore(GLuint id);
+
+		/**
+		* \brief terminates on the first GL_DEBUG_TYPE_PERFORMANCE message, for benchmark runs; the
+		* flight recorder is dumped to gl_performance_warning.json in its dump directory first
+		*/
+		static void setFailOnPerformanceWarning(bool value);
+		static bool isFailOnPerformanceWarning();
+
+		/**
+		* \brief frame boundary, called by the Application
+		*/
+		static void newFrame();
+
+		// performance messages raised during the last completed frame
+		static uint32_t getFramePerformanceWarnings();
+		static uint64_t getTotalPerformanceWarnings();
+
+		// `tag` must outlive the message (string literal)
+		static const char* setTag(const char* tag);
+		static const char* getTag();
+	};
+
+	class OpenglDebugTag {
+	public:
+		OpenglDebugTag(const char* tag) : m_previous(OpenglDebugOutput::setTag(tag)) {}
+		~OpenglDebugTag() { OpenglDebugOutput::setTag(m_previous); }
+
+		OpenglDebugTag(const OpenglDebugTag&) = delete;
+		OpenglDebugTag& operator=(const OpenglDebugTag&) = delete;
+
+	private:
+		const char* m_previous;
+	};
+}
+
+	#define HYP_GL_DEBUG_CONCAT_IMPL(a, b) a##b
+	#define HYP_GL_DEBUG_CONCAT(a, b) HYP_GL_DEBUG_CONCAT_IMPL(a, b)
+	#define HYP_GL_DEBUG_TAG(tag) hyp::OpenglDebugTag HYP_GL_DEBUG_CONCAT(hypGlDebugTag, __LINE__)(tag)
+
+#endif // !HYPER_GL_DEBUG_OUTPUT_HPP
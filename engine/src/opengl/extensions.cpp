@@ -0,0 +1,36 @@
+#include "extensions.hpp"
+#include <GLFW/glfw3.h>
+#include <utils/logger.hpp>
+
+namespace {
+	using MaxShaderCompilerThreadsFn = void(APIENTRYP)(GLuint count);
+
+	bool s_parallelShaderCompile = false;
+}
+
+void hyp::OpenglExtensions::load() {
+	s_parallelShaderCompile = false;
+
+	MaxShaderCompilerThreadsFn maxShaderCompilerThreads = nullptr;
+	if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+	{
+		maxShaderCompilerThreads = (MaxShaderCompilerThreadsFn)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+	}
+	else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+	{
+		maxShaderCompilerThreads = (MaxShaderCompilerThreadsFn)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+	}
+
+	if (maxShaderCompilerThreads)
+	{
+		// let the driver pick the thread count
+		maxShaderCompilerThreads(0xFFFFFFFF);
+		s_parallelShaderCompile = true;
+	}
+
+	HYP_INFO("Parallel shader compile: %s", s_parallelShaderCompile ? "available" : "unavailable");
+}
+
+bool hyp::OpenglExtensions::hasParallelShaderCompile() {
+	return s_parallelShaderCompile;
+}
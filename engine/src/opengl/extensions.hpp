@@ -0,0 +1,32 @@
+#pragma once
+#ifndef HYPER_GL_EXTENSIONS_HPP
+	#define HYPER_GL_EXTENSIONS_HPP
+
+	#include <glad/glad.h>
+
+	// KHR_parallel_shader_compile (and its ARB twin), the bundled glad loader predates it
+	#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+		#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+	#endif
+	#ifndef GL_COMPLETION_STATUS_KHR
+		#define GL_COMPLETION_STATUS_KHR 0x91B1
+	#endif
+
+namespace hyp {
+
+	/**
+	* \brief GL extensions the engine uses on top of the glad core profile, loaded by the OpenglContext
+	*/
+	class OpenglExtensions {
+	public:
+		static void load();
+
+		/**
+		* \brief when true, compiles and links run on driver threads and GL_COMPLETION_STATUS_KHR
+		* can be polled without stalling
+		*/
+		static bool hasParallelShaderCompile();
+	};
+}
+
+#endif // !HYPER_GL_EXTENSIONS_HPP
@@ -0,0 +1,54 @@
+#include "gpu_timer.hpp"
+#include <glad/glad.h>
+
+hyp::GpuTimer::~GpuTimer() {
+	if (m_queries[0])
+	{
+		glDeleteQueries(QueryCount, m_queries);
+	}
+}
+
+void hyp::GpuTimer::begin() {
+	if (!m_queries[0])
+	{
+		glGenQueries(QueryCount, m_queries);
+	}
+
+	// the slot is still in flight, skip this frame rather than stall on it
+	if (m_pending[m_current] && !collect(m_current))
+	{
+		m_active = false;
+		return;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, m_queries[m_current]);
+	m_active = true;
+}
+
+void hyp::GpuTimer::end() {
+	if (!m_active) return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_pending[m_current] = true;
+	m_active = false;
+	m_current = (m_current + 1) % QueryCount;
+
+	// pick up whatever finished since, oldest first
+	for (uint32_t i = 0; i < QueryCount; i++)
+	{
+		uint32_t index = (m_current + i) % QueryCount;
+		if (m_pending[index] && !collect(index)) break;
+	}
+}
+
+bool hyp::GpuTimer::collect(uint32_t index) {
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(m_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) return false;
+
+	GLuint64 elapsed = 0;
+	glGetQueryObjectui64v(m_queries[index], GL_QUERY_RESULT, &elapsed);
+	m_lastMs = (float)(elapsed / 1e6);
+	m_pending[index] = false;
+	return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef HYPER_GPU_TIMER_HPP
+	#define HYPER_GPU_TIMER_HPP
+
+	#include <cstdint>
+
+namespace hyp {
+
+	/**
+	* \brief measures the GPU time between `begin` and `end` with GL_TIME_ELAPSED queries.
+	*
+	* Results are read a few frames later from a ring of queries, so the CPU never waits on
+	* the GPU; a frame is skipped when the driver is further behind than the ring is deep.
+	* GL_TIME_ELAPSED queries can't nest, keep a single timer active at a time.
+	*/
+	class GpuTimer {
+	public:
+		static constexpr uint32_t QueryCount = 4;
+
+		GpuTimer() = default;
+		~GpuTimer();
+
+		GpuTimer(const GpuTimer&) = delete;
+		GpuTimer& operator=(const GpuTimer&) = delete;
+
+		void begin();
+		void end();
+
+		/** \brief the latest result available, negative until the first one arrives */
+		float getLastMs() const { return m_lastMs; }
+
+	private:
+		bool collect(uint32_t index);
+
+	private:
+		uint32_t m_queries[QueryCount] = {};
+		bool m_pending[QueryCount] = {};
+		uint32_t m_current = 0;
+		bool m_active = false;
+		float m_lastMs = -1.f;
+	};
+}
+
+#endif // !HYPER_GPU_TIMER_HPP
@@ -1,18 +1,20 @@
 #include "element_buffer.hpp"
+#include <debug/memory_tracker.hpp>
 
 hyp::ElementBuffer::ElementBuffer(uint32_t* indices, uint32_t count)
     : m_count(count) {
-	glGenBuffers(1, &m_rendererId);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererId);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+	m_range = hyp::GpuMemory::allocate(hyp::GpuBufferKind::Index, count * sizeof(uint32_t));
+	hyp::GpuMemory::upload(m_range, indices, count * sizeof(uint32_t));
+	hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::ElementBuffer, count * sizeof(uint32_t));
 }
 
 hyp::ElementBuffer::~ElementBuffer() {
-	glDeleteBuffers(1, &m_rendererId);
+	hyp::GpuMemory::release(m_range);
+	hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::ElementBuffer, m_count * sizeof(uint32_t));
 }
 
 void hyp::ElementBuffer::bind() {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererId);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_range.buffer);
 }
 
 void hyp::ElementBuffer::unbind() {
@@ -3,6 +3,7 @@
 
 #include <glad/glad.h>
 #include <cstdint>
+#include <renderer/gpu_memory.hpp>
 
 namespace hyp {
 	class ElementBuffer {
@@ -14,9 +15,11 @@ namespace hyp {
 		void unbind();
 
 		uint32_t getCount() const { return m_count; }
+		// byte offset of the first index in the shared GL buffer, passed to the draw calls
+		uint32_t getOffset() const { return m_range.offset; }
 
 	private:
-		uint32_t m_rendererId;
+		hyp::GpuRange m_range;
 		uint32_t m_count;
 	};
 
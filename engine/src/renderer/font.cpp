@@ -1,4 +1,8 @@
 #include "font.hpp"
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <io/file_system.hpp>
+#include <renderer/resources.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -10,34 +14,58 @@ hyp::Ref<hyp::Font> hyp::Font::create(const fs::path& fontFilePath) {
 }
 
 hyp::Ref<hyp::Font> hyp::Font::getDefault() {
-	static hyp::Ref<hyp::Font> s_fontDefault;
+	// shares the Resources copy, which picks up a font preloaded during startup
+	return hyp::Resources::getFonts().getRef(hyp::Resources::getDefaultFont());
+}
 
-	if (s_fontDefault)
-	{
-		return s_fontDefault;
-	}
+hyp::Font::Font(const fs::path& fontFilePath) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+	HYP_PROFILE_ASSET(fontFilePath.string());
+
+	FontAtlas atlas;
+	bool rasterized = rasterize(fontFilePath, atlas);
+	HYP_ASSERT_CORE(rasterized, "Couldn't load font");
+	if (!rasterized) return;
 
-	s_fontDefault = hyp::Font::create("assets/fonts/CascadiaCode.ttf");
-	HYP_INFO("Loaded engine's default font");
-	return s_fontDefault;
+	m_fontGeometry = atlas.geometry;
+	upload(atlas);
 }
 
-hyp::Font::Font(const fs::path& fontFilePath) {
+hyp::Font::Font(const FontAtlas& atlas) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+	HYP_ASSERT_CORE(atlas.isValid(), "Font atlas is empty");
+
+	m_fontGeometry = atlas.geometry;
+	upload(atlas);
+}
+
+bool hyp::Font::rasterize(const fs::path& fontFilePath, FontAtlas& atlas) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+
 	const int textureWidth = 512;
 	const int textureHeight = 512;
-	char* textureBuffer = new char[textureWidth * textureHeight];
-	m_fontGeometry = hyp::CreateRef<hyp::FontGeometry>();
+	auto textureBuffer = std::make_unique<char[]>(textureWidth * textureHeight);
+	auto fontGeometry = hyp::CreateRef<hyp::FontGeometry>();
 
 	FT_Library ft;
 
 	// initialize FreeType library
-	HYP_ASSERT_CORE(FT_Init_FreeType(&ft) == 0, "Couldn't initialize FreeType library");
+	if (FT_Init_FreeType(&ft) != 0)
+	{
+		HYP_ERROR("Couldn't initialize FreeType library");
+		return false;
+	}
 
-	HYP_ASSERT_CORE(fs::exists(fontFilePath), "Font file does not exists");
+	// FreeType reads from this memory until the face is done, keep it alive until then
+	hyp::FileData fontFile = hyp::FileSystem::read(fontFilePath.generic_string());
 
 	FT_Face fontFace;
-	HYP_ASSERT_CORE(FT_New_Face(ft, fontFilePath.string().c_str(), 0, &fontFace) == 0,
-	    "Couldn't load font");
+	if (!fontFile.isValid() || FT_New_Memory_Face(ft, fontFile.data(), (FT_Long)fontFile.size(), 0, &fontFace) != 0)
+	{
+		HYP_ERROR("Couldn't load font %s", fontFilePath.string().c_str());
+		FT_Done_FreeType(ft);
+		return false;
+	}
 
 	FT_Set_Pixel_Sizes(fontFace, 0, s_fontSize);
 
@@ -53,7 +81,7 @@ hyp::Font::Font(const fs::path& fontFilePath) {
 	int descent = -metrics.descender >> 6;
 	metrics.lineHeight = ascent + descent;
 
-	m_fontGeometry->metrics = metrics;
+	fontGeometry->metrics = metrics;
 
 	// iterate through ASCII characters from 32 to 127
 	for (int ch = 32; ch < 128; ch++)
@@ -94,7 +122,7 @@ hyp::Font::Font(const fs::path& fontFilePath) {
 		glyph.offset = { g->bitmap_left, g->bitmap_top };
 		glyph.uvCoords = { col, row };
 
-		m_fontGeometry->glyphs[ch] = glyph;
+		fontGeometry->glyphs[ch] = glyph;
 		// Update column position for next character
 		col += bitmap.width + padding;
 	}
@@ -103,18 +131,22 @@ hyp::Font::Font(const fs::path& fontFilePath) {
 	FT_Done_Face(fontFace);
 	FT_Done_FreeType(ft);
 
-	// create and populate texture with the texture buffer data
-	{
-		hyp::TextureSpecification texSpec;
-		texSpec.format = hyp::TextureFormat::RED;
-		texSpec.width = textureWidth;
-		texSpec.height = textureHeight;
-		texSpec.mipmap = false;
-		m_texture = hyp::Texture2D::create(texSpec);
-		m_texture->setData(textureBuffer, textureWidth * textureHeight);
-	}
+	atlas.geometry = fontGeometry;
+	atlas.width = textureWidth;
+	atlas.height = textureHeight;
+	atlas.pixels = std::move(textureBuffer);
+	return true;
+}
 
-	delete[] textureBuffer;
+void hyp::Font::upload(const FontAtlas& atlas) {
+	// create and populate texture with the texture buffer data
+	hyp::TextureSpecification texSpec;
+	texSpec.format = hyp::TextureFormat::RED;
+	texSpec.width = atlas.width;
+	texSpec.height = atlas.height;
+	texSpec.mipmap = false;
+	m_texture = hyp::Texture2D::create(texSpec);
+	m_texture->setData(atlas.pixels.get(), atlas.width * atlas.height);
 }
 
 void hyp::Glyph::getQuadAtlasBounds(glm::vec2& min, glm::vec2& max) const {
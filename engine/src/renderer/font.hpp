@@ -49,15 +49,37 @@ namespace hyp {
 		std::map<char, Glyph> glyphs;
 	};
 
+	/**
+	* \brief a rasterized glyph atlas, not yet uploaded.
+	* Rasterizing touches no GL state, so it may run on any thread.
+	*/
+	struct FontAtlas
+	{
+		hyp::Ref<hyp::FontGeometry> geometry;
+		int width = 0;
+		int height = 0;
+		hyp::Unique<char[]> pixels;
+
+		bool isValid() const { return pixels != nullptr; }
+	};
+
 	class Font {
 	public:
+		static constexpr const char* DefaultPath = "assets/fonts/CascadiaCode.ttf";
+
 		Font(const fs::path& fontFilePath);
+		Font(const FontAtlas& atlas);
+
+		static bool rasterize(const fs::path& fontFilePath, FontAtlas& atlas);
 
-		hyp::Ref<hyp::Texture2D> getAtlasTexture() const { return m_texture; }
-		hyp::Ref<hyp::FontGeometry> getFontData() const { return m_fontGeometry; }
+		const hyp::Ref<hyp::Texture2D>& getAtlasTexture() const { return m_texture; }
+		const hyp::Ref<hyp::FontGeometry>& getFontData() const { return m_fontGeometry; }
 
 		static hyp::Ref<hyp::Font> getDefault();
 		static hyp::Ref<hyp::Font> create(const fs::path& fontFilePath);
+	private:
+		void upload(const FontAtlas& atlas);
+
 	private:
 		// for caching text rendering information
 		hyp::Ref<hyp::FontGeometry> m_fontGeometry;
@@ -1,4 +1,5 @@
 #include "renderer/framebuffer.hpp"
+#include <debug/memory_tracker.hpp>
 
 namespace utils {
 	void attachColorTexture(uint32_t texture, uint32_t width, uint32_t height, GLenum internalFormat, GLenum format, int index);
@@ -16,6 +17,11 @@ hyp::Framebuffer::Framebuffer(const hyp::FramebufferSpecification& spec) : m_spe
 hyp::Framebuffer::~Framebuffer() {
 	glDeleteFramebuffers(1, &m_fbo);
 	glDeleteTextures(m_colorAttachments.size(), m_colorAttachments.data());
+
+	if (m_gpuSize)
+	{
+		hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::Framebuffer, m_gpuSize);
+	}
 }
 
 void hyp::Framebuffer::bind() {
@@ -32,6 +38,22 @@ uint32_t hyp::Framebuffer::getColorAttachmentId(uint32_t index) {
 	return m_colorAttachments[index];
 }
 
+void hyp::Framebuffer::setColorTexture(const hyp::Ref<hyp::Texture2D>& texture) {
+	m_colorTexture = texture;
+	m_spec.width = texture->getWidth();
+	m_spec.height = texture->getHeight();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->getTextureId(), 0);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		HYP_WARN("Framebuffer is not complete!");
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 void hyp::Framebuffer::resize(uint32_t width, uint32_t height) {
 	if (width == 0 || height == 0 || width > hyp::MaxFramebufferSize || height > hyp::MaxFramebufferSize)
 	{
@@ -50,6 +72,9 @@ void hyp::Framebuffer::reset() {
 		glDeleteFramebuffers(1, &m_fbo);
 		glDeleteTextures(m_colorAttachments.size(), m_colorAttachments.data());
 		m_colorAttachments.clear();
+
+		hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::Framebuffer, m_gpuSize);
+		m_gpuSize = 0;
 	}
 
 	glGenFramebuffers(1, &m_fbo);
@@ -81,7 +106,12 @@ void hyp::Framebuffer::reset() {
 		}
 	}
 
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	// every attachment is an RGBA8 texture
+	m_gpuSize = (size_t)m_spec.width * m_spec.height * 4 * m_colorAttachments.size();
+	hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::Framebuffer, m_gpuSize);
+
+	// without attachments, it is completed by setColorTexture
+	if (m_colorAttachments.size() && glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 	{
 		HYP_WARN("Framebuffer is not complete!");
 	}
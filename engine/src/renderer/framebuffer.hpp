@@ -5,6 +5,7 @@
 	#define HYP_FRAMEBUFFER_HPP
 	#include <cstdint>
 	#include <core/application.hpp>
+	#include <renderer/texture.hpp>
 	#include <vector>
 
 namespace hyp {
@@ -53,6 +54,12 @@ namespace hyp {
 
 		uint32_t getColorAttachmentId(uint32_t index = 0);
 
+		/**
+		* \brief renders into `texture` (attachment 0) instead of the attachments of the specification,
+		* the framebuffer takes the size of the texture
+		*/
+		void setColorTexture(const hyp::Ref<hyp::Texture2D>& texture);
+
 		void resize(uint32_t width, uint32_t height);
 
 		void reset();
@@ -67,6 +74,8 @@ namespace hyp {
 
 		std::vector<FbTextureSpecification> m_colorAttachmentSpecs;
 		std::vector<unsigned int> m_colorAttachments;
+		hyp::Ref<hyp::Texture2D> m_colorTexture;
+		size_t m_gpuSize = 0;
 	};
 
 }
@@ -0,0 +1,283 @@
+#include "gpu_memory.hpp"
+#include <glad/glad.h>
+#include <core/base.hpp>
+#include <debug/metrics.hpp>
+#include <utils/assert.hpp>
+#include <utils/logger.hpp>
+#include <array>
+#include <vector>
+
+namespace {
+	struct Arena
+	{
+		uint32_t buffer = 0;
+		hyp::RangeAllocator allocator;
+		uint32_t ranges = 0;
+		bool dedicated = false;
+		bool streaming = false;
+
+		Arena(uint32_t capacity) : allocator(capacity) {}
+	};
+
+	struct Pool
+	{
+		uint32_t arenaSize;
+		uint32_t alignment;
+		// released arenas leave a null slot, so the indices in GpuRange stay stable
+		std::vector<hyp::Scope<Arena>> arenas;
+	};
+
+	std::array<Pool, static_cast<size_t>(hyp::GpuBufferKind::Count)> s_pools = { {
+	    { 4 * 1024 * 1024, 16 },  // Vertex
+	    { 1024 * 1024, 4 },       // Index
+	    { 256 * 1024, 0 },        // Uniform, GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT once queried
+	} };
+
+	uint32_t alignUp(uint32_t value, uint32_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	void updateMetrics() {
+		static hyp::Gauge& s_arenas = hyp::Metrics::gauge("gpu.buffer_arenas");
+		static hyp::Gauge& s_reserved = hyp::Metrics::gauge("gpu.buffer_reserved_bytes");
+
+		uint32_t arenas = 0;
+		uint64_t reserved = 0;
+		for (const Pool& pool : s_pools)
+		{
+			for (const auto& arena : pool.arenas)
+			{
+				if (!arena) continue;
+				arenas++;
+				reserved += arena->allocator.getCapacity();
+			}
+		}
+
+		s_arenas.set((double)arenas);
+		s_reserved.set((double)reserved);
+	}
+
+	uint32_t createArena(Pool& pool, uint32_t capacity, bool dedicated, bool streaming = false) {
+		auto arena = hyp::CreateScope<Arena>(capacity);
+		arena->dedicated = dedicated || streaming;
+		arena->streaming = streaming;
+
+		glGenBuffers(1, &arena->buffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, arena->buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, streaming ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		for (uint32_t i = 0; i < pool.arenas.size(); i++)
+		{
+			if (!pool.arenas[i])
+			{
+				pool.arenas[i] = std::move(arena);
+				return i;
+			}
+		}
+
+		pool.arenas.push_back(std::move(arena));
+		return (uint32_t)pool.arenas.size() - 1;
+	}
+}
+
+hyp::RangeAllocator::RangeAllocator(uint32_t capacity)
+    : m_capacity(capacity) {
+	addFree(0, capacity);
+}
+
+void hyp::RangeAllocator::addFree(uint32_t offset, uint32_t size) {
+	if (size == 0) return;
+	m_free.emplace(offset, size);
+	m_freeSizes.emplace(size, offset);
+}
+
+void hyp::RangeAllocator::removeFree(std::map<uint32_t, uint32_t>::iterator block) {
+	auto [first, last] = m_freeSizes.equal_range(block->second);
+	for (auto it = first; it != last; ++it)
+	{
+		if (it->second == block->first)
+		{
+			m_freeSizes.erase(it);
+			break;
+		}
+	}
+
+	m_free.erase(block);
+}
+
+bool hyp::RangeAllocator::allocate(uint32_t size, uint32_t alignment, uint32_t& offset) {
+	if (size == 0) return false;
+	alignment = std::max(alignment, 1u);
+
+	// smallest block first; one of at least size + alignment - 1 always fits, so the scan stays short
+	for (auto it = m_freeSizes.lower_bound(size); it != m_freeSizes.end(); ++it)
+	{
+		uint32_t blockOffset = it->second;
+		uint32_t blockSize = it->first;
+		uint32_t aligned = alignUp(blockOffset, alignment);
+		if (aligned - blockOffset + (uint64_t)size > blockSize) continue;
+
+		removeFree(m_free.find(blockOffset));
+		addFree(blockOffset, aligned - blockOffset);
+		addFree(aligned + size, blockOffset + blockSize - (aligned + size));
+
+		offset = aligned;
+		m_used += size;
+		return true;
+	}
+
+	return false;
+}
+
+void hyp::RangeAllocator::release(uint32_t offset, uint32_t size) {
+	HYP_ASSERT_CORE(m_used >= size, "releasing more than was allocated");
+	m_used -= size;
+
+	// merge with the free neighbours
+	auto next = m_free.lower_bound(offset);
+	if (next != m_free.end() && next->first == offset + size)
+	{
+		size += next->second;
+		removeFree(next);
+	}
+
+	auto previous = m_free.lower_bound(offset);
+	if (previous != m_free.begin())
+	{
+		--previous;
+		if (previous->first + previous->second == offset)
+		{
+			offset = previous->first;
+			size += previous->second;
+			removeFree(previous);
+		}
+	}
+
+	addFree(offset, size);
+}
+
+hyp::GpuRange hyp::GpuMemory::allocate(GpuBufferKind kind, uint32_t size, GpuBufferUsage usage) {
+	Pool& pool = s_pools[static_cast<size_t>(kind)];
+	if (pool.alignment == 0)
+	{
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		pool.alignment = (uint32_t)std::max(alignment, 1);
+	}
+
+	GpuRange range;
+	range.kind = kind;
+	range.usage = usage;
+	range.size = size;
+	if (size == 0) return range;
+
+	uint32_t arenaIndex = UINT32_MAX;
+	if (usage == GpuBufferUsage::Stream)
+	{
+		arenaIndex = createArena(pool, size, true, true);
+		pool.arenas[arenaIndex]->allocator.allocate(size, 1, range.offset);
+	}
+	else if (size > pool.arenaSize / 2)
+	{
+		arenaIndex = createArena(pool, size, true);
+		pool.arenas[arenaIndex]->allocator.allocate(size, 1, range.offset);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < pool.arenas.size(); i++)
+		{
+			Arena* arena = pool.arenas[i].get();
+			if (arena && !arena->dedicated && arena->allocator.allocate(size, pool.alignment, range.offset))
+			{
+				arenaIndex = i;
+				break;
+			}
+		}
+
+		if (arenaIndex == UINT32_MAX)
+		{
+			arenaIndex = createArena(pool, pool.arenaSize, false);
+			pool.arenas[arenaIndex]->allocator.allocate(size, pool.alignment, range.offset);
+		}
+	}
+
+	Arena& arena = *pool.arenas[arenaIndex];
+	arena.ranges++;
+	range.buffer = arena.buffer;
+	range.arena = arenaIndex;
+
+	updateMetrics();
+	return range;
+}
+
+void hyp::GpuMemory::release(GpuRange& range) {
+	if (!range.isValid()) return;
+
+	Pool& pool = s_pools[static_cast<size_t>(range.kind)];
+	// after shutdown, or an arena recreated since
+	if (range.arena >= pool.arenas.size() || !pool.arenas[range.arena] || pool.arenas[range.arena]->buffer != range.buffer)
+	{
+		range = {};
+		return;
+	}
+
+	auto& arena = pool.arenas[range.arena];
+	arena->allocator.release(range.offset, range.size);
+	arena->ranges--;
+
+	if (arena->dedicated && arena->ranges == 0)
+	{
+		glDeleteBuffers(1, &arena->buffer);
+		arena.reset();
+	}
+
+	range = {};
+	updateMetrics();
+}
+
+void hyp::GpuMemory::upload(const GpuRange& range, const void* data, uint32_t size, uint32_t offset) {
+	HYP_ASSERT_CORE(offset + size <= range.size, "upload out of the range");
+	if (!range.isValid() || size == 0) return;
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, range.buffer);
+	// a new batch replaces the whole buffer: fresh storage, the driver keeps the old one for the draws in flight
+	if (range.usage == GpuBufferUsage::Stream && offset == 0)
+	{
+		glBufferData(GL_COPY_WRITE_BUFFER, range.size, nullptr, GL_STREAM_DRAW);
+	}
+	glBufferSubData(GL_COPY_WRITE_BUFFER, range.offset + offset, size, data);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	hyp::Metrics::recordGpuUpload(size);
+}
+
+void hyp::GpuMemory::setArenaSize(GpuBufferKind kind, uint32_t size) {
+	s_pools[static_cast<size_t>(kind)].arenaSize = size;
+}
+
+hyp::GpuMemory::Stats hyp::GpuMemory::getStats(GpuBufferKind kind) {
+	Stats stats;
+	for (const auto& arena : s_pools[static_cast<size_t>(kind)].arenas)
+	{
+		if (!arena) continue;
+		stats.arenas++;
+		stats.ranges += arena->ranges;
+		stats.reservedBytes += arena->allocator.getCapacity();
+		stats.usedBytes += arena->allocator.getUsed();
+	}
+
+	return stats;
+}
+
+void hyp::GpuMemory::shutdown() {
+	for (Pool& pool : s_pools)
+	{
+		for (auto& arena : pool.arenas)
+		{
+			if (arena) glDeleteBuffers(1, &arena->buffer);
+		}
+		pool.arenas.clear();
+	}
+
+	updateMetrics();
+}
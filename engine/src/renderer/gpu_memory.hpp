@@ -0,0 +1,105 @@
+#pragma once
+#ifndef HYP_GPU_MEMORY_HPP
+	#define HYP_GPU_MEMORY_HPP
+
+	#include <cstdint>
+	#include <map>
+
+namespace hyp {
+
+	enum class GpuBufferKind : uint8_t
+	{
+		Vertex = 0,
+		Index,
+		Uniform,
+		Count
+	};
+
+	enum class GpuBufferUsage : uint8_t
+	{
+		Static = 0, // written once or rarely, sub-allocated from a shared arena
+		Stream,     // rewritten every flush, gets a buffer of its own that is orphaned on each upload
+	};
+
+	/**
+	* \brief bytes [offset, offset + size) of a GL buffer shared with other ranges of the same kind
+	*/
+	struct GpuRange
+	{
+		uint32_t buffer = 0; // GL name
+		uint32_t offset = 0;
+		uint32_t size = 0;
+
+		GpuBufferKind kind = GpuBufferKind::Vertex;
+		GpuBufferUsage usage = GpuBufferUsage::Static;
+		uint32_t arena = 0;
+
+		bool isValid() const { return buffer != 0; }
+	};
+
+	/**
+	* \brief offset allocator over a fixed capacity: best fit over the free blocks, which are merged with
+	* their neighbours when released. Allocating and releasing are O(log n) in the number of free blocks.
+	*/
+	class RangeAllocator {
+	public:
+		RangeAllocator(uint32_t capacity);
+
+		bool allocate(uint32_t size, uint32_t alignment, uint32_t& offset);
+		void release(uint32_t offset, uint32_t size);
+
+		uint32_t getCapacity() const { return m_capacity; }
+		uint32_t getUsed() const { return m_used; }
+		size_t getFreeBlockCount() const { return m_free.size(); }
+
+	private:
+		void addFree(uint32_t offset, uint32_t size);
+		void removeFree(std::map<uint32_t, uint32_t>::iterator block);
+
+	private:
+		uint32_t m_capacity;
+		uint32_t m_used = 0;
+
+		std::map<uint32_t, uint32_t> m_free;          // offset -> size
+		std::multimap<uint32_t, uint32_t> m_freeSizes; // size -> offset
+	};
+
+	/**
+	* \brief hands out ranges of a few large GL buffers ("arenas") per kind instead of one GL object
+	* per vertex, index or uniform buffer.
+	*
+	* Requests larger than half an arena get an arena of their own, which is deleted once released.
+	* Streamed ranges always do: a full upload orphans their storage instead of writing into a buffer
+	* the GPU may still be reading, which would stall or copy a whole shared arena.
+	* Uploads go through GL_COPY_WRITE_BUFFER, so they never disturb the element buffer of the bound VAO.
+	*/
+	class GpuMemory {
+	public:
+		struct Stats
+		{
+			uint32_t arenas = 0;
+			uint32_t ranges = 0;
+			uint64_t reservedBytes = 0;
+			uint64_t usedBytes = 0;
+		};
+
+		static GpuRange allocate(GpuBufferKind kind, uint32_t size, GpuBufferUsage usage = GpuBufferUsage::Static);
+		static void release(GpuRange& range);
+
+		static void upload(const GpuRange& range, const void* data, uint32_t size, uint32_t offset = 0);
+
+		/**
+		* \brief size of the arenas created from now on, in bytes
+		*/
+		static void setArenaSize(GpuBufferKind kind, uint32_t size);
+
+		static Stats getStats(GpuBufferKind kind);
+
+		/**
+		* \brief deletes every arena, the ranges still alive become dangling (must run with the context current)
+		*/
+		static void shutdown();
+	};
+}
+
+#endif // !HYP_GPU_MEMORY_HPP
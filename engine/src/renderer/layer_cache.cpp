@@ -0,0 +1,98 @@
+#include "layer_cache.hpp"
+#include <renderer/renderer2d.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <debug/metrics.hpp>
+#include <algorithm>
+#include <cmath>
+
+hyp::LayerCache::LayerCache(const glm::vec2& min, const glm::vec2& max, float depth)
+    : m_min(min), m_max(max), m_depth(depth) {}
+
+hyp::LayerCache::~LayerCache() {}
+
+void hyp::LayerCache::setBounds(const glm::vec2& min, const glm::vec2& max, float depth) {
+	m_min = min;
+	m_max = max;
+	m_depth = depth;
+	m_valid = false;
+}
+
+float hyp::LayerCache::getPixelsPerUnit(const glm::mat4& viewProjection, uint32_t viewportHeight) {
+	// NDC units per world unit along the screen's y axis, NDC spans 2 units
+	float scale = glm::length(glm::vec2(viewProjection[0][1], viewProjection[1][1]));
+	return scale * (float)viewportHeight * 0.5f;
+}
+
+bool hyp::LayerCache::begin(float pixelsPerUnit) {
+	HYP_ASSERT_CORE(!m_recording, "LayerCache::begin called twice without end");
+	if (pixelsPerUnit <= 0.f) return false;
+
+	if (m_valid)
+	{
+		float ratio = pixelsPerUnit / m_pixelsPerUnit;
+		if (ratio <= 1.f + m_zoomThreshold && ratio >= 1.f / (1.f + m_zoomThreshold)) return false;
+	}
+
+	HYP_PROFILE_SCOPE("LayerCache::record");
+	glm::vec2 size = glm::max(m_max - m_min, glm::vec2(0.f)) * pixelsPerUnit;
+	float scale = std::min(1.f, (float)m_maxResolution / std::max(size.x, size.y));
+	uint32_t width = std::max(1u, (uint32_t)std::ceil(size.x * scale));
+	uint32_t height = std::max(1u, (uint32_t)std::ceil(size.y * scale));
+
+	if (!m_texture || m_texture->getWidth() != width || m_texture->getHeight() != height)
+	{
+		HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+		hyp::TextureSpecification spec;
+		spec.width = width;
+		spec.height = height;
+		spec.mipmap = false;
+		spec.repeat = false;
+
+		m_texture = hyp::Texture2D::create(spec);
+		m_framebuffer = hyp::Framebuffer::create({ width, height, {} });
+		m_framebuffer->setColorTexture(m_texture);
+	}
+
+	m_previousFramebuffer = hyp::RenderCommand::getBoundFramebuffer();
+	m_previousViewport = hyp::RenderCommand::getViewport();
+	m_previousBlendMode = hyp::Renderer2D::getBlendMode();
+
+	// draws what the scene submitted so far into the current target first
+	hyp::Renderer2D::pushViewProjection(glm::ortho(m_min.x, m_max.x, m_min.y, m_max.y, -1.f, 1.f));
+	hyp::Renderer2D::setBlendMode(hyp::BlendMode::Alpha);
+
+	m_framebuffer->bind();
+	hyp::RenderCommand::clear(glm::vec4(0.f));
+
+	m_pixelsPerUnit = pixelsPerUnit;
+	m_recording = true;
+	return true;
+}
+
+void hyp::LayerCache::end() {
+	HYP_ASSERT_CORE(m_recording, "LayerCache::end called without begin");
+
+	hyp::Renderer2D::popViewProjection();
+	hyp::Renderer2D::setBlendMode(m_previousBlendMode);
+
+	hyp::RenderCommand::bindFramebuffer(m_previousFramebuffer);
+	hyp::RenderCommand::setViewport(m_previousViewport.x, m_previousViewport.y, m_previousViewport.z, m_previousViewport.w);
+
+	m_recording = false;
+	m_valid = true;
+	m_recordCount++;
+
+	static hyp::Counter& s_records = hyp::Metrics::counter("renderer.layer_cache_records");
+	s_records.add();
+}
+
+void hyp::LayerCache::draw(const glm::vec2& offset, const glm::vec4& tint) {
+	if (!m_texture) return;
+
+	// the texture holds premultiplied colour, see BlendMode::Alpha
+	hyp::BlendMode previous = hyp::Renderer2D::getBlendMode();
+	hyp::Renderer2D::setBlendMode(hyp::BlendMode::Premultiplied);
+	hyp::Renderer2D::drawQuad(glm::vec3(m_min + offset, m_depth), m_max - m_min, m_texture, 1.f, glm::vec4(glm::vec3(tint) * tint.a, tint.a));
+	hyp::Renderer2D::setBlendMode(previous);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef HYP_LAYER_CACHE_HPP
+	#define HYP_LAYER_CACHE_HPP
+
+	#include <glm/glm.hpp>
+	#include <renderer/framebuffer.hpp>
+	#include <renderer/render_command.hpp>
+	#include <renderer/texture.hpp>
+
+namespace hyp {
+
+	/**
+	* \brief renders a static group of draw calls once into a texture and draws it as one quad afterwards.
+	*
+	* The group covers a world-space rectangle and is rasterized at the current pixels per world unit.
+	* It is only recorded again once invalidated, or when the zoom changed by more than the threshold
+	* since the last recording (the texture would be blurry or wasteful otherwise).
+	*
+	*	if (cache.begin(hyp::LayerCache::getPixelsPerUnit(viewProjection, viewportHeight)))
+	*	{
+	*		// Renderer2D calls, in world space
+	*		cache.end();
+	*	}
+	*	cache.draw();
+	*
+	* Must be used between Renderer2D::beginScene and endScene. The content is drawn in submission
+	* order (the target has no depth buffer) and the cached quad is drawn at the cache depth.
+	*/
+	class LayerCache {
+	public:
+		LayerCache(const glm::vec2& min, const glm::vec2& max, float depth = 0.f);
+		~LayerCache();
+
+		void setBounds(const glm::vec2& min, const glm::vec2& max, float depth = 0.f);
+
+		/**
+		* \brief relative change of the zoom that triggers a new recording, 0.25 by default
+		*/
+		void setZoomThreshold(float threshold) { m_zoomThreshold = threshold; }
+		// the texture is scaled down to fit, in pixels
+		void setMaxResolution(uint32_t resolution) { m_maxResolution = resolution; }
+
+		void invalidate() { m_valid = false; }
+		bool isValid() const { return m_valid; }
+
+		/**
+		* \brief returns true when the group has to be recorded; the Renderer2D calls that follow,
+		* until `end`, are then rendered into the cache
+		*/
+		bool begin(float pixelsPerUnit);
+		void end();
+
+		/**
+		* \brief draws the cached texture over the bounds, `offset` moves it (e.g. for parallax)
+		*/
+		void draw(const glm::vec2& offset = glm::vec2(0.f), const glm::vec4& tint = glm::vec4(1.f));
+
+		const hyp::Ref<hyp::Texture2D>& getTexture() const { return m_texture; }
+		// times the group was recorded
+		uint32_t getRecordCount() const { return m_recordCount; }
+
+		/**
+		* \brief screen pixels per world unit of an orthographic view-projection
+		*/
+		static float getPixelsPerUnit(const glm::mat4& viewProjection, uint32_t viewportHeight);
+
+	private:
+		glm::vec2 m_min;
+		glm::vec2 m_max;
+		float m_depth;
+
+		float m_zoomThreshold = 0.25f;
+		uint32_t m_maxResolution = 4096;
+
+		hyp::Ref<hyp::Texture2D> m_texture;
+		hyp::Ref<hyp::Framebuffer> m_framebuffer;
+		float m_pixelsPerUnit = 0.f; // of the recording
+		bool m_valid = false;
+		bool m_recording = false;
+		uint32_t m_recordCount = 0;
+
+		// restored by `end`
+		uint32_t m_previousFramebuffer = 0;
+		glm::uvec4 m_previousViewport { 0 };
+		hyp::BlendMode m_previousBlendMode = hyp::BlendMode::Alpha;
+	};
+}
+
+#endif // !HYP_LAYER_CACHE_HPP
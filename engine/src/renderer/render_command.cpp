@@ -2,7 +2,7 @@
 
 void hyp::RenderCommand::init() {
 	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	setBlendMode(BlendMode::Alpha);
 
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_LINE_SMOOTH);
@@ -20,14 +20,42 @@ void hyp::RenderCommand::clear() {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void hyp::RenderCommand::clear(const glm::vec4& color) {
+	glClearBufferfv(GL_COLOR, 0, &color[0]);
+	glClear(GL_DEPTH_BUFFER_BIT);
+}
+
 void hyp::RenderCommand::setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
 	glViewport(x, y, width, height);
 }
 
+glm::uvec4 hyp::RenderCommand::getViewport() {
+	GLint viewport[4] = {};
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	return glm::uvec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+uint32_t hyp::RenderCommand::getBoundFramebuffer() {
+	GLint framebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+	return (uint32_t)framebuffer;
+}
+
+void hyp::RenderCommand::bindFramebuffer(uint32_t framebuffer) {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
 void hyp::RenderCommand::drawIndexed(const hyp::Ref<hyp::VertexArray>& vao, uint32_t indexCount) {
 	vao->bind();
-	uint32_t count = indexCount ? indexCount : vao->getElementBuffer()->getCount();
-	glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+	const auto& elementBuffer = vao->getElementBuffer();
+	uint32_t count = indexCount ? indexCount : elementBuffer->getCount();
+	glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, (const void*)(uintptr_t)elementBuffer->getOffset());
+}
+
+void hyp::RenderCommand::drawIndexed(const hyp::Ref<hyp::VertexArray>& vao, uint32_t indexCount, uint32_t baseVertex) {
+	vao->bind();
+	const void* indices = (const void*)(uintptr_t)vao->getElementBuffer()->getOffset();
+	glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, indices, (GLint)baseVertex);
 }
 
 void hyp::RenderCommand::drawLines(const hyp::Ref<hyp::VertexArray>& vao, uint32_t vertexCount) {
@@ -38,3 +66,24 @@ void hyp::RenderCommand::drawLines(const hyp::Ref<hyp::VertexArray>& vao, uint32
 void hyp::RenderCommand::setLineWidth(float width) {
 	glLineWidth(width);
 }
+
+void hyp::RenderCommand::setBlendMode(BlendMode mode) {
+	switch (mode)
+	{
+	case BlendMode::Additive: glBlendFunc(GL_ONE, GL_ONE); break;
+	case BlendMode::Premultiplied: glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+	// the alpha is blended "over" too, so an offscreen target ends up with premultiplied colour and its coverage
+	default: glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+	}
+}
+
+void hyp::RenderCommand::setDepthTest(bool enabled) {
+	if (enabled)
+		glEnable(GL_DEPTH_TEST);
+	else
+		glDisable(GL_DEPTH_TEST);
+}
+
+void hyp::RenderCommand::setWireframe(bool enabled) {
+	glPolygonMode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
+}
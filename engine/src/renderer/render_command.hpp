@@ -6,6 +6,13 @@
 	#include <renderer/vertex_array.hpp>
 
 namespace hyp {
+	enum class BlendMode
+	{
+		Alpha, // straight alpha sources; the target alpha accumulates coverage
+		Additive,
+		Premultiplied // e.g. for textures rendered with Alpha into a transparent target
+	};
+
 	class RenderCommand {
 	public:
 		static void init();
@@ -13,12 +20,27 @@ namespace hyp {
 		static void setClearColor(const glm::vec4& color);
 		static void setClearColor(float r, float g, float b, float a);
 		static void clear();
+		/**
+		* \brief clears to `color` without changing the clear color
+		*/
+		static void clear(const glm::vec4& color);
 
 		static void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static glm::uvec4 getViewport();
+
+		// to restore the render target around offscreen passes
+		static uint32_t getBoundFramebuffer();
+		static void bindFramebuffer(uint32_t framebuffer);
 
 		static void drawIndexed(const hyp::Ref<hyp::VertexArray>& vao, uint32_t indexCount = 0);
+		// indices are offset by `baseVertex`, so one index buffer serves every range of a large vertex buffer
+		static void drawIndexed(const hyp::Ref<hyp::VertexArray>& vao, uint32_t indexCount, uint32_t baseVertex);
 		static void drawLines(const hyp::Ref<hyp::VertexArray>& vao, uint32_t vertexCount);
 		static void setLineWidth(float width);
+
+		static void setBlendMode(BlendMode mode);
+		static void setDepthTest(bool enabled);
+		static void setWireframe(bool enabled);
 	};
 }
 
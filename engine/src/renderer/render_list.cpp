@@ -0,0 +1,143 @@
+#define RENDERER_2D_DATA_STRUCTURES
+#include "render_list.hpp"
+#include <renderer/renderer2d.hpp>
+#include <debug/flight_recorder.hpp>
+
+namespace {
+	// the unit quad of Renderer2D, centred on the origin
+	const glm::vec4 s_corners[4] = {
+		{ +0.5f, +0.5f, 0.f, 1.f },
+		{ -0.5f, +0.5f, 0.f, 1.f },
+		{ -0.5f, -0.5f, 0.f, 1.f },
+		{ +0.5f, -0.5f, 0.f, 1.f },
+	};
+
+	const glm::vec2 s_uvs[4] = { { 1.f, 1.f }, { 0.f, 1.f }, { 0.f, 0.f }, { 1.f, 0.f } };
+}
+
+hyp::RenderList::RenderList() {}
+
+hyp::RenderList::~RenderList() {}
+
+void hyp::RenderList::begin() {
+	m_vertices.clear();
+	m_batches.clear();
+	m_quadCount = 0;
+}
+
+hyp::RenderList::Batch& hyp::RenderList::getBatch(hyp::Texture2D* texture, float& textureIndex) {
+	if (m_batches.empty() || m_batches.back().quadCount == MaxQuadsPerBatch)
+	{
+		m_batches.emplace_back().firstQuad = m_quadCount;
+	}
+
+	textureIndex = 0.f;
+	if (!texture) return m_batches.back();
+
+	Batch* batch = &m_batches.back();
+	for (uint32_t i = 1; i < batch->textureCount; i++)
+	{
+		if (batch->textures[i] == texture)
+		{
+			textureIndex = (float)i;
+			return *batch;
+		}
+	}
+
+	if (batch->textureCount == TextureSlots)
+	{
+		batch = &m_batches.emplace_back();
+		batch->firstQuad = m_quadCount;
+	}
+
+	batch->textures[batch->textureCount] = texture;
+	textureIndex = (float)batch->textureCount++;
+	return *batch;
+}
+
+void hyp::RenderList::pushQuad(const glm::vec3 (&corners)[4], hyp::Texture2D* texture, float tilingFactor, const glm::vec4& color) {
+	float textureIndex = 0.f;
+	Batch& batch = getBatch(texture, textureIndex);
+
+	if (batch.quadCount == 0)
+	{
+		batch.min = batch.max = glm::vec2(corners[0]);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		QuadVertex& vertex = m_vertices.emplace_back();
+		vertex.pos = corners[i];
+		vertex.color = color;
+		vertex.uv = s_uvs[i];
+		vertex.transformIndex = 0; // positions are already in world space
+		vertex.textureIndex = textureIndex;
+		vertex.tilingFactor = tilingFactor;
+
+		batch.min = glm::min(batch.min, glm::vec2(corners[i]));
+		batch.max = glm::max(batch.max, glm::vec2(corners[i]));
+	}
+
+	batch.quadCount++;
+	m_quadCount++;
+}
+
+void hyp::RenderList::addQuad(const glm::mat4& transform, const glm::vec4& color) {
+	addQuad(transform, hyp::TextureHandle(), 1.f, color);
+}
+
+void hyp::RenderList::addQuad(const glm::mat4& transform, hyp::TextureHandle texture, float tilingFactor, const glm::vec4& color) {
+	glm::vec3 corners[4];
+	for (int i = 0; i < 4; i++)
+	{
+		corners[i] = glm::vec3(transform * s_corners[i]);
+	}
+
+	// a stale handle falls back to the white texture, like Renderer2D::drawQuad
+	pushQuad(corners, hyp::Resources::getTexture(texture), tilingFactor, color);
+}
+
+void hyp::RenderList::addQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color) {
+	addQuad(position, size, hyp::TextureHandle(), 1.f, color);
+}
+
+void hyp::RenderList::addQuad(const glm::vec3& position, const glm::vec2& size, hyp::TextureHandle texture, float tilingFactor, const glm::vec4& color) {
+	// same placement as Renderer2D::drawQuad(position, size): `position` is the bottom-left corner
+	glm::vec3 corners[4] = {
+		position + glm::vec3(size.x, size.y, 0.f),
+		position + glm::vec3(0.f, size.y, 0.f),
+		position,
+		position + glm::vec3(size.x, 0.f, 0.f),
+	};
+
+	pushQuad(corners, hyp::Resources::getTexture(texture), tilingFactor, color);
+}
+
+void hyp::RenderList::end() {
+	HYP_PROFILE_SCOPE("RenderList::upload");
+	if (m_quadCount == 0) return;
+
+	if (m_quadCount > m_capacity)
+	{
+		HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+		m_capacity = std::max(m_quadCount, m_capacity * 2);
+		m_capacity = std::max(m_capacity, MaxQuadsPerBatch);
+
+		m_vao = hyp::VertexArray::create();
+		m_vbo = hyp::VertexBuffer::create(m_capacity * 4 * sizeof(QuadVertex));
+		m_vbo->setLayout({
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Vec3, "aPos", false),
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Vec4, "aColor", false),
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Vec2, "aUV", false),
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Int, "aTransformIndex", false),
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Float, "aTextureIndex", false),
+		    hyp::VertexAttribDescriptor(hyp::ShaderDataType::Float, "aTilingFactor", false),
+		});
+		m_vao->addVertexBuffer(m_vbo);
+
+		// one batch worth of indices, every batch is drawn with its own base vertex
+		m_vao->setIndexBuffer(hyp::Renderer2D::getQuadIndexBuffer());
+	}
+
+	m_vbo->setData(m_vertices.data(), (uint32_t)(m_vertices.size() * sizeof(QuadVertex)));
+}
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef HYP_RENDER_LIST_HPP
+	#define HYP_RENDER_LIST_HPP
+
+	#include <glm/glm.hpp>
+	#include <renderer/resources.hpp>
+	#include <renderer/vertex_array.hpp>
+	#include <array>
+	#include <vector>
+
+namespace hyp {
+	struct QuadVertex;
+
+	/**
+	* \brief quads extracted once per frame and uploaded into a persistent vertex buffer, so any number
+	* of views can draw them (Renderer2D::drawRenderList) without re-submitting.
+	*
+	* Vertices are stored in world space and split into batches of at most MaxQuadsPerBatch quads and
+	* TextureSlots textures, in submission order. Each view culls whole batches against its own
+	* view-projection, so an extra view costs draw calls, not CPU work per quad.
+	*
+	* Texture handles are resolved when added; the list is meant to be rebuilt every frame.
+	*/
+	class RenderList {
+	public:
+		static constexpr uint32_t MaxQuadsPerBatch = 1024; // also the culling granularity
+		static constexpr uint32_t TextureSlots = 32;
+
+		RenderList();
+		~RenderList();
+
+		RenderList(const RenderList&) = delete;
+		RenderList& operator=(const RenderList&) = delete;
+
+		void begin();
+		void addQuad(const glm::mat4& transform, const glm::vec4& color);
+		void addQuad(const glm::mat4& transform, hyp::TextureHandle texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.f));
+		void addQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		void addQuad(const glm::vec3& position, const glm::vec2& size, hyp::TextureHandle texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.f));
+		/**
+		* \brief uploads the vertices, the buffer only grows
+		*/
+		void end();
+
+		uint32_t getQuadCount() const { return m_quadCount; }
+		uint32_t getBatchCount() const { return (uint32_t)m_batches.size(); }
+
+	private:
+		struct Batch
+		{
+			uint32_t firstQuad = 0;
+			uint32_t quadCount = 0;
+			// slot 0 is the renderer's white texture
+			std::array<hyp::Texture2D*, TextureSlots> textures {};
+			uint32_t textureCount = 1;
+
+			glm::vec2 min { 0.f };
+			glm::vec2 max { 0.f };
+		};
+
+		Batch& getBatch(hyp::Texture2D* texture, float& textureIndex);
+		void pushQuad(const glm::vec3 (&corners)[4], hyp::Texture2D* texture, float tilingFactor, const glm::vec4& color);
+
+	private:
+		friend class Renderer2D;
+
+		std::vector<hyp::QuadVertex> m_vertices;
+		std::vector<Batch> m_batches;
+		uint32_t m_quadCount = 0;
+
+		hyp::Ref<hyp::VertexArray> m_vao;
+		hyp::Ref<hyp::VertexBuffer> m_vbo;
+		uint32_t m_capacity = 0; // quads
+	};
+}
+
+#endif // !HYP_RENDER_LIST_HPP
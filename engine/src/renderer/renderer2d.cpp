@@ -1,13 +1,148 @@
 #define RENDERER_2D_DATA_STRUCTURES
 #include <renderer/renderer2d.hpp>
+#include <renderer/text_document.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/metrics.hpp>
+#include <opengl/debug_output.hpp>
+#include <algorithm>
+#include <cfloat>
 #include <array>
 
 using namespace hyp;
 
 static RendererData s_renderer;
 
+namespace {
+	struct RendererMetrics
+	{
+		hyp::Counter& drawCalls = hyp::Metrics::counter("renderer.draw_calls");
+		hyp::Counter& quads = hyp::Metrics::counter("renderer.quads");
+		hyp::Counter& lines = hyp::Metrics::counter("renderer.lines");
+	};
+
+	// looked up on first use, the registry may not exist yet during static initialization
+	RendererMetrics& getMetrics() {
+		static RendererMetrics s_metrics;
+		return s_metrics;
+	}
+
+	void useQuadProgram() {
+		auto& quad = s_renderer.quad;
+		auto& lighting = s_renderer.lighting;
+
+		quad.program->use();
+		quad.program->setBool("enableLighting", lighting.enabled);
+		if (lighting.enabled)
+		{
+			quad.program->setInt("noLights", lighting.lightCount);
+			lighting.uniformBuffer->setData(lighting.lights.data(), lighting.lights.size() * sizeof(Light));
+		}
+		else
+		{
+			quad.program->setInt("noLights", 0);
+		}
+	}
+
+	// world-space rectangle seen through `viewProjection`
+	void getViewBounds(const glm::mat4& viewProjection, glm::vec2& min, glm::vec2& max) {
+		glm::mat4 inverse = glm::inverse(viewProjection);
+		min = glm::vec2(FLT_MAX);
+		max = glm::vec2(-FLT_MAX);
+		for (float x : { -1.f, 1.f })
+		{
+			for (float y : { -1.f, 1.f })
+			{
+				glm::vec4 corner = inverse * glm::vec4(x, y, 0.f, 1.f);
+				glm::vec2 world = glm::vec2(corner) / corner.w;
+				min = glm::min(min, world);
+				max = glm::max(max, world);
+			}
+		}
+	}
+
+	// appends a glyph to the text batch, which is dispatched first when full
+	void pushGlyph(const glm::mat4& transform, const glm::vec2& quadMin, const glm::vec2& quadMax, const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color) {
+		auto& text = s_renderer.text;
+		if (text.indexCount == MaxIndices)
+		{
+			hyp::Ref<hyp::Texture2D> fontAtlas = text.fontAtlasTexture;
+			utils::nextTextBatch();
+			text.fontAtlasTexture = std::move(fontAtlas);
+		}
+
+		TextVertex v0, v1, v2, v3;
+
+		v0.position = transform * glm ::vec4(quadMin, 0.f, 1.f);
+		v0.color = color;
+		v0.uvCoord = uvMin;
+
+		v1.position = transform * glm ::vec4(quadMin.x, quadMax.y, 0.f, 1.f);
+		v1.color = color;
+		v1.uvCoord = { uvMin.x, uvMax.y };
+
+		v2.position = transform * glm ::vec4(quadMax, 0.f, 1.f);
+		v2.color = color;
+		v2.uvCoord = uvMax;
+
+		v3.position = transform * glm ::vec4(quadMax.x, quadMin.y, 0.f, 1.f);
+		v3.color = color;
+		v3.uvCoord = { uvMax.x, uvMin.y };
+
+		text.vertices.push_back(v0);
+		text.vertices.push_back(v1);
+		text.vertices.push_back(v2);
+		text.vertices.push_back(v3);
+
+		text.indexCount += 6;
+	}
+
+	// sets the debug view uniforms of the program in use and issues the batch's draw call(s)
+	template <typename DrawFn>
+	void drawBatch(hyp::ShaderProgram& program, DrawFn&& draw) {
+		using DebugView = hyp::Renderer2D::DebugView;
+		auto& debug = s_renderer.debug;
+		program.setInt("batchIndex", debug.batchIndex++);
+
+		switch (debug.view)
+		{
+		case DebugView::Overdraw:
+			program.setInt("debugView", (int)DebugView::Overdraw);
+			hyp::RenderCommand::setBlendMode(hyp::BlendMode::Additive);
+			hyp::RenderCommand::setDepthTest(false);
+			draw();
+			hyp::RenderCommand::setDepthTest(true);
+			hyp::RenderCommand::setBlendMode(s_renderer.blendMode);
+			break;
+		case DebugView::BatchWireframe:
+			program.setInt("debugView", (int)DebugView::None);
+			draw();
+
+			// the outline shares the depth of the batch it traces
+			program.setInt("debugView", (int)DebugView::BatchWireframe);
+			hyp::RenderCommand::setDepthTest(false);
+			hyp::RenderCommand::setWireframe(true);
+			draw();
+			hyp::RenderCommand::setWireframe(false);
+			hyp::RenderCommand::setDepthTest(true);
+			break;
+		default:
+			program.setInt("debugView", (int)debug.view);
+			draw();
+			break;
+		}
+	}
+}
+
 void hyp::Renderer2D::init() {
 	HYP_INFO("Initialize 2D Renderer");
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+	HYP_PROFILE_SCOPE("Renderer2D::init");
+
+	// every program is compiling before the first one is waited on
+	utils::initPrograms();
+
+	// quads, circles and glyphs are all drawn as indexed quads, render lists too
+	s_renderer.quadIndexBuffer = utils::createQuadIndexBuffer(std::max(MaxQuad, hyp::RenderList::MaxQuadsPerBatch));
 
 	utils::initQuad();
 	utils::initLine();
@@ -16,12 +151,20 @@ void hyp::Renderer2D::init() {
 
 	s_renderer.cameraUniformBuffer = hyp::UniformBuffer::create(sizeof(RendererData::CameraData), 0);
 	s_renderer.lighting.uniformBuffer = hyp::UniformBuffer::create(sizeof(Light) * MaxLight, 2);
+
+	// upload the default font now (usually preloaded during window creation), not in the first frame
+	{
+		HYP_PROFILE_SCOPE("Renderer2D::defaultFont");
+		hyp::Resources::getDefaultFont();
+	}
 }
 
 void Renderer2D::deinit() {
-	s_renderer.quad.reset();
-	s_renderer.line.reset();
-	s_renderer.circle.reset();
+	hyp::Resources::deinit();
+
+	// every buffer, array and program goes now, while the context is current, not during static destruction
+	s_renderer = RendererData();
+	hyp::GpuMemory::shutdown();
 	HYP_INFO("Destroyed 2D Renderer");
 }
 
@@ -30,6 +173,7 @@ void Renderer2D::deinit() {
 */
 
 void Renderer2D::flush() {
+	HYP_PROFILE_SCOPE("Renderer2D::flush");
 	utils::flushQuad();
 	utils::flushLine();
 	utils::flushCircle();
@@ -59,15 +203,61 @@ void Renderer2D::nextBatch() {
 	startBatch();
 }
 
+const hyp::Ref<hyp::ElementBuffer>& Renderer2D::getQuadIndexBuffer() {
+	return s_renderer.quadIndexBuffer;
+}
+
+void Renderer2D::flushPending() {
+	utils::nextQuadBatch();
+	utils::nextLineBatch();
+	utils::nextCircleBatch();
+	utils::nextTextBatch();
+}
+
+void Renderer2D::setViewProjection(const glm::mat4& viewProjection) {
+	s_renderer.cameraBuffer.viewProjection = viewProjection;
+	s_renderer.cameraUniformBuffer->setData(&s_renderer.cameraBuffer, sizeof(RendererData::CameraData));
+}
+
 void Renderer2D::beginScene(const glm::mat4& viewProjectionMatrix) {
 	startBatch();
+	s_renderer.debug.batchIndex = 0;
+	s_renderer.viewProjectionStack.clear();
 
-	s_renderer.cameraBuffer.viewProjection = viewProjectionMatrix;
-	s_renderer.cameraUniformBuffer->setData(&s_renderer.cameraBuffer, sizeof(RendererData::CameraData));
+	setViewProjection(viewProjectionMatrix);
+}
+
+void Renderer2D::pushViewProjection(const glm::mat4& viewProjection) {
+	flushPending();
+	s_renderer.viewProjectionStack.push_back(s_renderer.cameraBuffer.viewProjection);
+	setViewProjection(viewProjection);
+}
+
+void Renderer2D::popViewProjection() {
+	HYP_ASSERT_CORE(!s_renderer.viewProjectionStack.empty(), "popViewProjection without a matching push");
+	flushPending();
+	setViewProjection(s_renderer.viewProjectionStack.back());
+	s_renderer.viewProjectionStack.pop_back();
+}
+
+void Renderer2D::setBlendMode(hyp::BlendMode mode) {
+	if (mode == s_renderer.blendMode) return;
+
+	flushPending();
+	s_renderer.blendMode = mode;
+	hyp::RenderCommand::setBlendMode(mode);
+}
+
+hyp::BlendMode Renderer2D::getBlendMode() {
+	return s_renderer.blendMode;
 }
 
 void Renderer2D::endScene() {
 	flush();
+
+	hyp::FlightRecorder::recordCounter("Renderer2D.drawCalls", s_renderer.stats.drawCalls);
+	hyp::FlightRecorder::recordCounter("Renderer2D.quads", s_renderer.stats.quadCount);
+	hyp::FlightRecorder::recordCounter("Renderer2D.lines", s_renderer.stats.lineCount);
 }
 
 void Renderer2D::enableLighting(bool value) {
@@ -90,12 +280,20 @@ void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, cons
 	drawQuad(model, color);
 }
 
-void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, hyp::Ref<hyp::Texture2D> texture, float tilingFactor, const glm::vec4& color) {
+void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, const hyp::Ref<hyp::Texture2D>& texture, float tilingFactor, const glm::vec4& color) {
+	glm::mat4 model = glm::mat4(1.0f);
+	model = glm::translate(model, position + glm::vec3(size / 2.f, 0.f));
+	model = glm::scale(model, glm::vec3(size, 0.f));
+
+	drawTexturedQuad(model, texture.get(), texture, tilingFactor, color);
+}
+
+void Renderer2D::drawQuad(const glm::vec3& position, const glm::vec2& size, hyp::TextureHandle texture, float tilingFactor, const glm::vec4& color) {
 	glm::mat4 model = glm::mat4(1.0f);
 	model = glm::translate(model, position + glm::vec3(size / 2.f, 0.f));
 	model = glm::scale(model, glm::vec3(size, 0.f));
 
-	drawQuad(model, texture, tilingFactor, color);
+	drawTexturedQuad(model, hyp::Resources::getTexture(texture), nullptr, tilingFactor, color);
 }
 
 void Renderer2D::drawQuad(const glm::mat4& transform, const glm::vec4& color) {
@@ -128,17 +326,85 @@ void Renderer2D::drawQuad(const glm::mat4& transform, const glm::vec4& color) {
 	s_renderer.quad.indexCount += 6;
 }
 
+static_assert(sizeof(Renderer2D::QuadInstance) == 9 * sizeof(float), "QuadInstance must stay tightly packed");
+
+void Renderer2D::drawQuads(const QuadInstance* quads, uint32_t count) {
+	auto& quad = s_renderer.quad;
+
+	uint32_t submitted = 0;
+	while (submitted < count)
+	{
+		if (quad.transforms.size() == MaxQuad)
+		{
+			utils::nextQuadBatch();
+		}
+
+		uint32_t chunk = std::min(count - submitted, MaxQuad - (uint32_t)quad.transforms.size());
+		quad.vertices.reserve(quad.vertices.size() + chunk * 4);
+		quad.transforms.reserve(quad.transforms.size() + chunk);
+
+		for (uint32_t i = 0; i < chunk; i++)
+		{
+			const QuadInstance& instance = quads[submitted + i];
+
+			// same as translate(position + size / 2) * scale(size), without the matrix products
+			glm::mat4 transform(0.f);
+			transform[0][0] = instance.size.x;
+			transform[1][1] = instance.size.y;
+			transform[3] = glm::vec4(instance.position + glm::vec3(instance.size / 2.f, 0.f), 1.f);
+
+			for (int v = 0; v < 4; v++)
+			{
+				QuadVertex vertex;
+				vertex.pos = quad.vertexPos[v];
+				vertex.color = instance.color;
+				vertex.uv = quad.uvCoords[v];
+				vertex.textureIndex = 0.0;
+				vertex.transformIndex = quad.transformIndexCount;
+				vertex.tilingFactor = 1.f;
+
+				quad.vertices.push_back(vertex);
+			}
+
+			quad.transforms.push_back(transform);
+			quad.transformIndexCount++;
+		}
+
+		quad.indexCount += chunk * 6;
+		submitted += chunk;
+	}
+}
+
 /*
 * @brief for rendering textured-quad
 */
-void hyp::Renderer2D::drawQuad(const glm::mat4& transform, hyp::Ref<hyp::Texture2D>& texture, float tilingFactor, const glm::vec4& color) {
+void hyp::Renderer2D::drawQuad(const glm::mat4& transform, const hyp::Ref<hyp::Texture2D>& texture, float tilingFactor, const glm::vec4& color) {
+	drawTexturedQuad(transform, texture.get(), texture, tilingFactor, color);
+}
+
+void hyp::Renderer2D::drawQuad(const glm::mat4& transform, hyp::TextureHandle texture, float tilingFactor, const glm::vec4& color) {
+	drawTexturedQuad(transform, hyp::Resources::getTexture(texture), nullptr, tilingFactor, color);
+}
+
+void hyp::Renderer2D::drawTexturedQuad(const glm::mat4& transform, hyp::Texture2D* texture, const hyp::Ref<hyp::Texture2D>& owner, float tilingFactor, const glm::vec4& color) {
 	auto& quad = s_renderer.quad;
 
+	// a stale handle or an empty reference falls back to the default (white) texture
+	if (!texture)
+	{
+		texture = quad.defaultTexture.get();
+	}
+
+	if (quad.transforms.size() == MaxQuad)
+	{
+		utils::nextQuadBatch();
+	}
+
 	float textureIndex = 0.0;
 	// find texture in slots
 	for (uint32_t i = 1; i < quad.textureSlotIndex; i++)
 	{
-		if (*quad.textureSlots[i] == *texture)
+		if (quad.textureSlots[i]->getTextureId() == texture->getTextureId())
 		{
 			textureIndex = (float)i;
 			break;
@@ -155,6 +421,7 @@ void hyp::Renderer2D::drawQuad(const glm::mat4& transform, hyp::Ref<hyp::Texture
 		/// this logic above avoids this scenario, and is presumed to reset the slot index
 		HYP_ASSERT_CORE(quad.textureSlotIndex != MaxTextureSlots, "texture slot limits exceeded");
 		quad.textureSlots[quad.textureSlotIndex] = texture;
+		quad.textureOwners[quad.textureSlotIndex] = owner; // one reference per slot, not per draw
 		textureIndex = (float)quad.textureSlotIndex++;
 	}
 
@@ -178,6 +445,46 @@ void hyp::Renderer2D::drawQuad(const glm::mat4& transform, hyp::Ref<hyp::Texture
 	s_renderer.quad.indexCount += 6;
 }
 
+void Renderer2D::drawRenderList(const hyp::RenderList& list) {
+	HYP_GL_DEBUG_TAG("Renderer2D::drawRenderList");
+	if (list.m_batches.empty() || !list.m_vao) return;
+
+	// whatever was submitted before the list is drawn before it
+	flushPending();
+
+	glm::vec2 viewMin, viewMax;
+	getViewBounds(s_renderer.cameraBuffer.viewProjection, viewMin, viewMax);
+
+	auto& quad = s_renderer.quad;
+	// list vertices are in world space, they all use transform 0
+	const glm::mat4 identity(1.f);
+	quad.transformBuffer->setData(&identity, sizeof(glm::mat4));
+	useQuadProgram();
+
+	static hyp::Counter& s_culledBatches = hyp::Metrics::counter("renderer.culled_batches");
+	for (const auto& batch : list.m_batches)
+	{
+		if (batch.max.x < viewMin.x || batch.min.x > viewMax.x || batch.max.y < viewMin.y || batch.min.y > viewMax.y)
+		{
+			s_culledBatches.add();
+			continue;
+		}
+
+		quad.defaultTexture->bind(0);
+		for (uint32_t i = 1; i < batch.textureCount; i++)
+		{
+			batch.textures[i]->bind(i);
+		}
+
+		drawBatch(*quad.program, [&]() { hyp::RenderCommand::drawIndexed(list.m_vao, batch.quadCount * 6, batch.firstQuad * 4); });
+
+		s_renderer.stats.quadCount += batch.quadCount;
+		s_renderer.stats.drawCalls++;
+		getMetrics().quads.add(batch.quadCount);
+		getMetrics().drawCalls.add();
+	}
+}
+
 void Renderer2D::drawLine(const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color) {
 	LineVertex v0, v1;
 
@@ -214,19 +521,34 @@ void Renderer2D::drawCircle(const glm::mat4& transform, float thickness, float f
 	s_renderer.circle.indexCount += 6;
 }
 
-void hyp::Renderer2D::drawString(const std::string& str, hyp::Ref<hyp::Font> font, const glm::mat4& transform, const TextParams& textParams) {
+void hyp::Renderer2D::drawString(const std::string& str, const hyp::Ref<hyp::Font>& font, const glm::mat4& transform, const TextParams& textParams) {
+	drawGlyphs(str, font.get(), transform, textParams);
+}
+
+void hyp::Renderer2D::drawString(const std::string& str, hyp::FontHandle font, const glm::mat4& transform, const TextParams& textParams) {
+	drawGlyphs(str, hyp::Resources::getFont(font), transform, textParams);
+}
+
+void hyp::Renderer2D::drawGlyphs(const std::string& str, hyp::Font* font, const glm::mat4& transform, const TextParams& textParams) {
 	auto& text = s_renderer.text;
 
 	// switch to engine's default font, if the provided font is invalid
 	if (!font)
 	{
-		font = hyp::Font::getDefault();
+		font = hyp::Resources::getFont(hyp::Resources::getDefaultFont());
 	}
 
 	const auto& fontGeometry = font->getFontData();
 	const auto& metrics = fontGeometry->getMetrics();
-	auto fontAtlas = font->getAtlasTexture();
-	text.fontAtlasTexture = fontAtlas;
+	const auto& fontAtlas = font->getAtlasTexture();
+
+	// a batch samples a single atlas, so a font switch has to dispatch it; the batch holds a
+	// reference, so the atlas outlives a font released before the flush
+	if (text.fontAtlasTexture != fontAtlas)
+	{
+		if (text.indexCount) utils::nextTextBatch();
+		text.fontAtlasTexture = fontAtlas;
+	}
 
 	float x = 0.0;
 	float y = 0.0;
@@ -284,37 +606,82 @@ void hyp::Renderer2D::drawString(const std::string& str, hyp::Ref<hyp::Font> fon
 		quadMin += glm::vec2(x, y);
 		quadMax += glm::vec2(x, y);
 
-		TextVertex v0, v1, v2, v3;
+		pushGlyph(transform, quadMin, quadMax, uvMin, uvMax, textParams.color);
 
-		v0.position = transform * glm ::vec4(quadMin, 0.f, 1.f);
-		v0.color = textParams.color;
-		v0.uvCoord = uvMin;
+		x += fontScalingFactor * glyph->advance.x * scale;
+	}
+}
 
-		v1.position = transform * glm ::vec4(quadMin.x, quadMax.y, 0.f, 1.f);
-		v1.color = textParams.color;
-		v1.uvCoord = { uvMin.x, uvMax.y };
+void hyp::Renderer2D::drawTextDocument(hyp::TextDocument& document, const glm::mat4& transform) {
+	HYP_PROFILE_SCOPE("Renderer2D::drawTextDocument");
+	const auto& font = document.getFont();
+	if (!font || !font->getAtlasTexture()) return;
 
-		v2.position = transform * glm ::vec4(quadMax, 0.f, 1.f);
-		v2.color = textParams.color;
-		v2.uvCoord = uvMax;
+	// the view in the document's space
+	glm::vec2 viewMin, viewMax;
+	getViewBounds(s_renderer.cameraBuffer.viewProjection * transform, viewMin, viewMax);
 
-		v3.position = transform * glm ::vec4(quadMax.x, quadMin.y, 0.f, 1.f);
-		v3.color = textParams.color;
-		v3.uvCoord = { uvMax.x, uvMin.y };
+	size_t first, last;
+	if (!document.getVisibleLines(viewMin.y, viewMax.y, first, last)) return;
 
-		text.vertices.push_back(v0);
-		text.vertices.push_back(v1);
-		text.vertices.push_back(v2);
-		text.vertices.push_back(v3);
+	auto& text = s_renderer.text;
+	const auto& fontAtlas = font->getAtlasTexture();
+	if (text.fontAtlasTexture != fontAtlas)
+	{
+		if (text.indexCount) utils::nextTextBatch();
+		text.fontAtlasTexture = fontAtlas;
+	}
 
-		text.indexCount += 6;
+	// a glyph at pen x covers [x + glyphMin.x, x + glyphMax.x]
+	const float penMin = viewMin.x - document.m_glyphMax.x;
+	const float penMax = viewMax.x - document.m_glyphMin.x;
 
-		x += fontScalingFactor * glyph->advance.x * scale;
+	for (size_t i = first; i <= last; i++)
+	{
+		const auto& line = document.layout(i);
+		const glm::vec2 baseline(0.f, document.getLineAdvance() * (float)i);
+
+		auto glyph = std::lower_bound(line.glyphs.begin(), line.glyphs.end(), penMin,
+		    [](const auto& quad, float pen) { return quad.pen < pen; });
+		for (; glyph != line.glyphs.end() && glyph->pen <= penMax; ++glyph)
+		{
+			pushGlyph(transform, glyph->min + baseline, glyph->max + baseline, glyph->uvMin, glyph->uvMax, line.color);
+		}
 	}
 }
 
+void utils::initPrograms() {
+	HYP_PROFILE_SCOPE("Renderer2D::compilePrograms");
+
+	s_renderer.quad.program = hyp::ShaderProgram::create("assets/shaders/quad.vert", "assets/shaders/quad.frag");
+	s_renderer.line.program = hyp::ShaderProgram::create("assets/shaders/line.vert", "assets/shaders/line.frag");
+	s_renderer.circle.program = hyp::ShaderProgram::create("assets/shaders/circle.vert", "assets/shaders/circle.frag");
+	s_renderer.text.program = hyp::ShaderProgram::create("assets/shaders/text.vert", "assets/shaders/text.frag");
+
+	s_renderer.quad.program->link();
+	s_renderer.line.program->link();
+	s_renderer.circle.program->link();
+	s_renderer.text.program->link();
+}
+
 /*Quad Data*/
 
+hyp::Ref<hyp::ElementBuffer> utils::createQuadIndexBuffer(uint32_t quadCount) {
+	std::vector<uint32_t> indices(quadCount * 6);
+	for (uint32_t i = 0, offset = 0; i < indices.size(); i += 6, offset += 4)
+	{
+		indices[i + 0] = offset + 0;
+		indices[i + 1] = offset + 1;
+		indices[i + 2] = offset + 2;
+
+		indices[i + 3] = offset + 2;
+		indices[i + 4] = offset + 3;
+		indices[i + 5] = offset + 0;
+	}
+
+	return hyp::CreateRef<hyp::ElementBuffer>(indices.data(), (uint32_t)indices.size());
+}
+
 void utils::initQuad() {
 	auto& quad = s_renderer.quad;
 
@@ -322,7 +689,7 @@ void utils::initQuad() {
 	quad.defaultTexture = hyp::Texture2D::create(TextureSpecification());
 	uint32_t whiteColor = 0xFFffFFff;
 	quad.defaultTexture->setData(&whiteColor, sizeof(uint32_t));
-	quad.textureSlots[0] = quad.defaultTexture;
+	quad.textureSlots[0] = quad.defaultTexture.get();
 
 	quad.vao = hyp::VertexArray::create();
 	quad.vbo = hyp::VertexBuffer::create(MaxVertices * sizeof(QuadVertex));
@@ -340,29 +707,8 @@ void utils::initQuad() {
 	quad.vertices.clear();
 	quad.vertices.resize(MaxVertices);
 
-	uint32_t* quadIndices = new uint32_t[MaxIndices];
-	int offset = 0;
-	int i = 0;
-	for (i = 0; i < MaxIndices; i += 6)
-	{
-		quadIndices[i + 0] = offset + 0;
-		quadIndices[i + 1] = offset + 1;
-		quadIndices[i + 2] = offset + 2;
-
-		quadIndices[i + 3] = offset + 2;
-		quadIndices[i + 4] = offset + 3;
-		quadIndices[i + 5] = offset + 0;
-
-		offset += 4;
-	}
-	hyp::Ref<hyp::ElementBuffer> elementBuffer = hyp::CreateRef<hyp::ElementBuffer>(quadIndices, MaxIndices);
-	quad.vao->setIndexBuffer(elementBuffer);
-	delete[] quadIndices;
+	quad.vao->setIndexBuffer(s_renderer.quadIndexBuffer);
 
-	quad.program = hyp::CreateRef<hyp::ShaderProgram>("assets/shaders/quad.vert",
-	    "assets/shaders/quad.frag");
-
-	quad.program->link();
 	quad.program->setBlockBinding("Camera", 0);
 	quad.program->setBlockBinding("Transform", 1);
 	quad.program->setBlockBinding("Lights", 2);
@@ -389,6 +735,7 @@ void utils::initQuad() {
 }
 
 void utils::flushQuad() {
+	HYP_GL_DEBUG_TAG("Renderer2D::flushQuad");
 	auto& quad = s_renderer.quad;
 	uint32_t size = quad.vertices.size();
 	if (size == 0)
@@ -398,29 +745,19 @@ void utils::flushQuad() {
 
 	quad.vbo->setData(quad.vertices.data(), size * sizeof(QuadVertex));
 
-	auto& lighting = s_renderer.lighting;
 	quad.transformBuffer->setData(quad.transforms.data(), quad.transforms.size() * sizeof(glm::mat4));
-
-	quad.program->use();
-	quad.program->setBool("enableLighting", lighting.enabled);
-	if (lighting.enabled)
-	{
-		quad.program->setInt("noLights", lighting.lightCount);
-		lighting.uniformBuffer->setData(lighting.lights.data(), lighting.lights.size() * sizeof(Light));
-	}
-	else
-	{
-		quad.program->setInt("noLights", 0);
-	}
+	useQuadProgram();
 
 	for (uint32_t i = 0; i < quad.textureSlotIndex; i++)
 	{
 		quad.textureSlots[i]->bind(i);
 	}
-	hyp::RenderCommand::drawIndexed(quad.vao, quad.indexCount);
+	drawBatch(*quad.program, [&]() { hyp::RenderCommand::drawIndexed(quad.vao, quad.indexCount); });
 
 	s_renderer.stats.quadCount += quad.transforms.size(); // each transform count presents a quad (4 vertices)
 	s_renderer.stats.drawCalls++;
+	getMetrics().quads.add(quad.transforms.size());
+	getMetrics().drawCalls.add();
 }
 
 void utils::nextQuadBatch() {
@@ -444,13 +781,11 @@ void utils::initLine() {
 	line.vertices.clear();
 	line.vertices.resize(MaxVertices);
 
-	line.program = hyp::CreateRef<hyp::ShaderProgram>(
-	    "assets/shaders/line.vert", "assets/shaders/line.frag");
-	line.program->link();
 	line.program->setBlockBinding("Camera", 0);
 }
 
 void utils::flushLine() {
+	HYP_GL_DEBUG_TAG("Renderer2D::flushLine");
 	auto& line = s_renderer.line;
 	size_t size = line.vertices.size();
 	if (size == 0)
@@ -462,10 +797,12 @@ void utils::flushLine() {
 	line.vbo->setData(&line.vertices[0], size * sizeof(LineVertex));
 	line.program->use();
 
-	hyp::RenderCommand::drawLines(line.vao, size);
+	drawBatch(*line.program, [&]() { hyp::RenderCommand::drawLines(line.vao, size); });
 
 	s_renderer.stats.lineCount += size * 0.5;
 	s_renderer.stats.drawCalls++;
+	getMetrics().lines.add(size / 2);
+	getMetrics().drawCalls.add();
 }
 
 void utils::nextLineBatch() {
@@ -492,37 +829,14 @@ void utils::initCircle() {
 	});
 	circle.vbo->setLayout(layout);
 
-	uint32_t* indices = new uint32_t[MaxIndices];
-
-	int offset = 0;
-	int i = 0;
-	for (i = 0; i < MaxIndices; i += 6)
-	{
-		indices[i + 0] = offset + 0;
-		indices[i + 1] = offset + 1;
-		indices[i + 2] = offset + 2;
-
-		indices[i + 3] = offset + 2;
-		indices[i + 4] = offset + 3;
-		indices[i + 5] = offset + 0;
-
-		offset += 4;
-	}
-
-	auto& circleIndexBuffer = hyp::CreateRef<hyp::ElementBuffer>(indices, MaxIndices);
 	circle.vao->addVertexBuffer(circle.vbo);
-	circle.vao->setIndexBuffer(circleIndexBuffer);
-
-	delete[] indices;
+	circle.vao->setIndexBuffer(s_renderer.quadIndexBuffer);
 
-	circle.program = hyp::ShaderProgram::create("assets/shaders/circle.vert",
-	    "assets/shaders/circle.frag");
-
-	circle.program->link();
 	circle.program->setBlockBinding("Camera", 0);
 }
 
 void utils::flushCircle() {
+	HYP_GL_DEBUG_TAG("Renderer2D::flushCircle");
 	auto& circle = s_renderer.circle;
 	size_t size = circle.vertices.size();
 
@@ -534,7 +848,8 @@ void utils::flushCircle() {
 	circle.vbo->setData(circle.vertices.data(), (uint32_t)size * sizeof(CircleVertex));
 
 	circle.program->use();
-	hyp::RenderCommand::drawIndexed(circle.vao, circle.indexCount);
+	drawBatch(*circle.program, [&]() { hyp::RenderCommand::drawIndexed(circle.vao, circle.indexCount); });
+	getMetrics().drawCalls.add();
 }
 
 void utils::nextCircleBatch() {
@@ -559,36 +874,13 @@ void utils::initText() {
 	text.vertices.clear();
 	text.vertices.resize(MaxVertices);
 
-	uint32_t* indices = new uint32_t[MaxIndices];
-	int offset = 0;
-	int i = 0;
-
-	for (i = 0; i < MaxIndices; i += 6)
-	{
-		indices[i + 0] = offset + 0;
-		indices[i + 1] = offset + 1;
-		indices[i + 2] = offset + 2;
-
-		indices[i + 3] = offset + 2;
-		indices[i + 4] = offset + 3;
-		indices[i + 5] = offset + 0;
+	text.vao->setIndexBuffer(s_renderer.quadIndexBuffer);
 
-		offset += 4;
-	}
-
-	auto& textIndexBuffer = hyp::CreateRef<hyp::ElementBuffer>(indices, MaxIndices);
-
-	text.vao->setIndexBuffer(textIndexBuffer);
-	delete[] indices;
-
-	text.program = hyp::ShaderProgram::create("assets/shaders/text.vert",
-	    "assets/shaders/text.frag");
-
-	text.program->link();
 	text.program->setBlockBinding("Camera", 0);
 }
 
 void utils::flushText() {
+	HYP_GL_DEBUG_TAG("Renderer2D::flushText");
 	auto& text = s_renderer.text;
 	size_t size = text.vertices.size();
 
@@ -601,7 +893,8 @@ void utils::flushText() {
 
 	text.program->use();
 	text.fontAtlasTexture->bind(0);
-	hyp::RenderCommand::drawIndexed(text.vao, text.indexCount);
+	drawBatch(*text.program, [&]() { hyp::RenderCommand::drawIndexed(text.vao, text.indexCount); });
+	getMetrics().drawCalls.add();
 }
 
 void utils::nextTextBatch() {
@@ -609,6 +902,26 @@ void utils::nextTextBatch() {
 	s_renderer.text.reset();
 }
 
+void hyp::Renderer2D::setDebugView(DebugView view) {
+	s_renderer.debug.view = view;
+}
+
+hyp::Renderer2D::DebugView hyp::Renderer2D::getDebugView() {
+	return s_renderer.debug.view;
+}
+
+const char* hyp::Renderer2D::getDebugViewName(DebugView view) {
+	switch (view)
+	{
+	case DebugView::None: return "None";
+	case DebugView::Overdraw: return "Overdraw";
+	case DebugView::Batches: return "Batches";
+	case DebugView::TextureSlots: return "Texture slots";
+	case DebugView::BatchWireframe: return "Batch wireframe";
+	default: return "Unknown";
+	}
+}
+
 hyp::Renderer2D::Stats hyp::Renderer2D::getStats() {
 	return s_renderer.stats;
 }
@@ -7,8 +7,12 @@
 	#include <renderer/render_command.hpp>
 	#include <renderer/texture.hpp>
 	#include <renderer/font.hpp>
+	#include <renderer/resources.hpp>
+	#include <renderer/render_list.hpp>
 
 namespace hyp {
+	class TextDocument;
+
 	struct Light
 	{
 		glm::vec4 position;
@@ -39,13 +43,52 @@ namespace hyp {
 
 		static void addLight(const Light& light);
 
+		/**
+		* \brief draws what was submitted so far, then switches the view-projection until the matching pop;
+		* used to render into offscreen targets (see LayerCache) in the middle of a scene
+		*/
+		static void pushViewProjection(const glm::mat4& viewProjection);
+		static void popViewProjection();
+
+		/**
+		* \brief draws what was submitted so far with the previous mode when it changes
+		*/
+		static void setBlendMode(hyp::BlendMode mode);
+		static hyp::BlendMode getBlendMode();
+
 	public:
 		static void drawQuad(const glm::mat4& transform, const glm::vec4& color);
-		static void drawQuad(const glm::mat4& transform, hyp::Ref<hyp::Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.f));
+		static void drawQuad(const glm::mat4& transform, const hyp::Ref<hyp::Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.f));
+		static void drawQuad(const glm::mat4& transform, hyp::TextureHandle texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.f));
 
 		static void drawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void drawQuad(const glm::vec3& position, const glm::vec2& size,
-		    hyp::Ref<hyp::Texture2D> texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.0));
+		    const hyp::Ref<hyp::Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.0));
+		static void drawQuad(const glm::vec3& position, const glm::vec2& size,
+		    hyp::TextureHandle texture, float tilingFactor = 1.f, const glm::vec4& color = glm::vec4(1.0));
+
+	public:
+		/**
+		* \brief untextured quad as laid out in bulk submissions: 9 tightly packed floats
+		*/
+		struct QuadInstance
+		{
+			glm::vec3 position;
+			glm::vec2 size;
+			glm::vec4 color;
+		};
+
+		/**
+		* \brief appends `count` quads at once, splitting them over as many batches as needed
+		*/
+		static void drawQuads(const QuadInstance* quads, uint32_t count);
+
+	public:
+		/**
+		* \brief draws an extracted RenderList with the current scene's view-projection, skipping
+		* the batches outside of the view. Keeps the order with the quads submitted before it.
+		*/
+		static void drawRenderList(const hyp::RenderList& list);
 
 	public:
 		static void drawLine(const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color = glm::vec4(1.0));
@@ -59,15 +102,55 @@ namespace hyp {
 			float leading = 0.f; // line-spacing
 			float fontSize = 48.f;
 		};
-		static void drawString(const std::string& text, hyp::Ref<hyp::Font> font, const glm::mat4& transform, const TextParams& textParams);
+		static void drawString(const std::string& text, const hyp::Ref<hyp::Font>& font, const glm::mat4& transform, const TextParams& textParams);
+		static void drawString(const std::string& text, hyp::FontHandle font, const glm::mat4& transform, const TextParams& textParams);
+
+		/**
+		* \brief draws the lines of the document crossing the current view, laying out the edited ones
+		*/
+		static void drawTextDocument(hyp::TextDocument& document, const glm::mat4& transform = glm::mat4(1.f));
+
+	public:
+		/**
+		* \brief debug visualizations, switched at runtime through uniforms of the batch shaders.
+		*
+		* Overdraw adds a constant per fragment with depth testing off, so the brightest areas are the
+		* most layered. Batches colours everything by draw call, TextureSlots by the slot a quad sampled,
+		* and BatchWireframe outlines the triangles of every batch in the batch colour on top of the scene.
+		*/
+		enum class DebugView
+		{
+			None = 0,
+			Overdraw,
+			Batches,
+			TextureSlots,
+			BatchWireframe,
+			Count
+		};
+
+		static void setDebugView(DebugView view);
+		static DebugView getDebugView();
+		static const char* getDebugViewName(DebugView view);
 
 	public:
 		static Stats getStats();
 
+		/**
+		* \brief the 0-1-2 2-3-0 pattern for at least max(MaxQuad, RenderList::MaxQuadsPerBatch) quads
+		*/
+		static const hyp::Ref<hyp::ElementBuffer>& getQuadIndexBuffer();
+
 	private:
 		static void startBatch();
 		static void nextBatch();
 		static void flush();
+		// flushes and resets every batch, keeping the stats
+		static void flushPending();
+		static void setViewProjection(const glm::mat4& viewProjection);
+
+		// `owner` is retained until the batch is flushed, null for handle textures
+		static void drawTexturedQuad(const glm::mat4& transform, hyp::Texture2D* texture, const hyp::Ref<hyp::Texture2D>& owner, float tilingFactor, const glm::vec4& color);
+		static void drawGlyphs(const std::string& text, hyp::Font* font, const glm::mat4& transform, const TextParams& textParams);
 
 	private:
 	};
@@ -91,6 +174,7 @@ namespace hyp {
 		#include "uniform_buffer.hpp"
 		#include <renderer/element_buffer.hpp>
 		#include <renderer/render_command.hpp>
+		#include <debug/memory_tracker.hpp>
 		#include <array>
 
 /* Constants */
@@ -103,6 +187,9 @@ const uint32_t MaxVertices = MaxQuad * 4;
 const uint32_t MaxIndices = MaxQuad * 6;
 
 namespace utils {
+	static void initPrograms();
+	static hyp::Ref<hyp::ElementBuffer> createQuadIndexBuffer(uint32_t quadCount);
+
 	static void initQuad();
 	static void flushQuad();
 	static void nextQuadBatch();
@@ -121,6 +208,9 @@ namespace utils {
 }
 
 namespace hyp {
+	template <typename T>
+	using RendererVector = std::vector<T, hyp::TrackedAllocator<T, hyp::MemoryTag::Renderer>>;
+
 	struct QuadVertex
 	{
 		glm::vec3 pos = glm::vec3(0.0);
@@ -163,16 +253,18 @@ namespace hyp {
 	struct QuadData : public RenderEntity
 	{
 		// quad vertices
-		std::vector<QuadVertex> vertices;
+		RendererVector<QuadVertex> vertices;
 		uint32_t indexCount = 0;
 
 		// transformation info
-		std::vector<glm::mat4> transforms;
+		RendererVector<glm::mat4> transforms;
 		hyp::Shared<hyp::UniformBuffer> transformBuffer;
 		int transformIndexCount = 0;
 
-		// textures
-		std::array<hyp::Ref<hyp::Texture2D>, MaxTextureSlots> textureSlots;
+		// textures; handle textures are borrowed (Resources defers their release past the frame),
+		// those drawn through a Ref are kept alive by textureOwners until the batch is flushed
+		std::array<hyp::Texture2D*, MaxTextureSlots> textureSlots {};
+		std::array<hyp::Ref<hyp::Texture2D>, MaxTextureSlots> textureOwners;
 		hyp::Ref<hyp::Texture2D> defaultTexture;
 		uint32_t textureSlotIndex = 1; // 1 instead of 0 because there's already an existing texture -- defaultTexture --
 
@@ -184,13 +276,14 @@ namespace hyp {
 			transforms.clear();
 			indexCount = 0;
 			transformIndexCount = 0;
+			for (uint32_t i = 1; i < textureSlotIndex; i++) textureOwners[i].reset();
 			textureSlotIndex = 1;
 		}
 	};
 
 	struct LineData : public RenderEntity
 	{
-		std::vector<LineVertex> vertices;
+		RendererVector<LineVertex> vertices;
 		virtual void reset() {
 			vertices.clear();
 		}
@@ -198,7 +291,7 @@ namespace hyp {
 
 	struct CircleData : public RenderEntity
 	{
-		std::vector<CircleVertex> vertices;
+		RendererVector<CircleVertex> vertices;
 		uint32_t indexCount = 0;
 
 		virtual void reset() {
@@ -209,7 +302,7 @@ namespace hyp {
 
 	struct TextData : public RenderEntity
 	{
-		std::vector<TextVertex> vertices;
+		RendererVector<TextVertex> vertices;
 		uint32_t indexCount = 0;
 
 		hyp::Ref<hyp::Texture2D> fontAtlasTexture;
@@ -227,7 +320,7 @@ namespace hyp {
 	/// 2. providing ambient, diffuse and specular color for each light
 	struct LightingData
 	{
-		std::vector<hyp::Light> lights;
+		RendererVector<hyp::Light> lights;
 		hyp::Shared<hyp::UniformBuffer> uniformBuffer;
 		int lightCount = 0;
 		bool enabled = false;
@@ -249,6 +342,20 @@ namespace hyp {
 
 		CameraData cameraBuffer {};
 		hyp::Shared<hyp::UniformBuffer> cameraUniformBuffer;
+		std::vector<glm::mat4> viewProjectionStack;
+
+		// shared by every quad shaped batch
+		hyp::Ref<hyp::ElementBuffer> quadIndexBuffer;
+
+		hyp::BlendMode blendMode = hyp::BlendMode::Alpha;
+
+		struct DebugData
+		{
+			Renderer2D::DebugView view = Renderer2D::DebugView::None;
+			int batchIndex = 0; // draw calls since beginScene
+		};
+
+		DebugData debug;
 
 		Renderer2D::Stats stats;
 	};
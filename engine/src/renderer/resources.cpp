@@ -0,0 +1,155 @@
+#include "resources.hpp"
+#include <core/job_system.hpp>
+#include <debug/flight_recorder.hpp>
+#include <utils/logger.hpp>
+#include <unordered_map>
+
+namespace {
+	template <typename T>
+	struct Preload
+	{
+		hyp::JobHandle job;
+		hyp::Ref<T> data;
+	};
+
+	hyp::ResourceRegistry<hyp::Texture2D> s_textures;
+	hyp::ResourceRegistry<hyp::Font> s_fonts;
+	hyp::FontHandle s_defaultFont;
+	uint64_t s_frame = 0;
+
+	// only touched by the main thread, the jobs write to `data` alone
+	std::unordered_map<std::string, Preload<hyp::ImageData>> s_textureLoads;
+	std::unordered_map<std::string, Preload<hyp::FontAtlas>> s_fontLoads;
+
+	template <typename T>
+	hyp::Ref<T> takePreload(std::unordered_map<std::string, Preload<T>>& loads, const std::string& path) {
+		auto it = loads.find(path);
+		if (it == loads.end()) return nullptr;
+
+		Preload<T> load = std::move(it->second);
+		loads.erase(it);
+
+		HYP_PROFILE_SCOPE("Resources::waitPreload");
+		hyp::JobSystem::wait(load.job);
+		return load.data;
+	}
+}
+
+hyp::TextureHandle hyp::Resources::addTexture(const hyp::Ref<hyp::Texture2D>& texture) {
+	return s_textures.add(texture);
+}
+
+hyp::TextureHandle hyp::Resources::loadTexture(const std::string& path) {
+	hyp::Ref<hyp::Texture2D> texture;
+	if (auto image = takePreload(s_textureLoads, path))
+	{
+		texture = image->isValid() ? hyp::CreateRef<hyp::Texture2D>(*image, path) : nullptr;
+	}
+	else
+	{
+		texture = hyp::Texture2D::create(path);
+	}
+
+	if (!texture || !texture->isLoaded())
+	{
+		HYP_WARN("Failed to load texture %s", path.c_str());
+		return {};
+	}
+
+	return s_textures.add(texture);
+}
+
+hyp::Texture2D* hyp::Resources::getTexture(TextureHandle handle) {
+	return s_textures.get(handle);
+}
+
+void hyp::Resources::releaseTexture(TextureHandle handle) {
+	s_textures.release(handle, s_frame);
+}
+
+hyp::FontHandle hyp::Resources::addFont(const hyp::Ref<hyp::Font>& font) {
+	return s_fonts.add(font);
+}
+
+hyp::FontHandle hyp::Resources::loadFont(const std::string& path) {
+	if (auto atlas = takePreload(s_fontLoads, path))
+	{
+		if (!atlas->isValid())
+		{
+			HYP_WARN("Failed to load font %s", path.c_str());
+			return {};
+		}
+
+		return s_fonts.add(hyp::CreateRef<hyp::Font>(*atlas));
+	}
+
+	return s_fonts.add(hyp::Font::create(path));
+}
+
+hyp::Font* hyp::Resources::getFont(FontHandle handle) {
+	return s_fonts.get(handle);
+}
+
+void hyp::Resources::releaseFont(FontHandle handle) {
+	if (handle == s_defaultFont) s_defaultFont = {};
+	s_fonts.release(handle, s_frame);
+}
+
+hyp::FontHandle hyp::Resources::getDefaultFont() {
+	if (!s_fonts.isValid(s_defaultFont))
+	{
+		s_defaultFont = loadFont(hyp::Font::DefaultPath);
+		HYP_INFO("Loaded engine's default font");
+	}
+
+	return s_defaultFont;
+}
+
+void hyp::Resources::preloadTexture(const std::string& path) {
+	if (s_textureLoads.count(path)) return;
+
+	auto image = hyp::CreateRef<hyp::ImageData>();
+	hyp::JobHandle job = hyp::JobSystem::schedule([image, path]() {
+		HYP_PROFILE_ASSET(path);
+		hyp::Texture::decode(path, *image);
+	});
+
+	s_textureLoads[path] = { job, image };
+}
+
+void hyp::Resources::preloadFont(const std::string& path) {
+	if (s_fontLoads.count(path)) return;
+
+	auto atlas = hyp::CreateRef<hyp::FontAtlas>();
+	hyp::JobHandle job = hyp::JobSystem::schedule([atlas, path]() {
+		HYP_PROFILE_ASSET(path);
+		hyp::Font::rasterize(path, *atlas);
+	});
+
+	s_fontLoads[path] = { job, atlas };
+}
+
+void hyp::Resources::newFrame() {
+	s_frame++;
+	s_textures.collect(s_frame);
+	s_fonts.collect(s_frame);
+}
+
+void hyp::Resources::deinit() {
+	for (auto& [path, load] : s_textureLoads) hyp::JobSystem::wait(load.job);
+	for (auto& [path, load] : s_fontLoads) hyp::JobSystem::wait(load.job);
+	s_textureLoads.clear();
+	s_fontLoads.clear();
+
+	s_textures.clear();
+	s_fonts.clear();
+	s_defaultFont = {};
+}
+
+const hyp::ResourceRegistry<hyp::Texture2D>& hyp::Resources::getTextures() {
+	return s_textures;
+}
+
+const hyp::ResourceRegistry<hyp::Font>& hyp::Resources::getFonts() {
+	return s_fonts;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef HYP_RESOURCES_HPP
+	#define HYP_RESOURCES_HPP
+
+	#include <core/handle.hpp>
+	#include <renderer/font.hpp>
+	#include <renderer/texture.hpp>
+	#include <string>
+
+namespace hyp {
+
+	using TextureHandle = hyp::Handle<hyp::Texture2D>;
+	using FontHandle = hyp::Handle<hyp::Font>;
+
+	/**
+	* \brief engine-wide texture and font registries.
+	* The renderer takes handles, so per-draw resource references cost no atomic refcounting.
+	*/
+	class Resources {
+	public:
+		static TextureHandle addTexture(const hyp::Ref<hyp::Texture2D>& texture);
+		static TextureHandle loadTexture(const std::string& path);
+		static hyp::Texture2D* getTexture(TextureHandle handle);
+		static void releaseTexture(TextureHandle handle);
+
+		static FontHandle addFont(const hyp::Ref<hyp::Font>& font);
+		static FontHandle loadFont(const std::string& path);
+		static hyp::Font* getFont(FontHandle handle);
+		static void releaseFont(FontHandle handle);
+
+		static FontHandle getDefaultFont();
+
+		/**
+		* \brief starts decoding (rasterizing) the file on a worker thread; the next
+		* `loadTexture` (`loadFont`) of the same path waits for it and only does the GPU upload.
+		* Meant for startup, while the window and GL context are still being created.
+		*/
+		static void preloadTexture(const std::string& path);
+		static void preloadFont(const std::string& path);
+
+		/**
+		* \brief destroys the resources released a few frames ago, called once per frame by the Application
+		*/
+		static void newFrame();
+
+		static void deinit();
+
+		static const hyp::ResourceRegistry<hyp::Texture2D>& getTextures();
+		static const hyp::ResourceRegistry<hyp::Font>& getFonts();
+	};
+}
+
+#endif // !HYP_RESOURCES_HPP
@@ -1,16 +1,25 @@
 #include "shader.hpp"
 #include "utils/logger.hpp"
-#include <fstream>
+#include <io/file_system.hpp>
+#include <opengl/extensions.hpp>
+#include <string_view>
 
 using namespace hyp;
 
 namespace Helpers {
-	static bool compileShader(uint32_t& shader, const std::string& content, const SHADER_TYPE& shaderType) {
-		shader = glCreateShader(shaderType);
-		const char* source = content.c_str();
-		glShaderSource(shader, 1, &source, nullptr);
+	// only issues the compile, the status is read once the program is used (see ShaderProgram::resolve)
+	static uint32_t compileShader(std::string_view content, const SHADER_TYPE& shaderType) {
+		uint32_t shader = glCreateShader(shaderType);
+		// the source may be a view into a mapped archive, so pass its length rather than rely on a terminator
+		const char* source = content.data();
+		GLint length = (GLint)content.size();
+		glShaderSource(shader, 1, &source, &length);
 		glCompileShader(shader);
 
+		return shader;
+	}
+
+	static bool checkCompileStatus(uint32_t shader) {
 		int32_t compileStatus;
 
 		glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
@@ -18,8 +27,9 @@ namespace Helpers {
 		if (!compileStatus)
 		{
 			// Compilation failed
-			GLint infoLogLength;
+			GLint infoLogLength, shaderType;
 			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+			glGetShaderiv(shader, GL_SHADER_TYPE, &shaderType);
 			std::vector<GLchar> infoLog(infoLogLength);
 			glGetShaderInfoLog(shader, infoLogLength, NULL, infoLog.data());
 			// Print or handle the error
@@ -54,6 +64,11 @@ ShaderProgram::ShaderProgram() : m_isLinked(false) {
 }
 
 hyp::ShaderProgram::~ShaderProgram() {
+	for (uint32_t shader : m_shaders)
+	{
+		glDeleteShader(shader);
+	}
+
 	glDeleteProgram(m_program);
 }
 
@@ -64,72 +79,30 @@ hyp::Ref<ShaderProgram> hyp::ShaderProgram::create(const std::string& vertexPath
 hyp::ShaderProgram::ShaderProgram(const std::string& vertexPath, const std::string& fragmentPath) {
 	this->m_program = glCreateProgram();
 
-	std::string vertexCode;
-	std::string fragmentCode;
-	std::ifstream fragmentFile;
-	std::ifstream vertexFile;
-
-	vertexFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	fragmentFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	hyp::FileData vertexFile = hyp::FileSystem::read(vertexPath);
+	hyp::FileData fragmentFile = hyp::FileSystem::read(fragmentPath);
 
-	try
+	if (!vertexFile.isValid() || !fragmentFile.isValid())
 	{
-		vertexFile.open(vertexPath);
-		fragmentFile.open(fragmentPath);
-
-		if (!vertexFile.is_open() || !fragmentFile.is_open())
-		{
-			HYP_ERROR("Failed to open shader files");
-			return;
-		}
-
-		vertexFile.seekg(0, std::ios::end);
-		std::streampos vertexFileSize = vertexFile.tellg();
-		vertexFile.seekg(0, std::ios::beg);
-
-		if (vertexFileSize == 0)
-		{
-			HYP_ERROR("Vertex Shader File is Empty");
-			return;
-		}
-
-		fragmentFile.seekg(0, std::ios::end);
-		std::streampos fragmentFileSize = fragmentFile.tellg();
-		fragmentFile.seekg(0, std::ios::beg);
-
-		if (fragmentFileSize == 0)
-		{
-			HYP_ERROR("Fragment Shader File is Empty");
-			return;
-		}
-
-		std::stringstream vShaderStream, fShaderStream;
-
-		vShaderStream << vertexFile.rdbuf();
-		fShaderStream << fragmentFile.rdbuf();
-		fragmentFile.close();
-		vertexFile.close();
-
-		vertexCode = vShaderStream.str();
-		fragmentCode = fShaderStream.str();
+		HYP_ERROR("Failed to open shader files");
+		return;
 	}
-	catch (std::ifstream::failure e)
+
+	if (vertexFile.size() == 0)
 	{
-		HYP_ERROR("Shader file not successfully read");
+		HYP_ERROR("Vertex Shader File is Empty");
 		return;
-	};
-
-	uint32_t vshader, fshader;
-
-	bool vshaderStatus = Helpers::compileShader(vshader, vertexCode, SHADER_TYPE::VERTEX);
-	bool fshaderStatus = Helpers::compileShader(fshader, fragmentCode, SHADER_TYPE::FRAGMENT);
+	}
 
-	if (!vshaderStatus || !fshaderStatus)
+	if (fragmentFile.size() == 0)
 	{
-		HYP_WARN("Didn't create a shader program because there was a compilation error");
+		HYP_ERROR("Fragment Shader File is Empty");
 		return;
 	}
 
+	uint32_t vshader = Helpers::compileShader(vertexFile.getText(), SHADER_TYPE::VERTEX);
+	uint32_t fshader = Helpers::compileShader(fragmentFile.getText(), SHADER_TYPE::FRAGMENT);
+
 	this->attachShader(vshader);
 	this->attachShader(fshader);
 }
@@ -142,6 +115,7 @@ void hyp::ShaderProgram::attachShader(uint32_t& shader) {
 	}
 
 	glAttachShader(m_program, shader);
+	m_shaders.push_back(shader);
 }
 
 int hyp::ShaderProgram::getLocation(const std::string& name) {
@@ -152,6 +126,8 @@ int hyp::ShaderProgram::getLocation(const std::string& name) {
 		return it->second;
 	}
 
+	resolve();
+
 	int32_t location = glGetUniformLocation(this->m_program, name.c_str());
 
 	m_locations.insert({ name, location });
@@ -166,6 +142,8 @@ int hyp::ShaderProgram::getBlockIndex(const std::string& name) {
 		return it->second;
 	}
 
+	resolve();
+
 	int32_t location = glGetUniformBlockIndex(m_program, name.c_str());
 
 	m_locations.insert({ name, location });
@@ -181,7 +159,57 @@ void ShaderProgram::link() {
 	this->m_isLinked = true;
 }
 
+bool hyp::ShaderProgram::isReady() const {
+	if (!m_isLinked) return false;
+	if (m_isResolved || !hyp::OpenglExtensions::hasParallelShaderCompile()) return true;
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+void hyp::ShaderProgram::resolve() {
+	if (m_isResolved || !m_isLinked) return;
+	m_isResolved = true;
+
+	// the first status query blocks until the driver is done compiling and linking
+	GLint linkStatus = GL_FALSE;
+	glGetProgramiv(m_program, GL_LINK_STATUS, &linkStatus);
+
+	if (!linkStatus)
+	{
+		bool compiled = true;
+		for (uint32_t shader : m_shaders)
+		{
+			compiled &= Helpers::checkCompileStatus(shader);
+		}
+
+		if (compiled)
+		{
+			GLint infoLogLength;
+			glGetProgramiv(m_program, GL_INFO_LOG_LENGTH, &infoLogLength);
+			std::vector<GLchar> infoLog(infoLogLength);
+			glGetProgramInfoLog(m_program, infoLogLength, NULL, infoLog.data());
+			HYP_ERROR("Shader Program Linking Failed\nError:\n");
+			HYP_ERROR(std::string(infoLog.data(), infoLog.size()));
+		}
+		else
+		{
+			HYP_WARN("Didn't create a shader program because there was a compilation error");
+		}
+	}
+
+	// the linked program keeps its own copy of the binaries
+	for (uint32_t shader : m_shaders)
+	{
+		glDetachShader(m_program, shader);
+		glDeleteShader(shader);
+	}
+	m_shaders.clear();
+}
+
 void ShaderProgram::use() {
+	resolve();
 	glUseProgram(this->m_program);
 }
 
@@ -226,5 +254,6 @@ void hyp::ShaderProgram::setMat4(const std::string& name, const glm::mat4& value
 }
 
 void hyp::ShaderProgram::setBlockBinding(const std::string& name, uint32_t blockBinding) {
+	resolve();
 	glUniformBlockBinding(m_program, getBlockIndex(name), blockBinding);
 }
@@ -27,9 +27,16 @@ namespace hyp {
 		static hyp::Ref<ShaderProgram> create(const std::string& vertexPath, const std::string& fragmentPath);
 
 	public:
+		/**
+		* \brief issues the link without waiting for it; compile and link errors are reported
+		* the first time the program is used, so several programs can build in parallel
+		*/
 		void link();
 		void use();
 
+		/** \brief non-blocking: true once the driver has finished compiling and linking */
+		bool isReady() const;
+
 		void setInt(const std::string& name, int value);
 		void setFloat(const std::string& name, float value);
 		void setBool(const std::string& name, bool value) {
@@ -48,12 +55,15 @@ namespace hyp {
 
 	private:
 		void attachShader(uint32_t& shader);
+		void resolve();
 		int getLocation(const std::string& name);
 		int getBlockIndex(const std::string& name);
 
 	private:
 		std::unordered_map<std::string, int> m_locations;
+		std::vector<uint32_t> m_shaders;
 		bool m_isLinked = false;
+		bool m_isResolved = false;
 		unsigned int m_program;
 	};
 };
@@ -0,0 +1,194 @@
+#include "text_document.hpp"
+#include <debug/memory_tracker.hpp>
+#include <debug/metrics.hpp>
+#include <algorithm>
+#include <cmath>
+
+hyp::TextDocument::TextDocument(const hyp::Ref<hyp::Font>& font, float fontSize)
+    : m_fontSize(fontSize) {
+	setFont(font);
+}
+
+void hyp::TextDocument::setFont(const hyp::Ref<hyp::Font>& font) {
+	m_font = font ? font : hyp::Font::getDefault();
+	m_layoutVersion++;
+	updateMetrics();
+}
+
+void hyp::TextDocument::setFontSize(float fontSize) {
+	m_fontSize = fontSize;
+	m_layoutVersion++;
+	updateMetrics();
+}
+
+void hyp::TextDocument::setLeading(float leading) {
+	// only moves the lines, the glyphs of a line stay the same
+	m_leading = leading;
+	updateMetrics();
+}
+
+void hyp::TextDocument::setText(const std::string& text, const glm::vec4& color) {
+	m_lines.clear();
+	appendLines(text, color);
+}
+
+void hyp::TextDocument::appendLines(const std::string& text, const glm::vec4& color) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+	size_t start = 0;
+	while (true)
+	{
+		size_t end = text.find('\n', start);
+		Line& line = m_lines.emplace_back();
+		line.text = text.substr(start, end == std::string::npos ? std::string::npos : end - start);
+		line.color = color;
+
+		if (end == std::string::npos) break;
+		start = end + 1;
+	}
+
+	trim();
+}
+
+void hyp::TextDocument::insertLine(size_t index, const std::string& text, const glm::vec4& color) {
+	HYP_ASSERT_CORE(index <= m_lines.size(), "TextDocument::insertLine out of range");
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+
+	Line line;
+	line.text = text;
+	line.color = color;
+	m_lines.insert(m_lines.begin() + index, std::move(line));
+
+	trim();
+}
+
+void hyp::TextDocument::setLine(size_t index, const std::string& text) {
+	HYP_ASSERT_CORE(index < m_lines.size(), "TextDocument::setLine out of range");
+	Line& line = m_lines[index];
+	line.text = text;
+	line.layoutVersion = 0;
+}
+
+void hyp::TextDocument::setLineColor(size_t index, const glm::vec4& color) {
+	HYP_ASSERT_CORE(index < m_lines.size(), "TextDocument::setLineColor out of range");
+	m_lines[index].color = color;
+}
+
+void hyp::TextDocument::removeLines(size_t first, size_t count) {
+	if (first >= m_lines.size()) return;
+	count = std::min(count, m_lines.size() - first);
+	m_lines.erase(m_lines.begin() + first, m_lines.begin() + first + count);
+}
+
+void hyp::TextDocument::clear() {
+	m_lines.clear();
+}
+
+void hyp::TextDocument::setMaxLines(size_t count) {
+	m_maxLines = count;
+	trim();
+}
+
+void hyp::TextDocument::trim() {
+	if (m_maxLines == 0 || m_lines.size() <= m_maxLines) return;
+	m_lines.erase(m_lines.begin(), m_lines.begin() + (m_lines.size() - m_maxLines));
+}
+
+float hyp::TextDocument::getLineWidth(size_t index) {
+	return layout(index).width;
+}
+
+bool hyp::TextDocument::getVisibleLines(float minY, float maxY, size_t& first, size_t& last) const {
+	if (m_lines.empty() || m_lineAdvance <= 0.f) return false;
+
+	// line i covers [i * advance + m_glyphMin.y, i * advance + m_glyphMax.y]
+	float from = std::ceil((minY - m_glyphMax.y) / m_lineAdvance);
+	float to = std::floor((maxY - m_glyphMin.y) / m_lineAdvance);
+	if (to < 0.f || from > (float)(m_lines.size() - 1) || from > to) return false;
+
+	first = (size_t)std::max(from, 0.f);
+	last = (size_t)std::min(to, (float)(m_lines.size() - 1));
+	return true;
+}
+
+void hyp::TextDocument::updateMetrics() {
+	m_lineAdvance = 0.f;
+	m_glyphMin = m_glyphMax = glm::vec2(0.f);
+
+	if (!m_font || !m_font->getFontData()) return;
+
+	const auto& fontGeometry = m_font->getFontData();
+	const auto& metrics = fontGeometry->getMetrics();
+	if (metrics.ascender == metrics.descender) return;
+
+	float fontScalingFactor = 1.f / (metrics.ascender - metrics.descender);
+	m_lineAdvance = fontScalingFactor * m_fontSize * metrics.lineHeight + m_leading;
+
+	// conservative bounds for culling, the fonts only hold ASCII glyphs
+	for (const auto& [ch, glyph] : fontGeometry->glyphs)
+	{
+		glm::vec2 quadMin, quadMax;
+		glyph.getQuadPlaneBounds(quadMin, quadMax, m_fontSize);
+		m_glyphMin = glm::min(m_glyphMin, quadMin * fontScalingFactor);
+		m_glyphMax = glm::max(m_glyphMax, quadMax * fontScalingFactor);
+	}
+}
+
+const hyp::TextDocument::Line& hyp::TextDocument::layout(size_t index) {
+	Line& line = m_lines[index];
+	if (line.layoutVersion == m_layoutVersion) return line;
+
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Renderer);
+	line.glyphs.clear();
+	line.width = 0.f;
+	line.layoutVersion = m_layoutVersion;
+	m_layoutCount++;
+
+	static hyp::Counter& s_layouts = hyp::Metrics::counter("renderer.text_line_layouts");
+	s_layouts.add();
+
+	const auto& fontGeometry = m_font ? m_font->getFontData() : nullptr;
+	hyp::Texture2D* fontAtlas = m_font ? m_font->getAtlasTexture().get() : nullptr;
+	if (!fontGeometry || !fontAtlas) return line;
+
+	const auto& metrics = fontGeometry->getMetrics();
+	float fontScalingFactor = 1.f / (metrics.ascender - metrics.descender);
+	float texelWidth = 1.f / fontAtlas->getWidth();
+	float texelHeight = 1.f / fontAtlas->getHeight();
+
+	// same rules as Renderer2D::drawString
+	float x = 0.f;
+	for (char ch : line.text)
+	{
+		if (ch == '\r' || ch == '\n') continue;
+
+		if (ch == ' ' || ch == '\t')
+		{
+			hyp::Glyph* space = fontGeometry->getGlyph(' ');
+			float advance = space ? (float)space->getAdvance() : 0.f;
+			x += fontScalingFactor * advance * m_fontSize * (ch == '\t' ? 2.f : 1.f);
+			continue;
+		}
+
+		auto glyph = fontGeometry->getGlyph(ch);
+		if (!glyph)
+			glyph = fontGeometry->getGlyph((uint8_t)127);
+		if (!glyph) continue;
+
+		GlyphQuad quad;
+		quad.pen = x;
+
+		glyph->getQuadAtlasBounds(quad.uvMin, quad.uvMax);
+		quad.uvMin *= glm::vec2(texelWidth, texelHeight);
+		quad.uvMax *= glm::vec2(texelWidth, texelHeight);
+
+		glyph->getQuadPlaneBounds(quad.min, quad.max, m_fontSize);
+		quad.min = quad.min * fontScalingFactor + glm::vec2(x, 0.f);
+		quad.max = quad.max * fontScalingFactor + glm::vec2(x, 0.f);
+
+		line.glyphs.push_back(quad);
+		x += fontScalingFactor * glyph->advance.x * m_fontSize;
+	}
+
+	line.width = x;
+	return line;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef HYP_TEXT_DOCUMENT_HPP
+	#define HYP_TEXT_DOCUMENT_HPP
+
+	#include <glm/glm.hpp>
+	#include <renderer/font.hpp>
+	#include <deque>
+	#include <string>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief a block of text too long to be laid out every frame (log consoles, chat, credits).
+	*
+	* The text is kept as lines that cache their glyph quads. Editing a line only marks it, it is laid
+	* out again the next time it is drawn; font changes invalidate every line at once. Renderer2D::drawTextDocument
+	* only visits the lines, and the glyphs of a line, crossing the view, so a frame costs what is on screen
+	* whatever the length of the document.
+	*
+	* Lines use the space of Renderer2D::drawString: line i has its baseline at y = i * getLineAdvance()
+	* and starts at x = 0, before the transform.
+	*/
+	class TextDocument {
+	public:
+		TextDocument(const hyp::Ref<hyp::Font>& font = nullptr, float fontSize = 48.f);
+
+		// the engine's default font when null
+		void setFont(const hyp::Ref<hyp::Font>& font);
+		void setFontSize(float fontSize);
+		void setLeading(float leading);
+
+		const hyp::Ref<hyp::Font>& getFont() const { return m_font; }
+		float getFontSize() const { return m_fontSize; }
+		float getLeading() const { return m_leading; }
+
+		/**
+		* \brief replaces the content, one line per '\n' separated part of `text`
+		*/
+		void setText(const std::string& text, const glm::vec4& color = glm::vec4(1.f));
+		void appendLines(const std::string& text, const glm::vec4& color = glm::vec4(1.f));
+
+		void insertLine(size_t index, const std::string& text, const glm::vec4& color = glm::vec4(1.f));
+		void setLine(size_t index, const std::string& text);
+		// colours are applied when drawing, no layout needed
+		void setLineColor(size_t index, const glm::vec4& color);
+		void removeLines(size_t first, size_t count = 1);
+		void clear();
+
+		/**
+		* \brief keeps at most `count` lines, dropping the oldest (first) ones; 0 keeps everything
+		*/
+		void setMaxLines(size_t count);
+
+		size_t getLineCount() const { return m_lines.size(); }
+		const std::string& getLine(size_t index) const { return m_lines[index].text; }
+		const glm::vec4& getLineColor(size_t index) const { return m_lines[index].color; }
+
+		float getLineAdvance() const { return m_lineAdvance; }
+		float getHeight() const { return m_lineAdvance * (float)m_lines.size(); }
+		// lays the line out when needed
+		float getLineWidth(size_t index);
+
+		/**
+		* \brief lines [first, last] whose glyphs may cross the band minY <= y <= maxY, false when there are none
+		*/
+		bool getVisibleLines(float minY, float maxY, size_t& first, size_t& last) const;
+
+		// lines laid out since the document was created
+		uint64_t getLayoutCount() const { return m_layoutCount; }
+
+	private:
+		struct GlyphQuad
+		{
+			float pen; // x of the glyph's origin, increasing along the line
+			glm::vec2 min;
+			glm::vec2 max;
+			glm::vec2 uvMin;
+			glm::vec2 uvMax;
+		};
+
+		struct Line
+		{
+			std::string text;
+			glm::vec4 color { 1.f };
+
+			std::vector<GlyphQuad> glyphs;
+			float width = 0.f;
+			uint32_t layoutVersion = 0; // laid out again when it differs from the document's
+		};
+
+		const Line& layout(size_t index);
+		void updateMetrics();
+		void trim();
+
+	private:
+		friend class Renderer2D;
+
+		hyp::Ref<hyp::Font> m_font;
+		float m_fontSize;
+		float m_leading = 0.f;
+
+		std::deque<Line> m_lines;
+		size_t m_maxLines = 0;
+		uint32_t m_layoutVersion = 1;
+		uint64_t m_layoutCount = 0;
+
+		// from the font and size, see updateMetrics
+		float m_lineAdvance = 0.f;
+		glm::vec2 m_glyphMin { 0.f }; // bounds of every glyph of the font around its origin
+		glm::vec2 m_glyphMax { 0.f };
+	};
+}
+
+#endif // !HYP_TEXT_DOCUMENT_HPP
@@ -1,6 +1,11 @@
 #include "texture.hpp"
 #include <utils/logger.hpp>
 #include <utils/assert.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <debug/metrics.hpp>
+#include <io/file_system.hpp>
+#include <cstring>
 
 namespace utils {
 	static uint32_t toGlFormat(const hyp::TextureFormat& format) {
@@ -47,6 +52,22 @@ namespace utils {
 		HYP_ASSERT(false);
 		return 0;
 	}
+
+	static size_t computeGpuSize(uint32_t internalFormat, uint32_t width, uint32_t height, bool mipmap) {
+		size_t bytesPerPixel = 4;
+		switch (internalFormat)
+		{
+		case GL_R8: bytesPerPixel = 1; break;
+		case GL_RGB8: bytesPerPixel = 3; break;
+		case GL_RGBA8: bytesPerPixel = 4; break;
+		case GL_RGBA32F: bytesPerPixel = 16; break;
+		default: break;
+		}
+
+		size_t size = (size_t)width * height * bytesPerPixel;
+		// a full mip chain adds roughly a third of the base level
+		return mipmap ? size + size / 3 : size;
+	}
 }
 
 hyp::Texture::Texture(const TextureSpecification& spec) {
@@ -61,45 +82,95 @@ hyp::Texture::Texture(const TextureSpecification& spec) {
 	glGenTextures(1, &m_texture);
 	glBindTexture(GL_TEXTURE_2D, m_texture);
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	GLint wrap = spec.repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_dataFormat, GL_UNSIGNED_BYTE, nullptr);
+
+	m_gpuSize = utils::computeGpuSize(m_internalFormat, m_width, m_height, spec.mipmap);
+	hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::Texture, m_gpuSize);
 }
 
 hyp::Texture::Texture(const std::string& path)
-    : m_path(path), m_texture(0),
+    : m_path(path), m_texture(0), m_width(0), m_height(0),
       m_internalFormat(0), m_dataFormat(0) {
-	int width, height, channels;
-	unsigned char* pixels;
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+	HYP_PROFILE_ASSET(path);
 
-	stbi_set_flip_vertically_on_load(1);
-	pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+	ImageData image;
+	if (!decode(path, image))
+	{
+		return;
+	}
 
-	m_width = width;
-	m_height = height;
+	upload(image);
+}
 
-	m_spec.height = height;
-	m_spec.width = width;
-	m_spec.mipmap = true;
+hyp::Texture::Texture(const ImageData& image, const std::string& path)
+    : m_path(path), m_texture(0), m_width(0), m_height(0),
+      m_internalFormat(0), m_dataFormat(0) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
 
-	int dataFormat = 0, internalFormat = 0;
+	if (!image.isValid())
+	{
+		return;
+	}
+
+	upload(image);
+}
+
+bool hyp::Texture::decode(const std::string& path, ImageData& image) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Assets);
+
+	hyp::FileData file = hyp::FileSystem::read(path);
+	if (!file.isValid())
+	{
+		return false;
+	}
+
+	int width, height, channels;
+	// the flip flag of stb_image is global, flip by hand so decoding stays thread-safe
+	unsigned char* pixels = stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &channels, 0);
 
 	if (!pixels)
 	{
-		return;
+		return false;
 	}
 
-	m_loaded = true;
+	size_t rowSize = (size_t)width * channels;
+	image.width = width;
+	image.height = height;
+	image.channels = channels;
+	image.pixels = std::make_unique<unsigned char[]>(rowSize * height);
+
+	for (int y = 0; y < height; y++)
+	{
+		std::memcpy(image.pixels.get() + rowSize * y, pixels + rowSize * (height - 1 - y), rowSize);
+	}
+
+	stbi_image_free(pixels);
+	return true;
+}
+
+void hyp::Texture::upload(const ImageData& image) {
+	m_width = image.width;
+	m_height = image.height;
+
+	m_spec.height = image.height;
+	m_spec.width = image.width;
+	m_spec.mipmap = true;
+
+	int dataFormat = 0, internalFormat = 0;
 
-	if (channels == 4)
+	if (image.channels == 4)
 	{
 		internalFormat = GL_RGBA8;
 		dataFormat = GL_RGBA;
 	}
-	else if (channels == 3)
+	else if (image.channels == 3)
 	{
 		internalFormat = GL_RGB8;
 		dataFormat = GL_RGB;
@@ -111,7 +182,6 @@ hyp::Texture::Texture(const std::string& path)
 	if (!(dataFormat & internalFormat))
 	{
 		HYP_ERROR("Image format not supported");
-		stbi_image_free(pixels);
 		m_loaded = false;
 		return;
 	}
@@ -125,14 +195,22 @@ hyp::Texture::Texture(const std::string& path)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, pixels);
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_width, m_height, 0, dataFormat, GL_UNSIGNED_BYTE, image.pixels.get());
+	hyp::Metrics::recordGpuUpload((size_t)m_width * m_height * image.channels);
 
 	glGenerateMipmap(GL_TEXTURE_2D);
-	stbi_image_free(pixels);
+
+	m_gpuSize = utils::computeGpuSize(m_internalFormat, m_width, m_height, true);
+	hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::Texture, m_gpuSize);
 }
 
 hyp::Texture::~Texture() {
 	glDeleteTextures(1, &m_texture);
+
+	if (m_gpuSize)
+	{
+		hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::Texture, m_gpuSize);
+	}
 }
 
 hyp::Ref<hyp::Texture> hyp::Texture::create(const hyp::TextureSpecification& spec) {
@@ -160,6 +238,7 @@ void hyp::Texture::setData(void* pixels, uint32_t size) {
 
 	glBindTexture(GL_TEXTURE_2D, m_texture);
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, m_dataFormat, GL_UNSIGNED_BYTE, pixels);
+	hyp::Metrics::recordGpuUpload(size);
 	if (m_spec.mipmap)
 	{
 		glGenerateMipmap(GL_TEXTURE_2D);
@@ -26,12 +26,31 @@ namespace hyp {
 		uint32_t width = 1;
 		uint32_t height = 1;
 		bool mipmap = true;
+		bool repeat = true; // clamped to the edge otherwise, e.g. for render targets
+	};
+
+	/**
+	* \brief decoded pixels of an image file, already flipped for OpenGL.
+	* Decoding touches no GL state, so it may run on any thread.
+	*/
+	struct ImageData
+	{
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		hyp::Unique<unsigned char[]> pixels;
+
+		bool isValid() const { return pixels != nullptr; }
 	};
 
 	class HYPER_API Texture {
 	public:
 		Texture(const TextureSpecification& spec);
 		Texture(const std::string& path);
+		/**
+		* \brief uploads already decoded pixels, must be called on the main thread
+		*/
+		Texture(const ImageData& image, const std::string& path = "");
 
 		~Texture();
 
@@ -39,6 +58,8 @@ namespace hyp {
 		static hyp::Ref<Texture> create(const TextureSpecification& spec);
 		static hyp::Ref<Texture> create(const std::string& path);
 
+		static bool decode(const std::string& path, ImageData& image);
+
 	public:
 		uint32_t getWidth() const {
 			return m_width;
@@ -69,6 +90,9 @@ namespace hyp {
 			return m_loaded;
 		}
 
+	private:
+		void upload(const ImageData& image);
+
 	private:
 		TextureSpecification m_spec;
 
@@ -76,6 +100,7 @@ namespace hyp {
 		uint32_t m_width, m_height;
 		std::string m_path;
 		bool m_loaded = false;
+		size_t m_gpuSize = 0;
 
 		unsigned int m_internalFormat, m_dataFormat;
 	};
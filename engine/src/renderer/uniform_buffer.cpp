@@ -1,23 +1,21 @@
 #include "uniform_buffer.hpp"
+#include <debug/memory_tracker.hpp>
 
-hyp::UniformBuffer::UniformBuffer(uint32_t size, uint32_t binding) {
-	glGenBuffers(1, &m_bufferId);
-	glBindBuffer(GL_UNIFORM_BUFFER, m_bufferId);
-	glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
-	glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_bufferId);
+hyp::UniformBuffer::UniformBuffer(uint32_t size, uint32_t binding, hyp::GpuBufferUsage usage) : m_size(size) {
+	m_range = hyp::GpuMemory::allocate(hyp::GpuBufferKind::Uniform, size, usage);
+	glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_range.buffer, m_range.offset, size);
+	hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::UniformBuffer, m_size);
 }
 
 hyp::UniformBuffer::~UniformBuffer() {
-	glDeleteBuffers(1, &m_bufferId);
+	hyp::GpuMemory::release(m_range);
+	hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::UniformBuffer, m_size);
 }
 
-hyp::Shared<hyp::UniformBuffer> hyp::UniformBuffer::create(uint32_t size, uint32_t binding) {
-	return hyp::CreateRef<UniformBuffer>(size, binding);
+hyp::Shared<hyp::UniformBuffer> hyp::UniformBuffer::create(uint32_t size, uint32_t binding, hyp::GpuBufferUsage usage) {
+	return hyp::CreateRef<UniformBuffer>(size, binding, usage);
 }
 
 void hyp::UniformBuffer::setData(const void* data, uint32_t size, uint32_t offset) {
-	glBindBuffer(GL_UNIFORM_BUFFER, m_bufferId);
-	glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	hyp::GpuMemory::upload(m_range, data, size, offset);
 }
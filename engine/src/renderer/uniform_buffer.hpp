@@ -4,23 +4,28 @@
 
 	#include <glad/glad.h>
 	#include <core/base.hpp>
+	#include <renderer/gpu_memory.hpp>
 	#include <cstdint>
 
 namespace hyp {
 	class UniformBuffer {
 	public:
-		UniformBuffer(uint32_t size, uint32_t binding);
+		// the renderer rewrites its uniforms every frame or flush, hence streamed by default
+		UniformBuffer(uint32_t size, uint32_t binding, hyp::GpuBufferUsage usage = hyp::GpuBufferUsage::Stream);
 
 		~UniformBuffer();
 
 	public:
-		static hyp::Shared<UniformBuffer> create(uint32_t size, uint32_t binding);
+		static hyp::Shared<UniformBuffer> create(uint32_t size, uint32_t binding, hyp::GpuBufferUsage usage = hyp::GpuBufferUsage::Stream);
 
 	public:
 		void setData(const void* data, uint32_t size, uint32_t offset = 0);
 
+		uint32_t getSize() const { return m_size; }
+
 	private:
-		uint32_t m_bufferId;
+		hyp::GpuRange m_range;
+		uint32_t m_size = 0;
 	};
 }
 
@@ -60,6 +60,12 @@ void VertexArray::unbind() {
 
 void VertexArray::addVertexBuffer(const Ref<VertexBuffer>& vbuffer) {
 	HYP_ASSERT_CORE(vbuffer->getLayout().getAttributes().size() != 0, "vertex buffer has no layout");
+	this->bind();
+	vbuffer->bind();
+
+	// the range of a vertex buffer is fixed for its lifetime, so its offset in the shared GL buffer
+	// is baked into the attribute pointers once
+	const size_t base = vbuffer->getOffset();
 
 	const auto& layout = vbuffer->getLayout();
 	for (const auto& attribute : layout)
@@ -77,7 +83,7 @@ void VertexArray::addVertexBuffer(const Ref<VertexBuffer>& vbuffer) {
 			    m_vbufferIndex, attribute.getComponentCount(),
 			    Utils::MapShaderDataTypeToOpenGL(attribute.type),
 			    layout.getStride(),
-			    (const void*)attribute.offset);
+			    (const void*)(base + attribute.offset));
 			m_vbufferIndex++;
 			break;
 		}
@@ -92,7 +98,7 @@ void VertexArray::addVertexBuffer(const Ref<VertexBuffer>& vbuffer) {
 			    Utils::MapShaderDataTypeToOpenGL(attribute.type),
 			    attribute.normalized ? GL_TRUE : GL_FALSE,
 			    layout.getStride(),
-			    (const void*)attribute.offset);
+			    (const void*)(base + attribute.offset));
 			m_vbufferIndex++;
 			break;
 		}
@@ -109,7 +115,7 @@ void VertexArray::addVertexBuffer(const Ref<VertexBuffer>& vbuffer) {
 				    Utils::MapShaderDataTypeToOpenGL(attribute.type),
 				    attribute.normalized ? GL_TRUE : GL_FALSE,
 				    layout.getStride(),
-				    (const void*)(attribute.offset + sizeof(float) * i * count));
+				    (const void*)(base + attribute.offset + sizeof(float) * i * count));
 				glVertexAttribDivisor(m_vbufferIndex, 1);
 				m_vbufferIndex++;
 			}
@@ -1,15 +1,17 @@
 #include "vertex_buffer.hpp"
+#include <debug/memory_tracker.hpp>
 
 namespace hyp {
 
-	VertexBuffer::VertexBuffer(uint32_t size) {
-		glGenBuffers(1, &m_rendererId);
-		this->bind();
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	VertexBuffer::VertexBuffer(uint32_t size) : m_size(size) {
+		// created empty to be refilled every flush (batches, render lists)
+		m_range = hyp::GpuMemory::allocate(hyp::GpuBufferKind::Vertex, size, hyp::GpuBufferUsage::Stream);
+		hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::VertexBuffer, m_size);
 	}
 
 	VertexBuffer::~VertexBuffer() {
-		glDeleteBuffers(1, &m_rendererId);
+		hyp::GpuMemory::release(m_range);
+		hyp::MemoryTracker::onGpuFree(hyp::GpuResourceType::VertexBuffer, m_size);
 	}
 
 	hyp::Shared<hyp::VertexBuffer> VertexBuffer::create(uint32_t size) {
@@ -20,19 +22,18 @@ namespace hyp {
 		return hyp::CreateRef<hyp::VertexBuffer>(vertices, size);
 	}
 
-	VertexBuffer::VertexBuffer(float* vertices, uint32_t size) {
-		glGenBuffers(1, &m_rendererId);
-		this->bind();
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+	VertexBuffer::VertexBuffer(float* vertices, uint32_t size) : m_size(size) {
+		m_range = hyp::GpuMemory::allocate(hyp::GpuBufferKind::Vertex, size);
+		hyp::GpuMemory::upload(m_range, vertices, size);
+		hyp::MemoryTracker::onGpuAllocate(hyp::GpuResourceType::VertexBuffer, m_size);
 	}
 
 	void VertexBuffer::setData(void* vertices, uint32_t size) {
-		this->bind();
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
+		hyp::GpuMemory::upload(m_range, vertices, size);
 	}
 
 	void VertexBuffer::bind() {
-		glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
+		glBindBuffer(GL_ARRAY_BUFFER, m_range.buffer);
 	}
 
 	void VertexBuffer::unbind() {
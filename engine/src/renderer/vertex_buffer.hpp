@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 #include <cstdint>
 #include "renderer/buffer.hpp"
+#include "renderer/gpu_memory.hpp"
 
 namespace hyp {
 	class VertexBuffer {
@@ -29,9 +30,14 @@ namespace hyp {
 			m_layout = layout;
 		};
 
+		uint32_t getSize() const { return m_size; }
+		// byte offset of the vertices in the shared GL buffer
+		uint32_t getOffset() const { return m_range.offset; }
+
 	private:
 		BufferLayout m_layout;
-		uint32_t m_rendererId;
+		hyp::GpuRange m_range;
+		uint32_t m_size = 0;
 	};
 
 };
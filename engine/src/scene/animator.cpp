@@ -0,0 +1,529 @@
+#include "animator.hpp"
+#include <debug/flight_recorder.hpp>
+#include <debug/metrics.hpp>
+#include <scene/components.hpp>
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define HYP_ANIMATOR_SSE 1
+	#include <xmmintrin.h>
+#endif
+
+namespace {
+	// raw pointers into a lane, so the evaluation loops don't go through std::vector
+	struct LaneView
+	{
+		size_t count;
+		float* elapsed;
+		const float* invDuration;
+		const float* from[4];
+		const float* delta[4];
+		float* value[4];
+	};
+
+#ifdef HYP_ANIMATOR_SSE
+	inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+#endif
+
+	// every easing maps [0, 1] to [0, 1] (BackOut overshoots in between), once scalar and once for 4 lanes
+	struct EaseLinear
+	{
+		static float eval(float t) { return t; }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) { return t; }
+#endif
+	};
+
+	struct EaseQuadIn
+	{
+		static float eval(float t) { return t * t; }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) { return _mm_mul_ps(t, t); }
+#endif
+	};
+
+	struct EaseQuadOut
+	{
+		static float eval(float t) { return t * (2.f - t); }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) { return _mm_mul_ps(t, _mm_sub_ps(_mm_set1_ps(2.f), t)); }
+#endif
+	};
+
+	struct EaseQuadInOut
+	{
+		static float eval(float t) { return t < 0.5f ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t; }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) {
+			__m128 in = _mm_mul_ps(_mm_set1_ps(2.f), _mm_mul_ps(t, t));
+			__m128 out = _mm_add_ps(_mm_set1_ps(-1.f), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(4.f), _mm_add_ps(t, t)), t));
+			return select(_mm_cmplt_ps(t, _mm_set1_ps(0.5f)), in, out);
+		}
+#endif
+	};
+
+	struct EaseCubicIn
+	{
+		static float eval(float t) { return t * t * t; }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) { return _mm_mul_ps(t, _mm_mul_ps(t, t)); }
+#endif
+	};
+
+	struct EaseCubicOut
+	{
+		static float eval(float t) {
+			float u = t - 1.f;
+			return u * u * u + 1.f;
+		}
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) {
+			__m128 u = _mm_sub_ps(t, _mm_set1_ps(1.f));
+			return _mm_add_ps(_mm_mul_ps(u, _mm_mul_ps(u, u)), _mm_set1_ps(1.f));
+		}
+#endif
+	};
+
+	struct EaseCubicInOut
+	{
+		static float eval(float t) {
+			float u = 2.f * t - 2.f;
+			return t < 0.5f ? 4.f * t * t * t : 0.5f * u * u * u + 1.f;
+		}
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) {
+			__m128 in = _mm_mul_ps(_mm_set1_ps(4.f), _mm_mul_ps(t, _mm_mul_ps(t, t)));
+			__m128 u = _mm_sub_ps(_mm_add_ps(t, t), _mm_set1_ps(2.f));
+			__m128 out = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.5f), _mm_mul_ps(u, _mm_mul_ps(u, u))), _mm_set1_ps(1.f));
+			return select(_mm_cmplt_ps(t, _mm_set1_ps(0.5f)), in, out);
+		}
+#endif
+	};
+
+	struct EaseSmoothStep
+	{
+		static float eval(float t) { return t * t * (3.f - 2.f * t); }
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) { return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.f), _mm_add_ps(t, t))); }
+#endif
+	};
+
+	struct EaseBackOut
+	{
+		static constexpr float C1 = 1.70158f;
+		static constexpr float C3 = C1 + 1.f;
+
+		static float eval(float t) {
+			float u = t - 1.f;
+			return 1.f + C3 * u * u * u + C1 * u * u;
+		}
+#ifdef HYP_ANIMATOR_SSE
+		static __m128 eval(__m128 t) {
+			__m128 u = _mm_sub_ps(t, _mm_set1_ps(1.f));
+			__m128 u2 = _mm_mul_ps(u, u);
+			__m128 cubic = _mm_mul_ps(_mm_set1_ps(C3), _mm_mul_ps(u2, u));
+			return _mm_add_ps(_mm_set1_ps(1.f), _mm_add_ps(cubic, _mm_mul_ps(_mm_set1_ps(C1), u2)));
+		}
+#endif
+	};
+
+	// the component pools, looked up once per update instead of once per track
+	struct Targets
+	{
+		entt::basic_view<entt::entity, entt::exclude_t<>, hyp::TransformComponent> transforms;
+		entt::basic_view<entt::entity, entt::exclude_t<>, hyp::SpriteRendererComponent> sprites;
+		entt::basic_view<entt::entity, entt::exclude_t<>, hyp::CircleRendererComponent> circles;
+
+		Targets(entt::registry& registry)
+		    : transforms(registry.view<hyp::TransformComponent>()),
+		      sprites(registry.view<hyp::SpriteRendererComponent>()),
+		      circles(registry.view<hyp::CircleRendererComponent>()) {}
+
+		void write(entt::entity entity, hyp::AnimProperty property, const glm::vec4& value) {
+			switch (property)
+			{
+			case hyp::AnimProperty::Position:
+				if (transforms.contains(entity)) transforms.get(entity).position = glm::vec3(value);
+				break;
+			case hyp::AnimProperty::Size:
+				if (transforms.contains(entity)) transforms.get(entity).size = glm::vec2(value);
+				break;
+			case hyp::AnimProperty::Rotation:
+				if (transforms.contains(entity)) transforms.get(entity).rotation = value.x;
+				break;
+			case hyp::AnimProperty::SpriteColor:
+				if (sprites.contains(entity)) sprites.get(entity).color = value;
+				break;
+			case hyp::AnimProperty::CircleColor:
+				if (circles.contains(entity)) circles.get(entity).color = value;
+				break;
+			default: break;
+			}
+		}
+	};
+
+	template <typename E>
+	void evaluateLane(const LaneView& lane, float dt) {
+		size_t i = 0;
+
+#ifdef HYP_ANIMATOR_SSE
+		const __m128 step = _mm_set1_ps(dt);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		for (; i + 4 <= lane.count; i += 4)
+		{
+			__m128 elapsed = _mm_add_ps(_mm_loadu_ps(lane.elapsed + i), step);
+			_mm_storeu_ps(lane.elapsed + i, elapsed);
+
+			__m128 t = _mm_mul_ps(elapsed, _mm_loadu_ps(lane.invDuration + i));
+			__m128 e = E::eval(_mm_min_ps(_mm_max_ps(t, zero), one));
+
+			for (int c = 0; c < 4; c++)
+			{
+				__m128 value = _mm_add_ps(_mm_loadu_ps(lane.from[c] + i), _mm_mul_ps(_mm_loadu_ps(lane.delta[c] + i), e));
+				_mm_storeu_ps(lane.value[c] + i, value);
+			}
+		}
+#endif
+
+		for (; i < lane.count; i++)
+		{
+			lane.elapsed[i] += dt;
+			float e = E::eval(std::clamp(lane.elapsed[i] * lane.invDuration[i], 0.f, 1.f));
+
+			for (int c = 0; c < 4; c++)
+			{
+				lane.value[c][i] = lane.from[c][i] + lane.delta[c][i] * e;
+			}
+		}
+	}
+
+	float ease(hyp::Ease ease, float t) {
+		switch (ease)
+		{
+		case hyp::Ease::QuadIn: return EaseQuadIn::eval(t);
+		case hyp::Ease::QuadOut: return EaseQuadOut::eval(t);
+		case hyp::Ease::QuadInOut: return EaseQuadInOut::eval(t);
+		case hyp::Ease::CubicIn: return EaseCubicIn::eval(t);
+		case hyp::Ease::CubicOut: return EaseCubicOut::eval(t);
+		case hyp::Ease::CubicInOut: return EaseCubicInOut::eval(t);
+		case hyp::Ease::SmoothStep: return EaseSmoothStep::eval(t);
+		case hyp::Ease::BackOut: return EaseBackOut::eval(t);
+		default: return t;
+		}
+	}
+}
+
+hyp::Animator::Animator(entt::registry& registry)
+    : m_registry(registry) {}
+
+hyp::Animator::~Animator() {}
+
+void hyp::Animator::evaluate(Lane& lane, Ease ease, float dt) {
+	LaneView view;
+	view.count = lane.tracks.size();
+	view.elapsed = lane.elapsed.data();
+	view.invDuration = lane.invDuration.data();
+	for (int c = 0; c < 4; c++)
+	{
+		view.from[c] = lane.from[c].data();
+		view.delta[c] = lane.delta[c].data();
+		view.value[c] = lane.value[c].data();
+	}
+
+	switch (ease)
+	{
+	case Ease::Linear: evaluateLane<EaseLinear>(view, dt); break;
+	case Ease::QuadIn: evaluateLane<EaseQuadIn>(view, dt); break;
+	case Ease::QuadOut: evaluateLane<EaseQuadOut>(view, dt); break;
+	case Ease::QuadInOut: evaluateLane<EaseQuadInOut>(view, dt); break;
+	case Ease::CubicIn: evaluateLane<EaseCubicIn>(view, dt); break;
+	case Ease::CubicOut: evaluateLane<EaseCubicOut>(view, dt); break;
+	case Ease::CubicInOut: evaluateLane<EaseCubicInOut>(view, dt); break;
+	case Ease::SmoothStep: evaluateLane<EaseSmoothStep>(view, dt); break;
+	case Ease::BackOut: evaluateLane<EaseBackOut>(view, dt); break;
+	default: break;
+	}
+}
+
+uint32_t hyp::Animator::allocate(entt::entity entity, AnimProperty property) {
+	uint32_t index;
+	if (!m_freeTracks.empty())
+	{
+		index = m_freeTracks.back();
+		m_freeTracks.pop_back();
+	}
+	else
+	{
+		index = (uint32_t)m_tracks.size();
+		m_tracks.emplace_back();
+	}
+
+	Track& track = m_tracks[index];
+	track.entity = entity;
+	track.property = property;
+	track.active = true;
+	m_trackCount++;
+	return index;
+}
+
+void hyp::Animator::release(uint32_t index) {
+	remove(index);
+	recycle(index);
+}
+
+void hyp::Animator::recycle(uint32_t index) {
+	Track& track = m_tracks[index];
+	track.active = false;
+	track.entity = entt::null;
+	track.curve.reset();
+	// 0 is skipped so that a zero id is never valid
+	if (++track.generation == 0) track.generation = 1;
+
+	m_freeTracks.push_back(index);
+	m_trackCount--;
+}
+
+void hyp::Animator::push(uint32_t index, Ease ease, const glm::vec4& from, const glm::vec4& to, float duration, float elapsed) {
+	Lane& lane = m_lanes[static_cast<size_t>(ease)];
+
+	Track& track = m_tracks[index];
+	track.ease = ease;
+	track.index = (uint32_t)lane.tracks.size();
+
+	lane.tracks.push_back(index);
+	lane.entities.push_back(track.entity);
+	lane.properties.push_back(track.property);
+	lane.elapsed.push_back(elapsed);
+	// a zero duration jumps to the end value on the next update
+	lane.invDuration.push_back(duration > 0.f ? 1.f / duration : 1e30f);
+	for (int c = 0; c < 4; c++)
+	{
+		lane.from[c].push_back(from[c]);
+		lane.delta[c].push_back(to[c] - from[c]);
+		lane.value[c].push_back(from[c]);
+	}
+}
+
+void hyp::Animator::remove(uint32_t index) {
+	const Track& track = m_tracks[index];
+	Lane& lane = m_lanes[static_cast<size_t>(track.ease)];
+
+	// swap with the last track of the lane
+	uint32_t i = track.index;
+	uint32_t last = (uint32_t)lane.tracks.size() - 1;
+	if (i != last)
+	{
+		lane.tracks[i] = lane.tracks[last];
+		lane.entities[i] = lane.entities[last];
+		lane.properties[i] = lane.properties[last];
+		lane.elapsed[i] = lane.elapsed[last];
+		lane.invDuration[i] = lane.invDuration[last];
+		for (int c = 0; c < 4; c++)
+		{
+			lane.from[c][i] = lane.from[c][last];
+			lane.delta[c][i] = lane.delta[c][last];
+			lane.value[c][i] = lane.value[c][last];
+		}
+		m_tracks[lane.tracks[i]].index = i;
+	}
+
+	lane.tracks.pop_back();
+	lane.entities.pop_back();
+	lane.properties.pop_back();
+	lane.elapsed.pop_back();
+	lane.invDuration.pop_back();
+	for (int c = 0; c < 4; c++)
+	{
+		lane.from[c].pop_back();
+		lane.delta[c].pop_back();
+		lane.value[c].pop_back();
+	}
+}
+
+bool hyp::Animator::startSegment(uint32_t index, float elapsed) {
+	Track& track = m_tracks[index];
+	const auto& keys = track.curve->keys;
+
+	// a loop of no length would wrap forever without consuming time, it plays once and holds the last key
+	const bool loop = track.curve->loop && keys.back().time > keys.front().time;
+
+	// skips the segments `elapsed` already went past
+	bool looped = false;
+	while (true)
+	{
+		if (track.key >= keys.size())
+		{
+			if (!loop) return false;
+
+			// past the whole curve in one update, the rest of the time is dropped
+			if (looped) elapsed = 0.f;
+			track.key = 1;
+			looped = true;
+		}
+
+		float duration = keys[track.key].time - keys[track.key - 1].time;
+		if (elapsed < duration || (track.key + 1 == keys.size() && !loop)) break;
+
+		elapsed -= duration;
+		track.key++;
+	}
+
+	const Keyframe& from = keys[track.key - 1];
+	const Keyframe& to = keys[track.key];
+	push(index, to.ease, from.value, to.value, to.time - from.time, elapsed);
+	return true;
+}
+
+hyp::Animator::TrackId hyp::Animator::tween(entt::entity entity, AnimProperty property, const glm::vec4& from, const glm::vec4& to, float duration, Ease ease, float delay) {
+	uint32_t index = allocate(entity, property);
+	push(index, ease, from, to, duration, -delay);
+	return ((TrackId)m_tracks[index].generation << 32) | index;
+}
+
+hyp::Animator::TrackId hyp::Animator::tweenTo(entt::entity entity, AnimProperty property, const glm::vec4& to, float duration, Ease ease, float delay) {
+	return tween(entity, property, read(entity, property), to, duration, ease, delay);
+}
+
+hyp::Animator::TrackId hyp::Animator::play(entt::entity entity, AnimProperty property, const hyp::Ref<AnimationCurve>& curve) {
+	if (!curve || curve->keys.empty()) return 0;
+
+	uint32_t index = allocate(entity, property);
+	Track& track = m_tracks[index];
+
+	if (curve->keys.size() == 1)
+	{
+		// a single key holds its value for one update
+		push(index, curve->keys[0].ease, curve->keys[0].value, curve->keys[0].value, 0.f, 0.f);
+	}
+	else
+	{
+		track.curve = curve;
+		track.key = 1;
+		startSegment(index, 0.f);
+	}
+
+	return ((TrackId)m_tracks[index].generation << 32) | index;
+}
+
+const hyp::Animator::Track* hyp::Animator::find(TrackId id) const {
+	uint32_t index = (uint32_t)id;
+	if (index >= m_tracks.size()) return nullptr;
+
+	const Track& track = m_tracks[index];
+	if (!track.active || track.generation != (uint32_t)(id >> 32)) return nullptr;
+	return &track;
+}
+
+bool hyp::Animator::stop(TrackId id) {
+	if (!find(id)) return false;
+
+	release((uint32_t)id);
+	return true;
+}
+
+bool hyp::Animator::isPlaying(TrackId id) const {
+	return find(id) != nullptr;
+}
+
+glm::vec4 hyp::Animator::read(entt::entity entity, AnimProperty property) const {
+	if (!m_registry.valid(entity)) return glm::vec4(0.f);
+
+	switch (property)
+	{
+	case AnimProperty::Position:
+		if (auto* transform = m_registry.try_get<hyp::TransformComponent>(entity)) return glm::vec4(transform->position, 0.f);
+		break;
+	case AnimProperty::Size:
+		if (auto* transform = m_registry.try_get<hyp::TransformComponent>(entity)) return glm::vec4(transform->size, 0.f, 0.f);
+		break;
+	case AnimProperty::Rotation:
+		if (auto* transform = m_registry.try_get<hyp::TransformComponent>(entity)) return glm::vec4(transform->rotation, 0.f, 0.f, 0.f);
+		break;
+	case AnimProperty::SpriteColor:
+		if (auto* sprite = m_registry.try_get<hyp::SpriteRendererComponent>(entity)) return sprite->color;
+		break;
+	case AnimProperty::CircleColor:
+		if (auto* circle = m_registry.try_get<hyp::CircleRendererComponent>(entity)) return circle->color;
+		break;
+	default: break;
+	}
+
+	return glm::vec4(0.f);
+}
+
+void hyp::Animator::update(float dt) {
+	HYP_PROFILE_SCOPE("Animator::update");
+
+	for (size_t e = 0; e < m_lanes.size(); e++)
+	{
+		if (!m_lanes[e].tracks.empty()) evaluate(m_lanes[e], static_cast<Ease>(e), dt);
+	}
+
+	Targets targets(m_registry);
+	m_finished.clear();
+	for (Lane& lane : m_lanes)
+	{
+		for (size_t i = 0; i < lane.tracks.size(); i++)
+		{
+			if (!m_registry.valid(lane.entities[i]))
+			{
+				m_finished.push_back(lane.tracks[i]);
+				continue;
+			}
+
+			// a delayed track doesn't touch its field before it starts
+			if (lane.elapsed[i] < 0.f) continue;
+
+			glm::vec4 value(lane.value[0][i], lane.value[1][i], lane.value[2][i], lane.value[3][i]);
+			targets.write(lane.entities[i], lane.properties[i], value);
+
+			if (lane.elapsed[i] * lane.invDuration[i] >= 1.f) m_finished.push_back(lane.tracks[i]);
+		}
+	}
+
+	for (uint32_t index : m_finished)
+	{
+		Track& track = m_tracks[index];
+		if (track.curve && m_registry.valid(track.entity))
+		{
+			// the time past the end of the segment carries over to the next one
+			const Lane& lane = m_lanes[static_cast<size_t>(track.ease)];
+			float overshoot = std::max(0.f, lane.elapsed[track.index] - 1.f / lane.invDuration[track.index]);
+
+			remove(index);
+			track.key++;
+			if (!startSegment(index, overshoot))
+			{
+				recycle(index);
+				continue;
+			}
+
+			// written right away, the finished value would otherwise stay for a frame
+			const Lane& next = m_lanes[static_cast<size_t>(track.ease)];
+			uint32_t i = track.index;
+			float e = ease(track.ease, std::clamp(next.elapsed[i] * next.invDuration[i], 0.f, 1.f));
+			glm::vec4 value;
+			for (int c = 0; c < 4; c++)
+			{
+				value[c] = next.from[c][i] + next.delta[c][i] * e;
+			}
+			targets.write(track.entity, track.property, value);
+			continue;
+		}
+
+		release(index);
+	}
+
+	static hyp::Gauge& s_trackCount = hyp::Metrics::gauge("scene.animation_tracks");
+	s_trackCount.set((double)m_trackCount);
+}
+
+void hyp::Animator::clear() {
+	for (uint32_t index = 0; index < m_tracks.size(); index++)
+	{
+		if (m_tracks[index].active) release(index);
+	}
+}
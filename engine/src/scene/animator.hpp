@@ -0,0 +1,145 @@
+#pragma once
+#ifndef HYP_ANIMATOR_HPP
+	#define HYP_ANIMATOR_HPP
+
+	#include <core/base.hpp>
+	#include <entt.hpp>
+	#include <glm/glm.hpp>
+	#include <array>
+	#include <cstdint>
+	#include <vector>
+
+namespace hyp {
+
+	enum class Ease : uint8_t
+	{
+		Linear = 0,
+		QuadIn,
+		QuadOut,
+		QuadInOut,
+		CubicIn,
+		CubicOut,
+		CubicInOut,
+		SmoothStep,
+		BackOut, // overshoots, for UI
+		Count
+	};
+
+	/**
+	* \brief component field a track writes to; values are vec4, the unused components are ignored
+	*/
+	enum class AnimProperty : uint8_t
+	{
+		Position = 0, // TransformComponent, xyz
+		Size,         // TransformComponent, xy
+		Rotation,     // TransformComponent, x
+		SpriteColor,  // SpriteRendererComponent
+		CircleColor,  // CircleRendererComponent
+		Count
+	};
+
+	struct Keyframe
+	{
+		float time = 0.f; // seconds from the start of the curve
+		glm::vec4 value { 0.f };
+		Ease ease = Ease::Linear; // of the segment ending at this key
+	};
+
+	struct AnimationCurve
+	{
+		std::vector<Keyframe> keys; // sorted by time
+		bool loop = false; // ignored when every key shares one time
+	};
+
+	/**
+	* \brief plays tweens and keyframe curves on component fields.
+	*
+	* Active tracks are stored SoA, one lane per easing function, so each frame the lanes are evaluated
+	* four tracks at a time with SSE (scalar when unavailable) and the values written back to the components.
+	* A keyframe curve only plays one segment at a time, moving to the next key (and possibly to another
+	* lane) when it ends. Tracks stop on their own once finished or once their entity is destroyed.
+	*/
+	class Animator {
+	public:
+		using TrackId = uint64_t;
+
+		Animator(entt::registry& registry);
+		~Animator();
+
+		Animator(const Animator&) = delete;
+		Animator& operator=(const Animator&) = delete;
+
+		/**
+		* \brief a negative `delay` is allowed and starts the tween part way through
+		*/
+		TrackId tween(entt::entity entity, AnimProperty property, const glm::vec4& from, const glm::vec4& to, float duration, Ease ease = Ease::Linear, float delay = 0.f);
+		/**
+		* \brief tweens from the current value of the field
+		*/
+		TrackId tweenTo(entt::entity entity, AnimProperty property, const glm::vec4& to, float duration, Ease ease = Ease::Linear, float delay = 0.f);
+		TrackId play(entt::entity entity, AnimProperty property, const hyp::Ref<AnimationCurve>& curve);
+
+		bool stop(TrackId id);
+		bool isPlaying(TrackId id) const;
+
+		/**
+		* \brief advances every track by `dt` seconds and writes the values to the components
+		*/
+		void update(float dt);
+		void clear();
+
+		size_t getTrackCount() const { return m_trackCount; }
+
+	private:
+		struct Track
+		{
+			entt::entity entity = entt::null;
+			AnimProperty property = AnimProperty::Position;
+			Ease ease = Ease::Linear;
+			uint32_t index = 0; // in the lane of `ease`
+			uint32_t generation = 1;
+			bool active = false;
+
+			hyp::Ref<AnimationCurve> curve;
+			uint32_t key = 0; // the current segment ends at this key
+		};
+
+		struct Lane
+		{
+			std::vector<float> elapsed;
+			std::vector<float> invDuration;
+			std::array<std::vector<float>, 4> from;
+			std::array<std::vector<float>, 4> delta; // to - from
+			std::array<std::vector<float>, 4> value;
+			std::vector<uint32_t> tracks;
+			// copies of the tracks' targets, the write back doesn't go through m_tracks
+			std::vector<entt::entity> entities;
+			std::vector<AnimProperty> properties;
+		};
+
+		static void evaluate(Lane& lane, Ease ease, float dt);
+
+		uint32_t allocate(entt::entity entity, AnimProperty property);
+		void release(uint32_t track);
+		void recycle(uint32_t track); // once out of its lane
+		void push(uint32_t track, Ease ease, const glm::vec4& from, const glm::vec4& to, float duration, float elapsed);
+		void remove(uint32_t track);
+		bool startSegment(uint32_t track, float elapsed);
+		const Track* find(TrackId id) const;
+
+		glm::vec4 read(entt::entity entity, AnimProperty property) const;
+
+	private:
+		entt::registry& m_registry;
+
+		std::array<Lane, static_cast<size_t>(Ease::Count)> m_lanes;
+		std::vector<Track> m_tracks;
+		std::vector<uint32_t> m_freeTracks;
+		size_t m_trackCount = 0;
+
+		// reused every update
+		std::vector<uint32_t> m_finished;
+	};
+}
+
+#endif // !HYP_ANIMATOR_HPP
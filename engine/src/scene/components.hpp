@@ -3,7 +3,9 @@
 	#define HYP_COMPONENTS_HPP
 
 	#include <glm/glm.hpp>
-	#include <renderer/texture.hpp>
+	#include <renderer/resources.hpp>
+	#include <scripting/script_engine.hpp>
+	#include <scene/reflection.hpp>
 	#include <string>
 
 namespace hyp {
@@ -29,7 +31,7 @@ namespace hyp {
 	struct SpriteRendererComponent
 	{
 		glm::vec4 color;
-		hyp::Ref<hyp::Texture2D> texture;
+		hyp::TextureHandle texture;
 		float tilingFactor = 1.f;
 
 		SpriteRendererComponent(const glm::vec4& color = glm::vec4(1.0))
@@ -49,6 +51,33 @@ namespace hyp {
 		}
 	};
 
+	struct ScriptComponent
+	{
+		hyp::ScriptHandle script;
+		bool created = false; // onCreate already called
+
+		ScriptComponent(hyp::ScriptHandle script = {})
+		    : script(script) {}
+	};
+
 } // namespace hyp
 
+// ScriptComponent is runtime state only, SpriteRendererComponent::texture a runtime handle
+HYP_REFLECT(hyp::TagComponent,
+    HYP_FIELD(name));
+
+HYP_REFLECT(hyp::TransformComponent,
+    HYP_FIELD(position),
+    HYP_FIELD(size),
+    HYP_FIELD(rotation));
+
+HYP_REFLECT(hyp::SpriteRendererComponent,
+    HYP_FIELD(color, hyp::FieldColor),
+    HYP_FIELD(tilingFactor, hyp::FieldNone, 0.1f));
+
+HYP_REFLECT(hyp::CircleRendererComponent,
+    HYP_FIELD(color, hyp::FieldColor),
+    HYP_FIELD(thickness, hyp::FieldNone, 0.01f, 0.f, 1.f),
+    HYP_FIELD(fade, hyp::FieldNone, 0.01f, 0.f, 1.f));
+
 #endif
\ No newline at end of file
@@ -38,6 +38,7 @@ namespace hyp {
 			m_scene->m_registry.remove<T>(m_handle);
 		}
 
+		entt::entity getHandle() const { return m_handle; }
 		operator bool() { return m_handle != entt::null; }
 
 	private:
@@ -0,0 +1,228 @@
+#pragma once
+#ifndef HYP_REFLECTION_HPP
+	#define HYP_REFLECTION_HPP
+
+	#include <io/binary_stream.hpp>
+	#include <cstdint>
+	#include <cstring>
+	#include <string>
+	#include <tuple>
+	#include <type_traits>
+
+namespace hyp {
+
+	enum FieldFlags : uint32_t
+	{
+		FieldNone = 0,
+		FieldColor = 1 << 0, // inspected with a colour picker
+	};
+
+	/**
+	* \brief a reflected data member; speed, min and max only matter to the inspector (no range when min == max)
+	*/
+	template <typename T, typename M>
+	struct Field
+	{
+		using Type = M;
+
+		const char* name;
+		M T::*member;
+		uint32_t flags = FieldNone;
+		float speed = 1.f;
+		float min = 0.f;
+		float max = 0.f;
+
+		constexpr M& get(T& object) const { return object.*member; }
+		constexpr const M& get(const T& object) const { return object.*member; }
+	};
+
+	/**
+	* \brief compile-time field list of T, specialized with HYP_REFLECT:
+	*
+	*	HYP_REFLECT(hyp::CircleRendererComponent,
+	*	    HYP_FIELD(color, hyp::FieldColor),
+	*	    HYP_FIELD(thickness, hyp::FieldNone, 0.01f, 0.f, 1.f));
+	*
+	* Members left out are runtime state: they are not serialized, diffed or inspected.
+	*/
+	template <typename T>
+	struct Reflect;
+
+	template <typename T>
+	concept Reflected = requires { Reflect<T>::fields; };
+
+	using FieldMask = uint64_t;
+
+	template <Reflected T, typename Fn>
+	constexpr void forEachField(Fn&& fn) {
+		std::apply([&](const auto&... field) { (fn(field), ...); }, Reflect<T>::fields);
+	}
+
+	template <Reflected T>
+	constexpr size_t getFieldCount() {
+		return std::tuple_size_v<std::remove_cv_t<decltype(Reflect<T>::fields)>>;
+	}
+
+	/**
+	* \brief true when the fields are trivially copyable and cover every byte of T,
+	* values (and arrays of them) are then copied in bulk
+	*/
+	template <Reflected T>
+	constexpr bool isPacked() {
+		size_t bytes = 0;
+		bool trivial = std::is_trivially_copyable_v<T>;
+		forEachField<T>([&](const auto& field) {
+			using M = typename std::decay_t<decltype(field)>::Type;
+			bytes += sizeof(M);
+			trivial = trivial && std::is_trivially_copyable_v<M>;
+		});
+
+		return trivial && bytes == sizeof(T);
+	}
+
+	template <Reflected T>
+	void serialize(hyp::BinaryWriter& writer, const T& value);
+	template <Reflected T>
+	bool deserialize(hyp::BinaryReader& reader, T& value);
+	template <Reflected T>
+	FieldMask diff(const T& previous, const T& current);
+
+	namespace detail {
+		template <typename M>
+		void writeValue(hyp::BinaryWriter& writer, const M& value) {
+			if constexpr (std::is_same_v<M, std::string>)
+				writer.writeString(value);
+			else if constexpr (Reflected<M>)
+				hyp::serialize(writer, value);
+			else
+			{
+				static_assert(std::is_trivially_copyable_v<M>, "field type has no binary representation");
+				writer.write(value);
+			}
+		}
+
+		template <typename M>
+		void readValue(hyp::BinaryReader& reader, M& value) {
+			if constexpr (std::is_same_v<M, std::string>)
+				value = reader.readString();
+			else if constexpr (Reflected<M>)
+				hyp::deserialize(reader, value);
+			else
+				value = reader.read<M>();
+		}
+
+		template <typename M>
+		bool equals(const M& a, const M& b) {
+			if constexpr (Reflected<M>)
+				return hyp::diff(a, b) == 0;
+			else if constexpr (std::is_trivially_copyable_v<M>)
+				return std::memcmp(&a, &b, sizeof(M)) == 0; // bitwise, a NaN equals itself
+			else
+				return a == b;
+		}
+
+		// the smallest integer holding one bit per field, used on the wire
+		template <size_t Count>
+		using MaskType = std::conditional_t<Count <= 8, uint8_t, std::conditional_t<Count <= 16, uint16_t, std::conditional_t<Count <= 32, uint32_t, uint64_t>>>;
+	}
+
+	template <Reflected T>
+	void serialize(hyp::BinaryWriter& writer, const T& value) {
+		if constexpr (isPacked<T>())
+			writer.write(value);
+		else
+			forEachField<T>([&](const auto& field) { detail::writeValue(writer, field.get(value)); });
+	}
+
+	template <Reflected T>
+	bool deserialize(hyp::BinaryReader& reader, T& value) {
+		if constexpr (isPacked<T>())
+			reader.readBytes(&value, sizeof(T));
+		else
+			forEachField<T>([&](const auto& field) { detail::readValue(reader, field.get(value)); });
+
+		return reader.ok;
+	}
+
+	/**
+	* \brief writes `count` values, a single copy when T is packed (e.g. a component pool's raw array)
+	*/
+	template <Reflected T>
+	void serializeRange(hyp::BinaryWriter& writer, const T* values, size_t count) {
+		if constexpr (isPacked<T>())
+			writer.writeBytes(values, count * sizeof(T));
+		else
+			for (size_t i = 0; i < count; i++) serialize(writer, values[i]);
+	}
+
+	template <Reflected T>
+	bool deserializeRange(hyp::BinaryReader& reader, T* values, size_t count) {
+		if constexpr (isPacked<T>())
+			reader.readBytes(values, count * sizeof(T));
+		else
+			for (size_t i = 0; i < count && reader.ok; i++) deserialize(reader, values[i]);
+
+		return reader.ok;
+	}
+
+	/**
+	* \brief bit i is set when the i-th reflected field differs
+	*/
+	template <Reflected T>
+	FieldMask diff(const T& previous, const T& current) {
+		static_assert(getFieldCount<T>() <= 64, "diff supports up to 64 fields");
+
+		FieldMask mask = 0;
+		uint32_t index = 0;
+		forEachField<T>([&](const auto& field) {
+			if (!detail::equals(field.get(previous), field.get(current))) mask |= FieldMask(1) << index;
+			index++;
+		});
+
+		return mask;
+	}
+
+	/**
+	* \brief writes the mask, then only the fields it selects; read back with readDelta
+	*/
+	template <Reflected T>
+	void writeDelta(hyp::BinaryWriter& writer, const T& value, FieldMask mask) {
+		writer.write((detail::MaskType<getFieldCount<T>()>)mask);
+
+		uint32_t index = 0;
+		forEachField<T>([&](const auto& field) {
+			if (mask & (FieldMask(1) << index)) detail::writeValue(writer, field.get(value));
+			index++;
+		});
+	}
+
+	template <Reflected T>
+	bool readDelta(hyp::BinaryReader& reader, T& value, FieldMask* changed = nullptr) {
+		FieldMask mask = reader.read<detail::MaskType<getFieldCount<T>()>>();
+
+		uint32_t index = 0;
+		forEachField<T>([&](const auto& field) {
+			if (mask & (FieldMask(1) << index)) detail::readValue(reader, field.get(value));
+			index++;
+		});
+
+		if (changed) *changed = reader.ok ? mask : 0;
+		return reader.ok;
+	}
+}
+
+	// at global scope, after the type is complete
+	#define HYP_REFLECT(Type, ...)                                      \
+		template <>                                                     \
+		struct hyp::Reflect<Type>                                       \
+		{                                                               \
+			using type = Type;                                          \
+			static constexpr const char* name = #Type;                  \
+			static constexpr auto fields = std::make_tuple(__VA_ARGS__); \
+		}
+
+	// flags, then the inspector's speed, min and max may follow the member
+	#define HYP_FIELD(member, ...) \
+		hyp::Field<type, decltype(type::member)> { #member, &type::member, __VA_ARGS__ }
+
+#endif // !HYP_REFLECTION_HPP
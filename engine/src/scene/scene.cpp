@@ -2,29 +2,80 @@
 #include "renderer/renderer2d.hpp"
 #include "scene/components.hpp"
 #include "scene/entity.hpp"
+#include "debug/memory_tracker.hpp"
+#include "debug/metrics.hpp"
+#include "debug/flight_recorder.hpp"
+#include "renderer/render_list.hpp"
 
-hyp::Scene::Scene() {}
+hyp::Scene::Scene()
+    : m_animator(m_registry) {
+	// scripts may touch anything, including the Lua state, so they run alone on the main thread
+	m_systems.add("ScriptSystem", [this](entt::registry& registry, float dt) { m_scriptSystem.onUpdate(registry, dt); })
+	    .exclusive()
+	    .mainThread();
+	m_systems.add("Animator", [this](entt::registry&, float dt) { m_animator.update(dt); })
+	    .writes<TransformComponent, SpriteRendererComponent, CircleRendererComponent>();
+}
 
 hyp::Scene::~Scene() {}
 
 hyp::Entity hyp::Scene::createEntity(const std::string& name) {
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Scene);
 	entt::entity handle = m_registry.create();
 
 	Entity entity = Entity(handle, this);
 
-	auto& tag = entity.add<TagComponent>();
-	tag.name = name.empty() ? "Entity" : name;
+	// named on construction, so on_construct listeners see the name
+	entity.add<TagComponent>(TagComponent { name.empty() ? "Entity" : name });
 	auto& transform = entity.add<TransformComponent>();
 
 	return entity;
 }
 
+void hyp::Scene::destroyEntity(Entity entity) {
+	m_registry.destroy(entity.getHandle());
+}
+
+void hyp::Scene::updateSystems(float dt) {
+	static hyp::Gauge& s_entityCount = hyp::Metrics::gauge("scene.entities");
+	s_entityCount.set((double)m_registry.alive());
+
+	m_systems.run(m_registry, dt);
+}
+
 void hyp::Scene::onUpdate(float dt) {
+	updateSystems(dt);
+
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Scene);
 	auto& view = m_registry.group<TransformComponent>(entt::get<hyp::SpriteRendererComponent>);
 
 	for (auto entity : view)
 	{
 		auto& [transform, sprite] = view.get<TransformComponent, hyp::SpriteRendererComponent>(entity);
-		hyp::Renderer2D::drawQuad(transform.position, transform.size, sprite.color);
+		if (sprite.texture)
+		{
+			hyp::Renderer2D::drawQuad(transform.position, transform.size, sprite.texture, sprite.tilingFactor, sprite.color);
+		}
+		else
+		{
+			hyp::Renderer2D::drawQuad(transform.position, transform.size, sprite.color);
+		}
+	}
+}
+
+void hyp::Scene::onUpdate(float dt, hyp::RenderList& renderList) {
+	updateSystems(dt);
+
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Scene);
+	HYP_PROFILE_SCOPE("Scene::extract");
+	auto view = m_registry.group<TransformComponent>(entt::get<hyp::SpriteRendererComponent>);
+
+	renderList.begin();
+	for (auto entity : view)
+	{
+		const auto& transform = view.get<TransformComponent>(entity);
+		const auto& sprite = view.get<hyp::SpriteRendererComponent>(entity);
+		renderList.addQuad(transform.position, transform.size, sprite.texture, sprite.tilingFactor, sprite.color);
 	}
+	renderList.end();
 }
@@ -3,10 +3,14 @@
 	#define HYP_SCENE_HPP
 
 	#include <entt.hpp>
+	#include <scene/animator.hpp>
+	#include <scene/system_scheduler.hpp>
+	#include <scripting/script_system.hpp>
 	#include <string>
 
 namespace hyp {
 	class Entity;
+	class RenderList;
 
 	class Scene {
 	public:
@@ -14,12 +18,34 @@ namespace hyp {
 		~Scene();
 
 		Entity createEntity(const std::string& name);
+		void destroyEntity(Entity entity);
+
+		// for tools that need to iterate or observe every entity (e.g. the editor outliner)
+		entt::registry& getRegistry() { return m_registry; }
+		// tweens and curves on the scene's components, updated after the scripts
+		hyp::Animator& getAnimator() { return m_animator; }
+		/**
+		* \brief the scene's systems, run by onUpdate before drawing; scripts and the animator are
+		* registered first, gameplay systems added here spread over the job system's workers
+		*/
+		hyp::SystemScheduler& getSystems() { return m_systems; }
 
 		void onUpdate(float dt);
+		/**
+		* \brief runs the systems like onUpdate, but extracts the sprites into `renderList` instead of
+		* submitting them, for scenes drawn by several views (Renderer2D::drawRenderList)
+		*/
+		void onUpdate(float dt, hyp::RenderList& renderList);
+
+	private:
+		void updateSystems(float dt);
 
 	private:
 		friend class Entity;
 		entt::registry m_registry;
+		hyp::ScriptSystem m_scriptSystem;
+		hyp::Animator m_animator;
+		hyp::SystemScheduler m_systems;
 	};
 } // namespace hyp
 
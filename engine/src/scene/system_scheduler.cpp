@@ -0,0 +1,194 @@
+#include "system_scheduler.hpp"
+#include <core/job_system.hpp>
+#include <debug/flight_recorder.hpp>
+#include <utils/assert.hpp>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+hyp::SystemScheduler::~SystemScheduler() {
+	// jobs left behind by a run whose systems the calling thread took still reference the scheduler
+	while (m_pendingJobs.load(std::memory_order_acquire) != 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+uint32_t hyp::SystemScheduler::nextComponentId() {
+	static std::atomic<uint32_t> s_next { 0 };
+	uint32_t id = s_next.fetch_add(1, std::memory_order_relaxed);
+	HYP_ASSERT_CORE(id < MaxComponentTypes, "SystemScheduler: raise MaxComponentTypes");
+	return id;
+}
+
+bool hyp::SystemScheduler::conflicts(const SystemDesc& a, const SystemDesc& b) {
+	if (a.m_exclusive || b.m_exclusive) return true;
+	return (a.m_writes & (b.m_reads | b.m_writes)).any() || (b.m_writes & a.m_reads).any();
+}
+
+hyp::SystemScheduler::SystemDesc& hyp::SystemScheduler::add(const char* name, const SystemFn& fn) {
+	System& system = m_systems.emplace_back();
+	system.name = name;
+	system.fn = fn;
+
+	m_dirty = true;
+	return system.desc;
+}
+
+bool hyp::SystemScheduler::remove(const char* name) {
+	auto it = std::find_if(m_systems.begin(), m_systems.end(), [&](const System& system) { return std::strcmp(system.name, name) == 0; });
+	if (it == m_systems.end()) return false;
+
+	m_systems.erase(it);
+	m_dirty = true;
+	return true;
+}
+
+void hyp::SystemScheduler::clear() {
+	m_systems.clear();
+	m_dirty = true;
+}
+
+hyp::SystemScheduler::SystemStats hyp::SystemScheduler::getStats(size_t index) const {
+	const System& system = m_systems[index];
+	return { system.name, system.durationUs, system.depth };
+}
+
+uint32_t hyp::SystemScheduler::getCriticalPathLength() {
+	if (m_dirty) build();
+
+	uint32_t length = 0;
+	for (const System& system : m_systems)
+	{
+		length = std::max(length, system.depth + 1);
+	}
+
+	return length;
+}
+
+void hyp::SystemScheduler::build() {
+	const uint32_t count = (uint32_t)m_systems.size();
+	for (System& system : m_systems)
+	{
+		system.successors.clear();
+		system.predecessorCount = 0;
+		system.depth = 0;
+	}
+
+	// an edge from every earlier conflicting system, registration order breaks the ties
+	for (uint32_t i = 0; i < count; i++)
+	{
+		System& system = m_systems[i];
+		for (uint32_t j = 0; j < i; j++)
+		{
+			if (!conflicts(m_systems[j].desc, system.desc)) continue;
+
+			m_systems[j].successors.push_back(i);
+			system.predecessorCount++;
+			system.depth = std::max(system.depth, m_systems[j].depth + 1);
+		}
+	}
+
+	m_remaining = hyp::CreateScope<std::atomic<uint32_t>[]>(count);
+	m_dirty = false;
+}
+
+void hyp::SystemScheduler::run(entt::registry& registry, float dt) {
+	HYP_PROFILE_SCOPE("SystemScheduler::run");
+	if (m_dirty) build();
+
+	const uint32_t count = (uint32_t)m_systems.size();
+	if (count == 0) return;
+
+	m_registry = &registry;
+	m_dt = dt;
+	m_finished.store(0, std::memory_order_relaxed);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		// views create their pool on first use, which must not happen concurrently
+		for (auto pool : m_systems[i].desc.m_pools)
+		{
+			pool(registry);
+		}
+
+		m_remaining[i].store(m_systems[i].predecessorCount, std::memory_order_relaxed);
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (m_systems[i].predecessorCount == 0) dispatch(i);
+	}
+
+	while (m_finished.load(std::memory_order_acquire) < count)
+	{
+		uint32_t index = UINT32_MAX;
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			if (!m_mainThreadQueue.empty())
+			{
+				index = m_mainThreadQueue.front();
+				m_mainThreadQueue.erase(m_mainThreadQueue.begin());
+			}
+		}
+
+		// only this run's systems: the global job queue also holds streaming loads and decodes,
+		// which must never end up on the frame
+		if (index != UINT32_MAX || popReady(index))
+		{
+			execute(index);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void hyp::SystemScheduler::dispatch(uint32_t index) {
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		if (m_systems[index].desc.m_mainThread || hyp::JobSystem::getWorkerCount() == 0)
+		{
+			m_mainThreadQueue.push_back(index);
+			return;
+		}
+
+		m_readyQueue.push_back(index);
+	}
+
+	// runs whichever system is ready when a worker gets to it, nothing if the calling thread was faster
+	m_pendingJobs.fetch_add(1, std::memory_order_relaxed);
+	hyp::JobSystem::schedule([this]() {
+		uint32_t ready;
+		if (popReady(ready)) execute(ready);
+		m_pendingJobs.fetch_sub(1, std::memory_order_release);
+	});
+}
+
+bool hyp::SystemScheduler::popReady(uint32_t& index) {
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	if (m_readyQueue.empty()) return false;
+
+	index = m_readyQueue.front();
+	m_readyQueue.erase(m_readyQueue.begin());
+	return true;
+}
+
+void hyp::SystemScheduler::execute(uint32_t index) {
+	System& system = m_systems[index];
+	{
+		hyp::ProfileScope scope(system.name);
+		uint64_t start = hyp::FlightRecorder::now();
+		system.fn(*m_registry, m_dt);
+		system.durationUs = hyp::FlightRecorder::now() - start;
+	}
+
+	for (uint32_t successor : system.successors)
+	{
+		if (m_remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) dispatch(successor);
+	}
+
+	// last, `run` returns as soon as every system counted itself
+	m_finished.fetch_add(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,156 @@
+#pragma once
+#ifndef HYP_SYSTEM_SCHEDULER_HPP
+	#define HYP_SYSTEM_SCHEDULER_HPP
+
+	#include <core/base.hpp>
+	#include <entt.hpp>
+	#include <atomic>
+	#include <bitset>
+	#include <cstdint>
+	#include <functional>
+	#include <mutex>
+	#include <vector>
+
+namespace hyp {
+
+	using SystemFn = std::function<void(entt::registry& registry, float dt)>;
+
+	/**
+	* \brief runs systems on the JobSystem's workers, concurrently when their declared component accesses
+	* don't conflict.
+	*
+	*	scheduler.add("Movement", move).reads<VelocityComponent>().writes<TransformComponent>();
+	*	scheduler.add("Spawner", spawn).exclusive();
+	*
+	* Two systems conflict when one writes a component the other reads or writes, or when either is
+	* exclusive; conflicting systems always run in registration order, so results are deterministic.
+	* The dependency graph is rebuilt only when systems are added or removed. Each system shows up in
+	* the flight recorder under its name, on the thread it ran on.
+	*
+	* Systems may only use views over their declared components (the pools are created up front on the
+	* calling thread); creating or destroying entities, groups or undeclared pools requires `exclusive`.
+	*/
+	class SystemScheduler {
+	public:
+		static constexpr uint32_t MaxComponentTypes = 128;
+		using AccessMask = std::bitset<MaxComponentTypes>;
+
+		class SystemDesc {
+		public:
+			template <typename... T>
+			SystemDesc& reads() {
+				(declare<T>(m_reads), ...);
+				return *this;
+			}
+
+			template <typename... T>
+			SystemDesc& writes() {
+				(declare<T>(m_writes), ...);
+				return *this;
+			}
+
+			// conflicts with every other system
+			SystemDesc& exclusive() {
+				m_exclusive = true;
+				return *this;
+			}
+
+			// runs on the thread calling `run` (GL, windowing, scripting)
+			SystemDesc& mainThread() {
+				m_mainThread = true;
+				return *this;
+			}
+
+		private:
+			template <typename T>
+			void declare(AccessMask& mask) {
+				mask.set(getComponentId<T>());
+				m_pools.push_back([](entt::registry& registry) { (void)registry.view<T>(); });
+			}
+
+		private:
+			friend class SystemScheduler;
+
+			AccessMask m_reads;
+			AccessMask m_writes;
+			bool m_exclusive = false;
+			bool m_mainThread = false;
+			std::vector<void (*)(entt::registry&)> m_pools;
+		};
+
+		struct SystemStats
+		{
+			const char* name;
+			uint64_t durationUs = 0; // of the last run
+			uint32_t depth = 0;      // systems it waits on, transitively, along the longest chain
+		};
+
+		SystemScheduler() = default;
+		~SystemScheduler();
+		SystemScheduler(const SystemScheduler&) = delete;
+		SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+		/**
+		* \brief `name` must outlive the flight recorder (string literal); the returned description
+		* is only valid until the next add
+		*/
+		SystemDesc& add(const char* name, const SystemFn& fn);
+		bool remove(const char* name);
+		void clear();
+
+		/**
+		* \brief runs every system once and returns when all finished; the calling thread runs the
+		* main thread systems and helps with the other ready systems, never with unrelated jobs
+		*/
+		void run(entt::registry& registry, float dt);
+
+		size_t getSystemCount() const { return m_systems.size(); }
+		SystemStats getStats(size_t index) const;
+		// longest chain of dependent systems, the minimum number of steps a frame takes
+		uint32_t getCriticalPathLength();
+
+		template <typename T>
+		static uint32_t getComponentId() {
+			static const uint32_t s_id = nextComponentId();
+			return s_id;
+		}
+
+	private:
+		struct System
+		{
+			const char* name;
+			SystemFn fn;
+			SystemDesc desc;
+
+			std::vector<uint32_t> successors;
+			uint32_t predecessorCount = 0;
+			uint32_t depth = 0;
+			uint64_t durationUs = 0;
+		};
+
+		static uint32_t nextComponentId();
+		static bool conflicts(const SystemDesc& a, const SystemDesc& b);
+
+		void build();
+		void dispatch(uint32_t index);
+		bool popReady(uint32_t& index);
+		void execute(uint32_t index);
+
+	private:
+		std::vector<System> m_systems;
+		bool m_dirty = true;
+
+		// per run
+		entt::registry* m_registry = nullptr;
+		float m_dt = 0.f;
+		hyp::Scope<std::atomic<uint32_t>[]> m_remaining;
+		std::atomic<uint32_t> m_finished { 0 };
+
+		std::mutex m_queueMutex;
+		std::vector<uint32_t> m_mainThreadQueue;
+		std::vector<uint32_t> m_readyQueue; // taken by the worker jobs or the calling thread, whichever comes first
+		std::atomic<uint32_t> m_pendingJobs { 0 };
+	};
+}
+
+#endif // !HYP_SYSTEM_SCHEDULER_HPP
@@ -0,0 +1,108 @@
+#include "world_chunk.hpp"
+#include <io/binary_stream.hpp>
+#include <io/file_system.hpp>
+#include <utils/logger.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+	// the first string of a chunk is at this offset, after magic, version, cell, counts
+	constexpr size_t HeaderSize = 6 * sizeof(uint32_t);
+}
+
+std::string hyp::WorldChunk::getPath(const std::string& directory, int32_t cellX, int32_t cellY) {
+	return directory + "/" + std::to_string(cellX) + "_" + std::to_string(cellY) + ".chunk";
+}
+
+bool hyp::WorldChunk::parse(std::span<const uint8_t> bytes, ChunkData& chunk) {
+	if (bytes.size() < HeaderSize) return false;
+
+	hyp::BinaryReader reader { bytes };
+	if (reader.read<uint32_t>() != Magic || reader.read<uint32_t>() != Version) return false;
+
+	chunk.cellX = reader.read<int32_t>();
+	chunk.cellY = reader.read<int32_t>();
+	uint32_t textureCount = reader.read<uint32_t>();
+	uint32_t entityCount = reader.read<uint32_t>();
+
+	// every string is at least its length prefix, this bounds the reservations below
+	if (textureCount > reader.remaining() / sizeof(uint32_t) || entityCount > reader.remaining() / sizeof(uint32_t)) return false;
+
+	chunk.textures.clear();
+	chunk.textures.reserve(textureCount);
+	for (uint32_t i = 0; i < textureCount && reader.ok; i++)
+	{
+		chunk.textures.push_back(reader.readString());
+	}
+
+	chunk.entities.clear();
+	chunk.entities.reserve(entityCount);
+	for (uint32_t i = 0; i < entityCount && reader.ok; i++)
+	{
+		ChunkEntity& entity = chunk.entities.emplace_back();
+		entity.name = reader.readString();
+		entity.position = reader.read<glm::vec3>();
+		entity.size = reader.read<glm::vec2>();
+		entity.rotation = reader.read<float>();
+		entity.color = reader.read<glm::vec4>();
+		entity.texture = reader.read<int32_t>();
+		entity.tilingFactor = reader.read<float>();
+
+		if (entity.texture >= (int32_t)textureCount) entity.texture = -1;
+	}
+
+	return reader.ok;
+}
+
+bool hyp::WorldChunk::load(const std::string& path, ChunkData& chunk) {
+	hyp::FileData file = hyp::FileSystem::read(path);
+	if (!file.isValid()) return false;
+
+	if (!parse(file.getSpan(), chunk))
+	{
+		HYP_WARN("%s is not a valid world chunk", path.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool hyp::WorldChunk::save(const std::string& path, const ChunkData& chunk) {
+	hyp::BinaryWriter writer;
+	writer.write(Magic);
+	writer.write(Version);
+	writer.write(chunk.cellX);
+	writer.write(chunk.cellY);
+	writer.write((uint32_t)chunk.textures.size());
+	writer.write((uint32_t)chunk.entities.size());
+
+	for (const std::string& texture : chunk.textures)
+	{
+		writer.writeString(texture);
+	}
+
+	for (const ChunkEntity& entity : chunk.entities)
+	{
+		writer.writeString(entity.name);
+		writer.write(entity.position);
+		writer.write(entity.size);
+		writer.write(entity.rotation);
+		writer.write(entity.color);
+		writer.write(entity.texture);
+		writer.write(entity.tilingFactor);
+	}
+
+	std::error_code ec;
+	std::filesystem::path parent = std::filesystem::path(path).parent_path();
+	if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		HYP_ERROR("Failed to write world chunk %s", path.c_str());
+		return false;
+	}
+
+	file.write((const char*)writer.bytes.data(), (std::streamsize)writer.bytes.size());
+	return file.good();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef HYP_WORLD_CHUNK_HPP
+	#define HYP_WORLD_CHUNK_HPP
+
+	#include <glm/glm.hpp>
+	#include <cstdint>
+	#include <span>
+	#include <string>
+	#include <vector>
+
+namespace hyp {
+
+	struct ChunkEntity
+	{
+		std::string name;
+		glm::vec3 position { 0.f };
+		glm::vec2 size { 0.f };
+		float rotation = 0.f;
+		glm::vec4 color { 1.f };
+		int32_t texture = -1; // index into ChunkData::textures, -1 -> untextured
+		float tilingFactor = 1.f;
+	};
+
+	/**
+	* \brief the serialized contents of one world cell: sprites in world space and the textures they use
+	*/
+	struct ChunkData
+	{
+		int32_t cellX = 0;
+		int32_t cellY = 0;
+		std::vector<std::string> textures;
+		std::vector<ChunkEntity> entities;
+	};
+
+	/**
+	* \brief little-endian binary chunk files, "<directory>/<x>_<y>.chunk".
+	* Reads go through the FileSystem, so chunks can be packed into archives.
+	*/
+	class WorldChunk {
+	public:
+		static constexpr uint32_t Magic = 0x4B4E4348; // "HCNK"
+		static constexpr uint32_t Version = 1;
+
+		static std::string getPath(const std::string& directory, int32_t cellX, int32_t cellY);
+
+		static bool parse(std::span<const uint8_t> bytes, ChunkData& chunk);
+		static bool load(const std::string& path, ChunkData& chunk);
+		static bool save(const std::string& path, const ChunkData& chunk);
+	};
+}
+
+#endif // !HYP_WORLD_CHUNK_HPP
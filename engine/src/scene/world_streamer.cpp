@@ -0,0 +1,300 @@
+#include "world_streamer.hpp"
+#include <debug/flight_recorder.hpp>
+#include <debug/metrics.hpp>
+#include <io/file_system.hpp>
+#include <scene/components.hpp>
+#include <scene/entity.hpp>
+#include <scene/scene.hpp>
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <cmath>
+
+hyp::WorldStreamer::WorldStreamer(hyp::Scene& scene, const WorldStreamerSettings& settings)
+    : m_scene(scene), m_settings(settings) {
+	m_settings.evictRadius = std::max(m_settings.evictRadius, m_settings.loadRadius);
+}
+
+hyp::WorldStreamer::~WorldStreamer() {
+	clear();
+}
+
+uint64_t hyp::WorldStreamer::getKey(int32_t x, int32_t y) {
+	return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+float hyp::WorldStreamer::getDistance(const Cell& cell, const glm::vec3& position) const {
+	glm::vec2 min = glm::vec2((float)cell.x, (float)cell.y) * m_settings.cellSize;
+	glm::vec2 nearest = glm::clamp(glm::vec2(position), min, min + m_settings.cellSize);
+	return glm::length(glm::vec2(position) - nearest);
+}
+
+void hyp::WorldStreamer::update(const glm::vec3& position) {
+	HYP_PROFILE_SCOPE("WorldStreamer::update");
+
+	startEviction(position);
+	requestCells(position);
+
+	m_work.clear();
+	for (auto& [key, cell] : m_cells)
+	{
+		if (cell.state == CellState::Loading && cell.job.isDone())
+		{
+			if (!cell.load->found || cell.load->data.entities.empty())
+			{
+				cell.state = CellState::Loaded;
+				cell.load.reset();
+				continue;
+			}
+
+			cell.state = CellState::Integrating;
+			acquireTextures(cell);
+		}
+
+		if (cell.state == CellState::Integrating || cell.state == CellState::Evicting) m_work.push_back(&cell);
+	}
+
+	uploadTextures(m_settings.maxTextureUploadsPerFrame);
+
+	// evictions first, they free memory; then the cells nearest to the camera
+	std::sort(m_work.begin(), m_work.end(), [&](const Cell* a, const Cell* b) {
+		bool aEvicting = a->state == CellState::Evicting;
+		bool bEvicting = b->state == CellState::Evicting;
+		if (aEvicting != bEvicting) return aEvicting;
+		return getDistance(*a, position) < getDistance(*b, position);
+	});
+
+	uint32_t budget = m_settings.maxEntitiesPerFrame;
+	for (Cell* cell : m_work)
+	{
+		if (budget == 0) break;
+		budget -= cell->state == CellState::Evicting ? evict(*cell, budget) : integrate(*cell, budget);
+	}
+
+	std::erase_if(m_cells, [](const auto& entry) { return entry.second.state == CellState::Evicting && entry.second.entities.empty(); });
+
+	static hyp::Gauge& s_cellCount = hyp::Metrics::gauge("world.cells");
+	static hyp::Gauge& s_entityCount = hyp::Metrics::gauge("world.entities");
+	Stats stats = getStats();
+	s_cellCount.set((double)stats.loadedCells);
+	s_entityCount.set((double)stats.entities);
+	hyp::FlightRecorder::recordCounter("World.cells", (double)stats.loadedCells);
+}
+
+void hyp::WorldStreamer::requestCells(const glm::vec3& position) {
+	const float cellSize = m_settings.cellSize;
+	const float radius = m_settings.loadRadius;
+
+	int32_t minX = (int32_t)std::floor((position.x - radius) / cellSize);
+	int32_t maxX = (int32_t)std::floor((position.x + radius) / cellSize);
+	int32_t minY = (int32_t)std::floor((position.y - radius) / cellSize);
+	int32_t maxY = (int32_t)std::floor((position.y + radius) / cellSize);
+
+	for (int32_t y = minY; y <= maxY; y++)
+	{
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			uint64_t key = getKey(x, y);
+			// an evicting cell comes back once its entities are gone
+			if (m_cells.count(key)) continue;
+
+			Cell cell;
+			cell.x = x;
+			cell.y = y;
+			if (getDistance(cell, position) > radius) continue;
+
+			// the job only touches its own ChunkLoad, a cell evicted meanwhile just drops it
+			auto load = hyp::CreateRef<ChunkLoad>();
+			std::string path = hyp::WorldChunk::getPath(m_settings.directory, x, y);
+			cell.load = load;
+			cell.job = hyp::JobSystem::schedule([load, path]() {
+				if (!hyp::FileSystem::exists(path)) return;
+
+				HYP_PROFILE_ASSET(path);
+				load->found = hyp::WorldChunk::load(path, load->data);
+			});
+
+			m_cells.emplace(key, std::move(cell));
+		}
+	}
+}
+
+void hyp::WorldStreamer::startEviction(const glm::vec3& position) {
+	for (auto it = m_cells.begin(); it != m_cells.end();)
+	{
+		Cell& cell = it->second;
+		if (cell.state == CellState::Evicting || getDistance(cell, position) <= m_settings.evictRadius)
+		{
+			++it;
+			continue;
+		}
+
+		if (cell.entities.empty())
+		{
+			releaseTextures(cell);
+			it = m_cells.erase(it);
+			continue;
+		}
+
+		cell.state = CellState::Evicting;
+		cell.load.reset();
+		++it;
+	}
+}
+
+void hyp::WorldStreamer::acquireTextures(Cell& cell) {
+	cell.texturePaths = cell.load->data.textures;
+	cell.textures.assign(cell.texturePaths.size(), {});
+
+	for (const std::string& path : cell.texturePaths)
+	{
+		StreamedTexture& texture = m_textures[path];
+		if (texture.users++ > 0) continue;
+
+		auto image = hyp::CreateRef<hyp::ImageData>();
+		texture.image = image;
+		texture.job = hyp::JobSystem::schedule([image, path]() {
+			HYP_PROFILE_ASSET(path);
+			hyp::Texture::decode(path, *image);
+		});
+	}
+}
+
+void hyp::WorldStreamer::releaseTextures(Cell& cell) {
+	for (const std::string& path : cell.texturePaths)
+	{
+		auto it = m_textures.find(path);
+		if (it == m_textures.end() || --it->second.users > 0) continue;
+
+		// a decode still in flight only writes to its own image
+		if (it->second.handle) hyp::Resources::releaseTexture(it->second.handle);
+		m_textures.erase(it);
+	}
+
+	cell.texturePaths.clear();
+	cell.textures.clear();
+}
+
+uint32_t hyp::WorldStreamer::uploadTextures(uint32_t budget) {
+	uint32_t uploads = 0;
+	for (auto& [path, texture] : m_textures)
+	{
+		if (uploads >= budget) break;
+		if (!texture.image || !texture.job.isDone()) continue;
+
+		if (texture.image->isValid())
+		{
+			auto uploaded = hyp::CreateRef<hyp::Texture2D>(*texture.image, path);
+			if (uploaded->isLoaded()) texture.handle = hyp::Resources::addTexture(uploaded);
+		}
+
+		if (!texture.handle)
+		{
+			HYP_WARN("Failed to load world texture %s", path.c_str());
+			texture.failed = true;
+		}
+
+		texture.image.reset();
+		texture.job = {};
+		uploads++;
+	}
+
+	return uploads;
+}
+
+uint32_t hyp::WorldStreamer::integrate(Cell& cell, uint32_t budget) {
+	const hyp::ChunkData& data = cell.load->data;
+
+	// entities are only created once all of the cell's textures are resident (or failed)
+	for (size_t i = 0; i < cell.texturePaths.size(); i++)
+	{
+		if (cell.textures[i]) continue;
+
+		const StreamedTexture& texture = m_textures.at(cell.texturePaths[i]);
+		if (!texture.handle && !texture.failed) return 0;
+		cell.textures[i] = texture.handle;
+	}
+
+	uint32_t end = std::min((uint32_t)data.entities.size(), cell.nextEntity + budget);
+	uint32_t created = end - cell.nextEntity;
+
+	for (; cell.nextEntity < end; cell.nextEntity++)
+	{
+		const hyp::ChunkEntity& source = data.entities[cell.nextEntity];
+		hyp::Entity entity = m_scene.createEntity(source.name);
+
+		auto& transform = entity.get<hyp::TransformComponent>();
+		transform.position = source.position;
+		transform.size = source.size;
+		transform.rotation = source.rotation;
+
+		auto& sprite = entity.add<hyp::SpriteRendererComponent>(source.color);
+		sprite.tilingFactor = source.tilingFactor;
+		if (source.texture >= 0) sprite.texture = cell.textures[source.texture];
+
+		cell.entities.push_back(entity.getHandle());
+	}
+
+	if (cell.nextEntity == data.entities.size())
+	{
+		cell.state = CellState::Loaded;
+		cell.load.reset();
+	}
+
+	return created;
+}
+
+uint32_t hyp::WorldStreamer::evict(Cell& cell, uint32_t budget) {
+	entt::registry& registry = m_scene.getRegistry();
+
+	uint32_t destroyed = 0;
+	while (!cell.entities.empty() && destroyed < budget)
+	{
+		entt::entity handle = cell.entities.back();
+		cell.entities.pop_back();
+
+		// gameplay code may have destroyed it already
+		if (registry.valid(handle)) registry.destroy(handle);
+		destroyed++;
+	}
+
+	// the sprites that used them are gone now
+	if (cell.entities.empty()) releaseTextures(cell);
+	return destroyed;
+}
+
+void hyp::WorldStreamer::clear() {
+	entt::registry& registry = m_scene.getRegistry();
+	for (auto& [key, cell] : m_cells)
+	{
+		for (entt::entity handle : cell.entities)
+		{
+			if (registry.valid(handle)) registry.destroy(handle);
+		}
+		cell.entities.clear();
+		releaseTextures(cell);
+	}
+
+	m_cells.clear();
+}
+
+hyp::WorldStreamer::Stats hyp::WorldStreamer::getStats() const {
+	Stats stats;
+	for (const auto& [key, cell] : m_cells)
+	{
+		switch (cell.state)
+		{
+		case CellState::Loading: stats.loadingCells++; break;
+		case CellState::Integrating: stats.integratingCells++; break;
+		case CellState::Loaded: stats.loadedCells++; break;
+		case CellState::Evicting: stats.evictingCells++; break;
+		}
+		stats.entities += (uint32_t)cell.entities.size();
+	}
+
+	for (const auto& [path, texture] : m_textures)
+	{
+		if (texture.handle) stats.textures++;
+	}
+
+	return stats;
+}
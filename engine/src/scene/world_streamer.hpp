@@ -0,0 +1,138 @@
+#pragma once
+#ifndef HYP_WORLD_STREAMER_HPP
+	#define HYP_WORLD_STREAMER_HPP
+
+	#include <core/job_system.hpp>
+	#include <renderer/orthographic_camera.hpp>
+	#include <renderer/resources.hpp>
+	#include <scene/world_chunk.hpp>
+	#include <entt.hpp>
+	#include <glm/glm.hpp>
+	#include <string>
+	#include <unordered_map>
+	#include <vector>
+
+namespace hyp {
+	class Scene;
+
+	struct WorldStreamerSettings
+	{
+		std::string directory = "assets/world";
+		float cellSize = 1024.f;
+
+		// world units from the camera to the nearest point of a cell
+		float loadRadius = 1536.f;
+		float evictRadius = 2048.f; // > loadRadius, so a camera on a cell border doesn't thrash
+
+		// main-thread work per frame
+		uint32_t maxEntitiesPerFrame = 1024; // created or destroyed
+		uint32_t maxTextureUploadsPerFrame = 2;
+	};
+
+	/**
+	* \brief streams the cells of a chunked world into a Scene around a point (the active camera).
+	*
+	* Chunk files are read and parsed, and their textures decoded, on the JobSystem. The main thread
+	* only creates entities and uploads textures, within the per-frame budgets and nearest cell first.
+	* Cells beyond the evict radius lose their entities (again within budget) and release their textures,
+	* so memory is bounded by the view distance instead of the world size.
+	*
+	* Cells without a chunk file are remembered as empty. The streamer only touches the entities it
+	* created, and must be destroyed (or cleared) before its Scene.
+	*/
+	class WorldStreamer {
+	public:
+		struct Stats
+		{
+			uint32_t loadingCells = 0;
+			uint32_t integratingCells = 0;
+			uint32_t loadedCells = 0;
+			uint32_t evictingCells = 0;
+			uint32_t entities = 0;
+			uint32_t textures = 0;
+		};
+
+	public:
+		WorldStreamer(hyp::Scene& scene, const WorldStreamerSettings& settings = {});
+		~WorldStreamer();
+
+		WorldStreamer(const WorldStreamer&) = delete;
+		WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+		void update(const glm::vec3& position);
+		void update(const hyp::OrthoGraphicCamera& camera) { update(camera.getPosition()); }
+
+		/**
+		* \brief destroys every streamed entity right away, ignoring the budget
+		*/
+		void clear();
+
+		const WorldStreamerSettings& getSettings() const { return m_settings; }
+		Stats getStats() const;
+
+	private:
+		enum class CellState
+		{
+			Loading,     // chunk job in flight
+			Integrating, // waiting for textures and creating entities
+			Loaded,
+			Evicting // destroying entities
+		};
+
+		struct ChunkLoad
+		{
+			hyp::ChunkData data;
+			bool found = false;
+		};
+
+		struct Cell
+		{
+			int32_t x = 0;
+			int32_t y = 0;
+			CellState state = CellState::Loading;
+			hyp::JobHandle job;
+			hyp::Ref<ChunkLoad> load;
+
+			std::vector<std::string> texturePaths; // acquired in m_textures
+			std::vector<hyp::TextureHandle> textures; // resolved, per texture path
+			uint32_t nextEntity = 0;
+			std::vector<entt::entity> entities;
+		};
+
+		struct StreamedTexture
+		{
+			hyp::TextureHandle handle;
+			uint32_t users = 0;
+
+			// while being decoded
+			hyp::JobHandle job;
+			hyp::Ref<hyp::ImageData> image;
+			bool failed = false;
+		};
+
+		static uint64_t getKey(int32_t x, int32_t y);
+		float getDistance(const Cell& cell, const glm::vec3& position) const;
+
+		void requestCells(const glm::vec3& position);
+		void startEviction(const glm::vec3& position);
+
+		void acquireTextures(Cell& cell);
+		void releaseTextures(Cell& cell);
+		uint32_t uploadTextures(uint32_t budget);
+
+		uint32_t integrate(Cell& cell, uint32_t budget);
+		uint32_t evict(Cell& cell, uint32_t budget);
+
+	private:
+		hyp::Scene& m_scene;
+		WorldStreamerSettings m_settings;
+
+		std::unordered_map<uint64_t, Cell> m_cells;
+		std::unordered_map<std::string, StreamedTexture> m_textures;
+
+		// reused every frame
+		std::vector<Cell*> m_work;
+	};
+}
+
+#endif // !HYP_WORLD_STREAMER_HPP
@@ -0,0 +1,90 @@
+#include "script_allocator.hpp"
+#include <algorithm>
+
+namespace {
+	// keeps the 8-byte alignment Lua asks for (LUAI_MAXALIGN)
+	struct BlockHeader
+	{
+		uint32_t owner;
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(BlockHeader) == 8, "the block header must not break Lua's alignment");
+
+	BlockHeader* headerOf(void* ptr) {
+		return static_cast<BlockHeader*>(ptr) - 1;
+	}
+}
+
+// Lua objects are mostly small: strings, tables, closures and their arrays
+hyp::ScriptAllocator::ScriptAllocator()
+    : m_pool({ 32, 48, 64, 96, 128, 192, 256, 384, 512, 1024 }, 64 * 1024, MemoryTag::Scripting) {}
+
+void* hyp::ScriptAllocator::allocate(void* userData, void* ptr, size_t oldSize, size_t newSize) {
+	auto& self = *static_cast<ScriptAllocator*>(userData);
+
+	if (newSize == 0)
+	{
+		if (ptr)
+		{
+			BlockHeader* header = headerOf(ptr);
+			self.account(header->owner, -(int64_t)oldSize);
+			self.m_pool.deallocate(header, oldSize + sizeof(BlockHeader));
+			self.m_stats.frees++;
+		}
+		return nullptr;
+	}
+
+	return self.reallocate(ptr, oldSize, newSize);
+}
+
+void* hyp::ScriptAllocator::reallocate(void* ptr, size_t oldSize, size_t newSize) {
+	if (!ptr)
+	{
+		// oldSize encodes the object type when ptr is null
+		if (!canGrow(m_owner, newSize))
+		{
+			m_stats.refused++;
+			return nullptr;
+		}
+
+		auto* header = static_cast<BlockHeader*>(m_pool.allocate(newSize + sizeof(BlockHeader)));
+		header->owner = m_owner;
+		account(m_owner, (int64_t)newSize);
+		m_stats.allocations++;
+		return header + 1;
+	}
+
+	BlockHeader* header = headerOf(ptr);
+	uint32_t owner = header->owner;
+
+	// shrinking must never fail
+	if (newSize > oldSize && !canGrow(owner, newSize - oldSize))
+	{
+		m_stats.refused++;
+		return nullptr;
+	}
+
+	header = static_cast<BlockHeader*>(m_pool.reallocate(header, oldSize + sizeof(BlockHeader), newSize + sizeof(BlockHeader)));
+	account(owner, (int64_t)newSize - (int64_t)oldSize);
+	return header + 1;
+}
+
+bool hyp::ScriptAllocator::canGrow(uint32_t owner, size_t bytes) const {
+	if (m_limit && m_stats.currentBytes + (int64_t)bytes > (int64_t)m_limit) return false;
+	// the engine's own allocations are only bound by the state limit
+	if (m_ownerLimit && owner != 0 && getOwnerBytes(owner) + (int64_t)bytes > (int64_t)m_ownerLimit) return false;
+
+	return true;
+}
+
+void hyp::ScriptAllocator::account(uint32_t owner, int64_t bytes) {
+	if (owner >= m_ownerBytes.size())
+	{
+		m_ownerBytes.resize(owner + 1, 0);
+	}
+
+	m_ownerBytes[owner] += bytes;
+	m_stats.currentBytes += bytes;
+	m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.currentBytes);
+}
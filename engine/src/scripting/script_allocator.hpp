@@ -0,0 +1,76 @@
+#pragma once
+#ifndef HYPER_SCRIPT_ALLOCATOR_HPP
+	#define HYPER_SCRIPT_ALLOCATOR_HPP
+
+	#include <utils/pool_allocator.hpp>
+	#include <cstdint>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief lua_Alloc of the script engine's state.
+	*
+	* Blocks come from size-class pools (accounted to MemoryTag::Scripting) and carry the id of
+	* the owner that allocated them, so bytes can be reported per script. Owner 0 is the engine
+	* itself; script `handle` is owner `handle.getIndex() + 1`. Limits of 0 disable them; a
+	* refused allocation makes Lua run an emergency collection, then raise a memory error.
+	*/
+	class ScriptAllocator {
+	public:
+		struct Stats
+		{
+			int64_t currentBytes = 0;
+			int64_t peakBytes = 0;
+			uint64_t allocations = 0;
+			uint64_t frees = 0;
+			uint64_t refused = 0;
+		};
+
+		/**
+		* \brief attributes the allocations made until it goes out of scope to `owner`
+		*/
+		class Scope {
+		public:
+			Scope(ScriptAllocator& allocator, uint32_t owner)
+			    : m_allocator(allocator), m_previous(allocator.m_owner) { allocator.m_owner = owner; }
+			~Scope() { m_allocator.m_owner = m_previous; }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			ScriptAllocator& m_allocator;
+			uint32_t m_previous;
+		};
+
+	public:
+		ScriptAllocator();
+
+		static void* allocate(void* userData, void* ptr, size_t oldSize, size_t newSize);
+
+		void setLimit(size_t bytes) { m_limit = bytes; }
+		void setOwnerLimit(size_t bytes) { m_ownerLimit = bytes; }
+
+		uint32_t getOwner() const { return m_owner; }
+		int64_t getOwnerBytes(uint32_t owner) const { return owner < m_ownerBytes.size() ? m_ownerBytes[owner] : 0; }
+
+		const Stats& getStats() const { return m_stats; }
+		const PoolAllocator::Stats& getPoolStats() const { return m_pool.getStats(); }
+
+	private:
+		void* reallocate(void* ptr, size_t oldSize, size_t newSize);
+		bool canGrow(uint32_t owner, size_t bytes) const;
+		void account(uint32_t owner, int64_t bytes);
+
+	private:
+		PoolAllocator m_pool;
+		Stats m_stats;
+		std::vector<int64_t> m_ownerBytes;
+		uint32_t m_owner = 0;
+		size_t m_limit = 0;
+		size_t m_ownerLimit = 0;
+	};
+}
+
+#endif // !HYPER_SCRIPT_ALLOCATOR_HPP
@@ -0,0 +1,257 @@
+#include "script_arrays.hpp"
+#include <scripting/script_bindings.hpp>
+#include <scene/components.hpp>
+#include <renderer/renderer2d.hpp>
+#include <sol/sol.hpp>
+#include <algorithm>
+
+namespace hyp {
+
+	namespace {
+		const char* FloatArrayMeta = "hyp.FloatArray";
+
+		const uint32_t* s_entities = nullptr;
+		uint32_t s_entityCount = 0;
+
+		entt::registry& registry(lua_State* L) {
+			entt::registry* registry = ScriptBindings::getRegistry();
+			if (!registry || !s_entities)
+			{
+				luaL_error(L, "bulk component access is only available from a script call");
+			}
+			return *registry;
+		}
+
+		FloatArray* checkCapacity(lua_State* L, int index, uint32_t stride) {
+			FloatArray* array = ScriptArrays::check(L, index);
+			if ((uint64_t)s_entityCount * stride > array->count)
+			{
+				luaL_error(L, "array of %d floats is too small for %d entities", (int)array->count, (int)s_entityCount);
+			}
+			return array;
+		}
+
+		// 1-based, like every Lua sequence
+		int arrayIndex(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+
+			int isInteger = 0;
+			lua_Integer i = lua_tointegerx(L, 2, &isInteger);
+			if (isInteger)
+			{
+				luaL_argcheck(L, i >= 1 && i <= array->count, 2, "index out of range");
+				lua_pushnumber(L, array->data()[i - 1]);
+				return 1;
+			}
+
+			// methods
+			lua_pushvalue(L, 2);
+			lua_rawget(L, lua_upvalueindex(1));
+			return 1;
+		}
+
+		int arrayNewIndex(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+			lua_Integer i = luaL_checkinteger(L, 2);
+			luaL_argcheck(L, i >= 1 && i <= array->count, 2, "index out of range");
+			array->data()[i - 1] = (float)luaL_checknumber(L, 3);
+			return 0;
+		}
+
+		int arrayLength(lua_State* L) {
+			lua_pushinteger(L, ScriptArrays::check(L, 1)->count);
+			return 1;
+		}
+
+		int arrayFill(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+			float value = (float)luaL_checknumber(L, 2);
+			std::fill_n(array->data(), array->count, value);
+			return 0;
+		}
+
+		int arrayCopy(lua_State* L) {
+			FloatArray* destination = ScriptArrays::check(L, 1);
+			FloatArray* source = ScriptArrays::check(L, 2);
+			std::copy_n(source->data(), std::min(source->count, destination->count), destination->data());
+			return 0;
+		}
+
+		// array:toTable([table]): every element into a Lua sequence in one call, a new one unless given
+		int arrayToTable(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+			if (lua_istable(L, 2))
+				lua_settop(L, 2);
+			else
+				lua_createtable(L, (int)std::min<uint32_t>(array->count, INT32_MAX), 0);
+
+			const float* data = array->data();
+			for (uint32_t i = 0; i < array->count; i++)
+			{
+				lua_pushnumber(L, data[i]);
+				lua_rawseti(L, -2, (lua_Integer)i + 1);
+			}
+			return 1;
+		}
+
+		// array:fromTable(table): copies the leading numbers of a sequence, returns how many
+		int arrayFromTable(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+			luaL_checktype(L, 2, LUA_TTABLE);
+
+			lua_Integer length = std::min<lua_Integer>((lua_Integer)lua_rawlen(L, 2), array->count);
+			float* data = array->data();
+			for (lua_Integer i = 0; i < length; i++)
+			{
+				lua_rawgeti(L, 2, i + 1);
+				data[i] = (float)lua_tonumber(L, -1);
+				lua_pop(L, 1);
+			}
+
+			lua_pushinteger(L, length);
+			return 1;
+		}
+
+		int newFloatArray(lua_State* L) {
+			lua_Integer count = luaL_checkinteger(L, 1);
+			luaL_argcheck(L, count >= 0 && count <= UINT32_MAX, 1, "invalid array size");
+			FloatArray* array = ScriptArrays::push(L, (uint32_t)count);
+			std::fill_n(array->data(), array->count, 0.f);
+			return 1;
+		}
+
+		int readTransforms(lua_State* L) {
+			auto& reg = registry(L);
+			float* out = checkCapacity(L, 1, ScriptArrays::TransformStride)->data();
+
+			for (uint32_t i = 0; i < s_entityCount; i++, out += ScriptArrays::TransformStride)
+			{
+				const auto& transform = reg.get<TransformComponent>(entt::entity(s_entities[i]));
+				out[0] = transform.position.x;
+				out[1] = transform.position.y;
+				out[2] = transform.position.z;
+				out[3] = transform.size.x;
+				out[4] = transform.size.y;
+				out[5] = transform.rotation;
+			}
+
+			lua_pushinteger(L, s_entityCount);
+			return 1;
+		}
+
+		int writeTransforms(lua_State* L) {
+			auto& reg = registry(L);
+			const float* in = checkCapacity(L, 1, ScriptArrays::TransformStride)->data();
+
+			for (uint32_t i = 0; i < s_entityCount; i++, in += ScriptArrays::TransformStride)
+			{
+				auto& transform = reg.get<TransformComponent>(entt::entity(s_entities[i]));
+				transform.position = { in[0], in[1], in[2] };
+				transform.size = { in[3], in[4] };
+				transform.rotation = in[5];
+			}
+
+			lua_pushinteger(L, s_entityCount);
+			return 1;
+		}
+
+		int readColors(lua_State* L) {
+			auto& reg = registry(L);
+			float* out = checkCapacity(L, 1, ScriptArrays::ColorStride)->data();
+
+			for (uint32_t i = 0; i < s_entityCount; i++, out += ScriptArrays::ColorStride)
+			{
+				auto* sprite = reg.try_get<SpriteRendererComponent>(entt::entity(s_entities[i]));
+				glm::vec4 color = sprite ? sprite->color : glm::vec4(1.f);
+				std::copy_n(&color.x, 4, out);
+			}
+
+			lua_pushinteger(L, s_entityCount);
+			return 1;
+		}
+
+		int writeColors(lua_State* L) {
+			auto& reg = registry(L);
+			const float* in = checkCapacity(L, 1, ScriptArrays::ColorStride)->data();
+
+			for (uint32_t i = 0; i < s_entityCount; i++, in += ScriptArrays::ColorStride)
+			{
+				if (auto* sprite = reg.try_get<SpriteRendererComponent>(entt::entity(s_entities[i])))
+				{
+					sprite->color = { in[0], in[1], in[2], in[3] };
+				}
+			}
+
+			lua_pushinteger(L, s_entityCount);
+			return 1;
+		}
+
+		int drawQuads(lua_State* L) {
+			FloatArray* array = ScriptArrays::check(L, 1);
+			lua_Integer count = luaL_optinteger(L, 2, array->count / ScriptArrays::QuadStride);
+			luaL_argcheck(L, count >= 0 && (uint64_t)count * ScriptArrays::QuadStride <= array->count, 2, "more quads than the array holds");
+
+			// the array memory already has the QuadInstance layout
+			Renderer2D::drawQuads(reinterpret_cast<const Renderer2D::QuadInstance*>(array->data()), (uint32_t)count);
+			return 0;
+		}
+	}
+
+	void ScriptArrays::registerAll(lua_State* L) {
+		luaL_newmetatable(L, FloatArrayMeta);
+
+		lua_newtable(L);
+		lua_pushcfunction(L, arrayFill);
+		lua_setfield(L, -2, "fill");
+		lua_pushcfunction(L, arrayCopy);
+		lua_setfield(L, -2, "copy");
+		lua_pushcfunction(L, arrayLength);
+		lua_setfield(L, -2, "size");
+		lua_pushcfunction(L, arrayToTable);
+		lua_setfield(L, -2, "toTable");
+		lua_pushcfunction(L, arrayFromTable);
+		lua_setfield(L, -2, "fromTable");
+		lua_pushcclosure(L, arrayIndex, 1);
+		lua_setfield(L, -2, "__index");
+
+		lua_pushcfunction(L, arrayNewIndex);
+		lua_setfield(L, -2, "__newindex");
+		lua_pushcfunction(L, arrayLength);
+		lua_setfield(L, -2, "__len");
+		lua_pop(L, 1);
+
+		const luaL_Reg functions[] = {
+			{ "newFloatArray", newFloatArray },
+			{ "readTransforms", readTransforms },
+			{ "writeTransforms", writeTransforms },
+			{ "readColors", readColors },
+			{ "writeColors", writeColors },
+			{ "drawQuads", drawQuads },
+			{ nullptr, nullptr }
+		};
+		luaL_setfuncs(L, functions, 0);
+
+		lua_pushinteger(L, TransformStride);
+		lua_setfield(L, -2, "TransformStride");
+		lua_pushinteger(L, ColorStride);
+		lua_setfield(L, -2, "ColorStride");
+		lua_pushinteger(L, QuadStride);
+		lua_setfield(L, -2, "QuadStride");
+	}
+
+	FloatArray* ScriptArrays::push(lua_State* L, uint32_t count) {
+		auto* array = static_cast<FloatArray*>(lua_newuserdatauv(L, sizeof(FloatArray) + (size_t)count * sizeof(float), 0));
+		array->count = count;
+		luaL_setmetatable(L, FloatArrayMeta);
+		return array;
+	}
+
+	FloatArray* ScriptArrays::check(lua_State* L, int index) {
+		return static_cast<FloatArray*>(luaL_checkudata(L, index, FloatArrayMeta));
+	}
+
+	void ScriptArrays::setEntities(const uint32_t* entities, uint32_t count) {
+		s_entities = entities;
+		s_entityCount = count;
+	}
+}
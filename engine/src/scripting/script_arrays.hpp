@@ -0,0 +1,58 @@
+#pragma once
+#ifndef HYPER_SCRIPT_ARRAYS_HPP
+	#define HYPER_SCRIPT_ARRAYS_HPP
+
+	#include <cstdint>
+
+struct lua_State;
+
+namespace hyp {
+
+	/**
+	* \brief fixed-size float array living inside a Lua userdata.
+	*
+	* The engine reads and writes it as plain contiguous memory, once per batch. On the script side
+	* indexing it is still a metamethod call per element; array:toTable / array:fromTable move the
+	* whole array from or into a Lua sequence in a single call instead.
+	*/
+	struct FloatArray
+	{
+		uint32_t count;
+
+		float* data() { return reinterpret_cast<float*>(this + 1); }
+	};
+
+	/**
+	* \brief bulk bindings added to the `hyp` table:
+	*
+	* - hyp.newFloatArray(count)
+	* - hyp.readTransforms(array) / hyp.writeTransforms(array): x, y, z, width, height, rotation per entity
+	* - hyp.readColors(array) / hyp.writeColors(array): r, g, b, a per entity
+	* - hyp.drawQuads(array, count): x, y, z, width, height, r, g, b, a per quad
+	*
+	* - array:fill(value), array:copy(source), array:size(), array:toTable([table]), array:fromTable(table)
+	*
+	* The read/write functions act on the entity batch of the running script call and return its size.
+	* Arrays are copies, not views: readTransforms/readColors snapshot the components, and edits reach
+	* the scene only through writeTransforms/writeColors.
+	*/
+	class ScriptArrays {
+	public:
+		static constexpr uint32_t TransformStride = 6;
+		static constexpr uint32_t ColorStride = 4;
+		static constexpr uint32_t QuadStride = 9;
+
+		// expects the `hyp` table on top of the stack
+		static void registerAll(lua_State* L);
+
+		static FloatArray* push(lua_State* L, uint32_t count);
+		static FloatArray* check(lua_State* L, int index);
+
+		/**
+		* \brief entities of the script call in progress, set by the ScriptSystem
+		*/
+		static void setEntities(const uint32_t* entities, uint32_t count);
+	};
+}
+
+#endif // !HYPER_SCRIPT_ARRAYS_HPP
@@ -0,0 +1,98 @@
+#include "script_bindings.hpp"
+#include <scene/components.hpp>
+#include <io/input.hpp>
+#include <scripting/script_arrays.hpp>
+#include <utils/logger.hpp>
+#include <sol/sol.hpp>
+
+namespace hyp {
+
+	namespace {
+		entt::registry* s_registry = nullptr;
+
+		// scheduler tasks run outside any scene, their entity calls fail like any other bad call
+		entt::registry& registry(lua_State* L) {
+			if (!s_registry) luaL_error(L, "no scene is running scripts");
+			return *s_registry;
+		}
+
+		// ids come straight from scripts: stale, invalid or missing the component raises a Lua error
+		template <typename T>
+		T& componentOf(lua_State* L, uint32_t id, const char* component) {
+			entt::registry& reg = registry(L);
+			entt::entity entity = entt::entity(id);
+
+			T* found = reg.valid(entity) ? reg.try_get<T>(entity) : nullptr;
+			if (!found) luaL_error(L, "entity %d is invalid or has no %s", (int)id, component);
+			return *found;
+		}
+
+		TransformComponent& transformOf(lua_State* L, uint32_t entity) {
+			return componentOf<TransformComponent>(L, entity, "transform");
+		}
+	}
+
+	void ScriptBindings::registerAll(sol::state& lua) {
+		sol::table hyp = lua.create_named_table("hyp");
+
+		hyp.set_function("log", [](const std::string& message) {
+			HYP_INFO("[lua] %s", message.c_str());
+		});
+
+		hyp.set_function("isValid", [](uint32_t entity) {
+			return s_registry && s_registry->valid(entt::entity(entity));
+		});
+
+		hyp.set_function("getPosition", [](sol::this_state L, uint32_t entity) {
+			const auto& position = transformOf(L, entity).position;
+			return std::make_tuple(position.x, position.y, position.z);
+		});
+
+		hyp.set_function("setPosition", [](sol::this_state L, uint32_t entity, float x, float y, sol::optional<float> z) {
+			auto& position = transformOf(L, entity).position;
+			position.x = x;
+			position.y = y;
+			if (z) position.z = *z;
+		});
+
+		hyp.set_function("getSize", [](sol::this_state L, uint32_t entity) {
+			const auto& size = transformOf(L, entity).size;
+			return std::make_tuple(size.x, size.y);
+		});
+
+		hyp.set_function("setSize", [](sol::this_state L, uint32_t entity, float width, float height) {
+			transformOf(L, entity).size = { width, height };
+		});
+
+		hyp.set_function("getRotation", [](sol::this_state L, uint32_t entity) {
+			return transformOf(L, entity).rotation;
+		});
+
+		hyp.set_function("setRotation", [](sol::this_state L, uint32_t entity, float rotation) {
+			transformOf(L, entity).rotation = rotation;
+		});
+
+		hyp.set_function("setColor", [](sol::this_state L, uint32_t entity, float r, float g, float b, sol::optional<float> a) {
+			auto& sprite = componentOf<SpriteRendererComponent>(L, entity, "sprite");
+			sprite.color = { r, g, b, a.value_or(1.f) };
+		});
+
+		hyp.set_function("isKeyPressed", [](int key) {
+			return hyp::Input::isKeyPressed((hyp::Key)key);
+		});
+
+		// bulk variants of the accessors above
+		lua_State* L = lua.lua_state();
+		hyp.push();
+		ScriptArrays::registerAll(L);
+		lua_pop(L, 1);
+	}
+
+	void ScriptBindings::setRegistry(entt::registry* registry) {
+		s_registry = registry;
+	}
+
+	entt::registry* ScriptBindings::getRegistry() {
+		return s_registry;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#ifndef HYPER_SCRIPT_BINDINGS_HPP
+	#define HYPER_SCRIPT_BINDINGS_HPP
+
+	#include <entt.hpp>
+
+namespace sol {
+	class state;
+}
+
+namespace hyp {
+
+	/**
+	* \brief the `hyp` table exposed to scripts. Entities are passed around as integers,
+	* the functions act on the registry of the scene currently running its scripts. An invalid entity,
+	* a missing component or a call made outside a scene (scheduler tasks) raises a Lua error.
+	*/
+	class ScriptBindings {
+	public:
+		static void registerAll(sol::state& lua);
+
+		static void setRegistry(entt::registry* registry);
+		static entt::registry* getRegistry();
+	};
+}
+
+#endif // !HYPER_SCRIPT_BINDINGS_HPP
@@ -0,0 +1,322 @@
+#include "script_engine.hpp"
+#include <scripting/script_allocator.hpp>
+#include <scripting/script_bindings.hpp>
+#include <scripting/script_scheduler.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <utils/logger.hpp>
+#include <sol/sol.hpp>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace hyp {
+
+	namespace {
+		struct BytecodeHeader
+		{
+			char magic[4] = { 'H', 'Y', 'P', 'B' };
+			uint32_t luaVersion = LUA_VERSION_NUM;
+			uint64_t sourceSize = 0;
+			int64_t sourceTime = 0;
+		};
+
+		// percent of the heap after a cycle the heap grows to before the collector starts on its own
+		constexpr int GcPause = 400;
+
+		// declared first: the state frees its memory through it when destroyed
+		hyp::Scope<ScriptAllocator> s_allocator;
+		hyp::Scope<sol::state> s_lua;
+		hyp::Scope<hyp::ResourceRegistry<Script>> s_scripts;
+		hyp::Scope<ScriptScheduler> s_scheduler;
+		std::unordered_map<std::string, ScriptHandle> s_scriptsByPath;
+		std::filesystem::path s_cacheDirectory = ".cache/scripts";
+
+		uint64_t hashPath(const std::string& path) {
+			// FNV-1a
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : path)
+			{
+				hash ^= (unsigned char)c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		std::filesystem::path getCachePath(const std::filesystem::path& source) {
+			char name[32];
+			snprintf(name, sizeof(name), "%016llx.luac", (unsigned long long)hashPath(source.generic_string()));
+			return s_cacheDirectory / name;
+		}
+
+		bool readFile(const std::filesystem::path& path, std::vector<char>& data) {
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file.is_open()) return false;
+
+			data.resize((size_t)file.tellg());
+			file.seekg(0);
+			file.read(data.data(), data.size());
+			return (bool)file;
+		}
+
+		int writeChunk(lua_State*, const void* data, size_t size, void* userData) {
+			auto& buffer = *static_cast<std::vector<char>*>(userData);
+			buffer.insert(buffer.end(), (const char*)data, (const char*)data + size);
+			return 0;
+		}
+
+		/**
+		* \brief pushes the compiled chunk of `path`, from the bytecode cache when it is up to date
+		*/
+		bool loadChunk(lua_State* L, const std::filesystem::path& path) {
+			std::error_code error;
+			BytecodeHeader expected;
+			expected.sourceSize = std::filesystem::file_size(path, error);
+			if (error)
+			{
+				HYP_ERROR("Script %s does not exist", path.string().c_str());
+				return false;
+			}
+			expected.sourceTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+			std::string chunkName = "@" + path.generic_string();
+			std::filesystem::path cachePath = getCachePath(path);
+
+			std::vector<char> cached;
+			if (readFile(cachePath, cached) && cached.size() > sizeof(BytecodeHeader))
+			{
+				BytecodeHeader header;
+				std::memcpy(&header, cached.data(), sizeof(header));
+
+				if (std::memcmp(&header, &expected, sizeof(header)) == 0)
+				{
+					const char* bytecode = cached.data() + sizeof(header);
+					if (luaL_loadbufferx(L, bytecode, cached.size() - sizeof(header), chunkName.c_str(), "b") == LUA_OK)
+					{
+						return true;
+					}
+
+					// stale or corrupt cache, compile from source instead
+					lua_pop(L, 1);
+				}
+			}
+
+			std::vector<char> source;
+			if (!readFile(path, source))
+			{
+				HYP_ERROR("Failed to read script %s", path.string().c_str());
+				return false;
+			}
+
+			if (luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t") != LUA_OK)
+			{
+				HYP_ERROR("%s", lua_tostring(L, -1));
+				lua_pop(L, 1);
+				return false;
+			}
+
+			std::vector<char> buffer(sizeof(BytecodeHeader));
+			std::memcpy(buffer.data(), &expected, sizeof(expected));
+			// keep the debug info, errors should still point at source lines
+			lua_dump(L, writeChunk, &buffer, 0);
+
+			std::filesystem::create_directories(cachePath.parent_path(), error);
+			std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+			if (file.is_open())
+			{
+				file.write(buffer.data(), buffer.size());
+			}
+			else
+			{
+				HYP_WARN("Failed to write bytecode cache %s", cachePath.string().c_str());
+			}
+
+			return true;
+		}
+
+		int getFunctionRef(lua_State* L, int module, const char* name) {
+			if (lua_getfield(L, module, name) != LUA_TFUNCTION)
+			{
+				lua_pop(L, 1);
+				return LUA_NOREF;
+			}
+			return luaL_ref(L, LUA_REGISTRYINDEX);
+		}
+
+		int traceback(lua_State* L) {
+			luaL_traceback(L, L, lua_tostring(L, 1), 1);
+			return 1;
+		}
+	}
+
+	Script::~Script() {
+		lua_State* L = ScriptEngine::getState();
+		if (!L) return;
+
+		luaL_unref(L, LUA_REGISTRYINDEX, module);
+		luaL_unref(L, LUA_REGISTRYINDEX, onCreate);
+		luaL_unref(L, LUA_REGISTRYINDEX, onUpdate);
+	}
+
+	void ScriptEngine::init() {
+		if (s_lua) return;
+
+		HYP_MEMORY_SCOPE(hyp::MemoryTag::Scripting);
+		s_allocator = hyp::CreateScope<ScriptAllocator>();
+		s_lua = hyp::CreateScope<sol::state>(sol::default_at_panic, &ScriptAllocator::allocate, s_allocator.get());
+		s_lua->open_libraries(sol::lib::base, sol::lib::math, sol::lib::string, sol::lib::table);
+
+		// incremental collection, stepped by collectGarbage from the frame's idle time. The automatic
+		// collector stays on as a safety net for frames without slack, but with a large pause it only
+		// starts a cycle once the heap reached 4x its size after the previous one.
+		lua_State* L = s_lua->lua_state();
+		lua_gc(L, LUA_GCINC, GcPause, 0, 0);
+		s_scripts = hyp::CreateScope<hyp::ResourceRegistry<Script>>(0);
+
+		ScriptBindings::registerAll(*s_lua);
+		s_scheduler = hyp::CreateScope<ScriptScheduler>(L, s_allocator.get());
+		HYP_INFO("Initialized script engine (%s)", LUA_RELEASE);
+	}
+
+	void ScriptEngine::deinit() {
+		if (!s_lua) return;
+
+		// the scripts and tasks unref themselves, the state must still be alive
+		s_scheduler.reset();
+		s_scriptsByPath.clear();
+		s_scripts.reset();
+		s_lua.reset();
+		s_allocator.reset();
+	}
+
+	bool ScriptEngine::isInitialized() {
+		return s_lua != nullptr;
+	}
+
+	lua_State* ScriptEngine::getState() {
+		return s_lua ? s_lua->lua_state() : nullptr;
+	}
+
+	ScriptScheduler& ScriptEngine::getScheduler() {
+		HYP_ASSERT_CORE(s_scheduler, "script engine is not initialized");
+		return *s_scheduler;
+	}
+
+	ScriptAllocator& ScriptEngine::getAllocator() {
+		HYP_ASSERT_CORE(s_allocator, "script engine is not initialized");
+		return *s_allocator;
+	}
+
+	bool ScriptEngine::collectGarbage(double maxMs) {
+		lua_State* L = getState();
+		if (!L) return false;
+
+		auto start = std::chrono::steady_clock::now();
+		do
+		{
+			// a zero step size performs one basic step
+			if (lua_gc(L, LUA_GCSTEP, 0)) return true;
+		} while (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < maxMs);
+
+		return false;
+	}
+
+	void ScriptEngine::setMemoryLimit(size_t bytes) {
+		getAllocator().setLimit(bytes);
+	}
+
+	void ScriptEngine::setScriptMemoryLimit(size_t bytes) {
+		getAllocator().setOwnerLimit(bytes);
+	}
+
+	int64_t ScriptEngine::getMemoryUsage() {
+		return s_allocator ? s_allocator->getStats().currentBytes : 0;
+	}
+
+	int64_t ScriptEngine::getScriptMemoryUsage(ScriptHandle handle) {
+		return s_allocator ? s_allocator->getOwnerBytes(getMemoryOwner(handle)) : 0;
+	}
+
+	void ScriptEngine::setBytecodeCacheDirectory(const std::filesystem::path& directory) {
+		s_cacheDirectory = directory;
+	}
+
+	ScriptHandle ScriptEngine::loadScript(const std::filesystem::path& path) {
+		HYP_ASSERT_CORE(s_lua, "script engine is not initialized");
+
+		std::string key = path.generic_string();
+		auto it = s_scriptsByPath.find(key);
+		if (it != s_scriptsByPath.end() && s_scripts->isValid(it->second))
+		{
+			return it->second;
+		}
+
+		HYP_MEMORY_SCOPE(hyp::MemoryTag::Scripting);
+		HYP_PROFILE_ASSET(key);
+
+		// registered up front, so the module's allocations are attributed to it
+		auto script = hyp::CreateRef<Script>();
+		script->path = key;
+		ScriptHandle handle = s_scripts->add(script);
+		ScriptAllocator::Scope owner(*s_allocator, getMemoryOwner(handle));
+
+		lua_State* L = getState();
+		if (!loadChunk(L, path) || !call(key.c_str(), 0, 1))
+		{
+			s_scripts->release(handle, 0);
+			s_scripts->collect(0);
+			return {};
+		}
+
+		if (!lua_istable(L, -1))
+		{
+			HYP_ERROR("Script %s must return a table", key.c_str());
+			lua_pop(L, 1);
+			s_scripts->release(handle, 0);
+			s_scripts->collect(0);
+			return {};
+		}
+
+		script->onCreate = getFunctionRef(L, -1, "onCreate");
+		script->onUpdate = getFunctionRef(L, -1, "onUpdate");
+		script->module = luaL_ref(L, LUA_REGISTRYINDEX);
+
+		s_scriptsByPath[key] = handle;
+		return handle;
+	}
+
+	Script* ScriptEngine::getScript(ScriptHandle handle) {
+		return s_scripts ? s_scripts->get(handle) : nullptr;
+	}
+
+	void ScriptEngine::releaseScript(ScriptHandle handle) {
+		Script* script = getScript(handle);
+		if (!script) return;
+
+		s_scriptsByPath.erase(script->path);
+		s_scripts->release(handle, 0);
+		s_scripts->collect(0);
+	}
+
+	bool ScriptEngine::call(const char* name, int argCount, int resultCount) {
+		lua_State* L = getState();
+
+		int base = lua_gettop(L) - argCount;
+		lua_pushcfunction(L, traceback);
+		lua_insert(L, base);
+
+		int status = lua_pcall(L, argCount, resultCount, base);
+		lua_remove(L, base);
+
+		if (status != LUA_OK)
+		{
+			HYP_ERROR("%s: %s", name, lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return false;
+		}
+
+		return true;
+	}
+}
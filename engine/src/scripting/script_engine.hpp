@@ -0,0 +1,79 @@
+#pragma once
+#ifndef HYPER_SCRIPT_ENGINE_HPP
+	#define HYPER_SCRIPT_ENGINE_HPP
+
+	#include <core/handle.hpp>
+	#include <filesystem>
+	#include <string>
+
+struct lua_State;
+
+namespace hyp {
+
+	/**
+	* \brief a loaded script module.
+	*
+	* A script is a Lua chunk returning a table; its optional `onCreate(entities, count)` and
+	* `onUpdate(entities, count, dt)` functions are called once per frame for every entity using it.
+	* The ints are Lua registry references (LUA_NOREF when the function is missing).
+	*/
+	struct Script
+	{
+		std::string path;
+		int module = -2;
+		int onCreate = -2;
+		int onUpdate = -2;
+
+		~Script();
+	};
+
+	using ScriptHandle = hyp::Handle<Script>;
+
+	class ScriptScheduler;
+	class ScriptAllocator;
+
+	class ScriptEngine {
+	public:
+		static void init();
+		static void deinit();
+		static bool isInitialized();
+
+		static lua_State* getState();
+		static ScriptScheduler& getScheduler();
+		static ScriptAllocator& getAllocator();
+
+		/**
+		* \brief garbage is mostly collected in frame slack through this function; the automatic collector
+		* only kicks in once the heap grew well past its last collected size. Returns true when a full cycle completed.
+		*/
+		static bool collectGarbage(double maxMs);
+
+		// hard caps in bytes for the whole state and for each script (0 -> none)
+		static void setMemoryLimit(size_t bytes);
+		static void setScriptMemoryLimit(size_t bytes);
+
+		static int64_t getMemoryUsage();
+		static int64_t getScriptMemoryUsage(ScriptHandle handle);
+		static uint32_t getMemoryOwner(ScriptHandle handle) { return handle.getIndex() + 1; }
+
+		/**
+		* \brief compiled chunks are kept here as Lua bytecode (".cache/scripts" by default)
+		*/
+		static void setBytecodeCacheDirectory(const std::filesystem::path& directory);
+
+		/**
+		* \brief loads a script once, later calls with the same path return the same handle
+		*/
+		static ScriptHandle loadScript(const std::filesystem::path& path);
+		static Script* getScript(ScriptHandle handle);
+		static void releaseScript(ScriptHandle handle);
+
+		/**
+		* \brief protected call of the function below the `argCount` arguments on top of the stack;
+		* errors are logged with a traceback under `name`.
+		*/
+		static bool call(const char* name, int argCount, int resultCount = 0);
+	};
+}
+
+#endif // !HYPER_SCRIPT_ENGINE_HPP
@@ -0,0 +1,312 @@
+#include "script_scheduler.hpp"
+#include <scripting/script_allocator.hpp>
+#include <debug/flight_recorder.hpp>
+#include <utils/logger.hpp>
+#include <sol/sol.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	const auto s_epoch = Clock::now();
+
+	// state of the slice in progress, the hook has no other way to reach it
+	lua_State* s_runningThread = nullptr;
+	Clock::time_point s_sliceDeadline;
+	bool s_preempted = false;
+
+	double elapsedMs(Clock::time_point since) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+	}
+
+	double nowSeconds() {
+		return std::chrono::duration<double>(Clock::now() - s_epoch).count();
+	}
+
+	void countHook(lua_State* L, lua_Debug*) {
+		// coroutines created by the task inherit the hook; yielding them would look like a
+		// coroutine.yield() to the task, so only the task's own thread is preempted
+		if (L != s_runningThread || Clock::now() < s_sliceDeadline) return;
+
+		// inside a C call (table.sort comparator, gsub callback, bound C++ calling back into Lua)
+		// yielding would error; the hook fires again after the next instruction count and
+		// preempts at the first yieldable point
+		if (!lua_isyieldable(L)) return;
+
+		s_preempted = true;
+		lua_yield(L, 0);
+	}
+
+	hyp::ScriptScheduler& scheduler(lua_State* L) {
+		return *static_cast<hyp::ScriptScheduler*>(lua_touserdata(L, lua_upvalueindex(1)));
+	}
+
+	int luaSpawn(lua_State* L) {
+		luaL_checktype(L, 1, LUA_TFUNCTION);
+
+		const char* priorities[] = { "high", "normal", "low", nullptr };
+		auto priority = (hyp::ScriptPriority)luaL_checkoption(L, 2, "normal", priorities);
+
+		lua_Debug caller;
+		std::string name;
+		if (lua_isstring(L, 3))
+		{
+			name = lua_tostring(L, 3);
+		}
+		else if (lua_getstack(L, 1, &caller) && lua_getinfo(L, "Sl", &caller))
+		{
+			name = std::string(caller.short_src) + ":" + std::to_string(caller.currentline);
+		}
+		else
+		{
+			name = "task";
+		}
+
+		lua_pushvalue(L, 1);
+		lua_pushinteger(L, scheduler(L).spawn(L, name, priority));
+		return 1;
+	}
+
+	int luaCancel(lua_State* L) {
+		lua_pushboolean(L, scheduler(L).cancel((hyp::ScriptScheduler::TaskId)luaL_checkinteger(L, 1)));
+		return 1;
+	}
+
+	int luaWait(lua_State* L) {
+		if (!lua_isyieldable(L)) return luaL_error(L, "hyp.wait can only be called from a spawned task");
+
+		lua_pushnumber(L, luaL_checknumber(L, 1));
+		return lua_yield(L, 1);
+	}
+
+	int luaNextFrame(lua_State* L) {
+		if (!lua_isyieldable(L)) return luaL_error(L, "hyp.nextFrame can only be called from a spawned task");
+
+		return lua_yield(L, 0);
+	}
+}
+
+hyp::ScriptScheduler::ScriptScheduler(lua_State* L, ScriptAllocator* allocator)
+    : m_state(L), m_allocator(allocator) {
+	const luaL_Reg functions[] = {
+		{ "spawn", luaSpawn },
+		{ "cancel", luaCancel },
+		{ "wait", luaWait },
+		{ "nextFrame", luaNextFrame },
+		{ nullptr, nullptr }
+	};
+
+	if (lua_getglobal(L, "hyp") != LUA_TTABLE)
+	{
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setglobal(L, "hyp");
+	}
+
+	lua_pushlightuserdata(L, this);
+	luaL_setfuncs(L, functions, 1);
+	lua_pop(L, 1);
+}
+
+hyp::ScriptScheduler::~ScriptScheduler() {
+	for (auto& queue : m_queues)
+	{
+		for (auto& task : queue)
+		{
+			release(task);
+		}
+	}
+}
+
+hyp::ScriptScheduler::TaskId hyp::ScriptScheduler::spawn(lua_State* L, const std::string& name, ScriptPriority priority) {
+	lua_State* thread = lua_newthread(L);
+	lua_sethook(thread, countHook, LUA_MASKCOUNT, m_hookInterval);
+
+	// thread below the function: move the function into the thread, anchor the thread
+	lua_rotate(L, -2, 1);
+	lua_xmove(L, thread, 1);
+	int threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	Task task;
+	task.id = m_nextId++;
+	task.name = name;
+	task.thread = thread;
+	task.threadRef = threadRef;
+	task.priority = priority;
+	task.memoryOwner = m_allocator ? m_allocator->getOwner() : 0;
+
+	m_queues[static_cast<size_t>(priority)].push_back(std::move(task));
+	return m_nextId - 1;
+}
+
+bool hyp::ScriptScheduler::cancel(TaskId id) {
+	for (auto& queue : m_queues)
+	{
+		auto it = std::find_if(queue.begin(), queue.end(), [id](const Task& task) { return task.id == id && !task.cancelled; });
+		if (it != queue.end())
+		{
+			if (m_running)
+			{
+				it->cancelled = true;
+				return true;
+			}
+
+			release(*it);
+			queue.erase(it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+double hyp::ScriptScheduler::run(double budgetMs) {
+	HYP_PROFILE_SCOPE("ScriptScheduler::run");
+
+	auto start = Clock::now();
+	double now = nowSeconds();
+	m_running = true;
+
+	for (size_t level = 0; level < m_queues.size(); level++)
+	{
+		auto& queue = m_queues[level];
+
+		// only the tasks queued at this point: a task resumed this frame waits for the next one
+		size_t count = queue.size();
+		while (count-- && elapsedMs(start) < budgetMs)
+		{
+			Task task = std::move(queue.front());
+			queue.pop_front();
+
+			if (task.cancelled)
+			{
+				release(task);
+				continue;
+			}
+
+			if (task.wakeTime > now)
+			{
+				queue.push_back(std::move(task));
+				continue;
+			}
+
+			double sliceMs = std::min(m_sliceBudgetMs, budgetMs - elapsedMs(start));
+			SliceResult result = resume(task, sliceMs);
+
+			if (result == SliceResult::Finished)
+			{
+				release(task);
+				continue;
+			}
+
+			if (result == SliceResult::Preempted)
+			{
+				task.preemptedInARow++;
+
+				if (!task.reported)
+				{
+					HYP_WARN("Script task '%s' exceeded its %.2fms slice, it will be resumed next frame", task.name.c_str(), sliceMs);
+					task.reported = true;
+				}
+
+				if (task.preemptedInARow >= m_demoteAfter && task.priority != ScriptPriority::Low)
+				{
+					task.priority = (ScriptPriority)((size_t)task.priority + 1);
+					task.preemptedInARow = 0;
+					HYP_WARN("Script task '%s' never yields, lowered its priority", task.name.c_str());
+				}
+			}
+			else
+			{
+				task.preemptedInARow = 0;
+			}
+
+			m_queues[static_cast<size_t>(task.priority)].push_back(std::move(task));
+		}
+	}
+
+	m_running = false;
+
+	// cancelled tasks the budget didn't reach
+	for (auto& queue : m_queues)
+	{
+		for (auto it = queue.begin(); it != queue.end();)
+		{
+			if (!it->cancelled)
+			{
+				++it;
+				continue;
+			}
+
+			release(*it);
+			it = queue.erase(it);
+		}
+	}
+
+	m_lastUsedMs = elapsedMs(start);
+	return m_lastUsedMs;
+}
+
+size_t hyp::ScriptScheduler::getTaskCount() const {
+	size_t count = 0;
+	for (const auto& queue : m_queues)
+		count += queue.size();
+	return count;
+}
+
+hyp::ScriptScheduler::SliceResult hyp::ScriptScheduler::resume(Task& task, double sliceMs) {
+	auto start = Clock::now();
+
+	s_runningThread = task.thread;
+	s_sliceDeadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(sliceMs));
+	s_preempted = false;
+
+	int resultCount = 0;
+	int status;
+	if (m_allocator)
+	{
+		ScriptAllocator::Scope owner(*m_allocator, task.memoryOwner);
+		status = lua_resume(task.thread, m_state, 0, &resultCount);
+	}
+	else
+	{
+		status = lua_resume(task.thread, m_state, 0, &resultCount);
+	}
+	s_runningThread = nullptr;
+
+	double ms = elapsedMs(start);
+	auto& stats = m_stats[task.name];
+	stats.resumes++;
+	stats.totalMs += ms;
+	stats.maxSliceMs = std::max(stats.maxSliceMs, ms);
+
+	if (status == LUA_YIELD)
+	{
+		if (s_preempted)
+		{
+			stats.preemptions++;
+			return SliceResult::Preempted;
+		}
+
+		// hyp.wait(seconds) yields the delay
+		task.wakeTime = resultCount > 0 && lua_isnumber(task.thread, -1) ? nowSeconds() + lua_tonumber(task.thread, -1) : 0.0;
+		lua_pop(task.thread, resultCount);
+		return SliceResult::Yielded;
+	}
+
+	if (status != LUA_OK)
+	{
+		luaL_traceback(m_state, task.thread, lua_tostring(task.thread, -1), 0);
+		HYP_ERROR("Script task '%s' failed: %s", task.name.c_str(), lua_tostring(m_state, -1));
+		lua_pop(m_state, 1);
+	}
+
+	return SliceResult::Finished;
+}
+
+void hyp::ScriptScheduler::release(Task& task) {
+	luaL_unref(m_state, LUA_REGISTRYINDEX, task.threadRef);
+	task.threadRef = LUA_NOREF;
+}
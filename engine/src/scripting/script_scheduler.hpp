@@ -0,0 +1,117 @@
+#pragma once
+#ifndef HYPER_SCRIPT_SCHEDULER_HPP
+	#define HYPER_SCRIPT_SCHEDULER_HPP
+
+	#include <array>
+	#include <cstdint>
+	#include <deque>
+	#include <string>
+	#include <unordered_map>
+
+struct lua_State;
+
+namespace hyp {
+
+	class ScriptAllocator;
+
+	enum class ScriptPriority : uint8_t
+	{
+		High = 0,
+		Normal,
+		Low,
+		Count
+	};
+
+	struct ScriptTaskStats
+	{
+		uint64_t resumes = 0;
+		uint64_t preemptions = 0; // slices cut short by the scheduler
+		double totalMs = 0.0;
+		double maxSliceMs = 0.0;
+	};
+
+	/**
+	* \brief runs long-lived Lua coroutines (AI, level scripts...) under a per-frame budget.
+	*
+	* A count hook checks the clock every few hundred instructions and yields the running
+	* coroutine once its slice is spent; it is resumed on a later frame. Tasks are visited by
+	* priority, round-robin within a priority. A task that keeps getting preempted is reported
+	* and demoted, so a misbehaving script costs its slice instead of frames.
+	*
+	* From Lua: hyp.spawn(fn [, "high"|"normal"|"low" [, name]]), hyp.cancel(id),
+	* hyp.wait(seconds) and hyp.nextFrame() (or coroutine.yield()).
+	*/
+	class ScriptScheduler {
+	public:
+		using TaskId = uint32_t;
+
+		ScriptScheduler(lua_State* L, ScriptAllocator* allocator = nullptr);
+		~ScriptScheduler();
+
+		ScriptScheduler(const ScriptScheduler&) = delete;
+		ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+		/**
+		* \brief spawns a task running the function on top of the stack of `L` (popped)
+		*/
+		TaskId spawn(lua_State* L, const std::string& name, ScriptPriority priority = ScriptPriority::Normal);
+		bool cancel(TaskId id);
+
+		/**
+		* \brief resumes tasks until `budgetMs` is spent; returns the time used in milliseconds
+		*/
+		double run(double budgetMs);
+
+		// a single resume never runs longer than this, whatever the frame budget
+		void setSliceBudgetMs(double ms) { m_sliceBudgetMs = ms; }
+		// instructions between two clock checks
+		void setHookInterval(int instructions) { m_hookInterval = instructions; }
+		// preempted resumes in a row before a task is demoted one priority level
+		void setDemoteAfter(uint32_t preemptions) { m_demoteAfter = preemptions; }
+
+		size_t getTaskCount() const;
+		double getLastUsedMs() const { return m_lastUsedMs; }
+
+		const std::unordered_map<std::string, ScriptTaskStats>& getStats() const { return m_stats; }
+
+	private:
+		struct Task
+		{
+			TaskId id;
+			std::string name;
+			lua_State* thread;
+			int threadRef;
+			ScriptPriority priority;
+			uint32_t memoryOwner; // the script that spawned the task
+			double wakeTime = 0.0;
+			uint32_t preemptedInARow = 0;
+			bool reported = false;
+			bool cancelled = false; // by a task of the same run, dropped when popped
+		};
+
+		enum class SliceResult
+		{
+			Yielded,
+			Preempted,
+			Finished,
+		};
+
+		SliceResult resume(Task& task, double sliceMs);
+		void release(Task& task);
+
+	private:
+		lua_State* m_state;
+		ScriptAllocator* m_allocator;
+		std::array<std::deque<Task>, static_cast<size_t>(ScriptPriority::Count)> m_queues;
+		bool m_running = false; // the queues must not shrink under `run`
+		std::unordered_map<std::string, ScriptTaskStats> m_stats;
+
+		TaskId m_nextId = 1;
+		double m_sliceBudgetMs = 1.0;
+		int m_hookInterval = 500;
+		uint32_t m_demoteAfter = 10;
+		double m_lastUsedMs = 0.0;
+	};
+}
+
+#endif // !HYPER_SCRIPT_SCHEDULER_HPP
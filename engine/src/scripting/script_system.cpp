@@ -0,0 +1,115 @@
+#include "script_system.hpp"
+#include <scripting/script_allocator.hpp>
+#include <scripting/script_arrays.hpp>
+#include <scripting/script_bindings.hpp>
+#include <scene/components.hpp>
+#include <debug/flight_recorder.hpp>
+#include <debug/memory_tracker.hpp>
+#include <sol/sol.hpp>
+
+hyp::ScriptSystem::~ScriptSystem() {
+	lua_State* L = ScriptEngine::getState();
+	if (!L) return;
+
+	for (auto& batch : m_batches)
+	{
+		luaL_unref(L, LUA_REGISTRYINDEX, batch.entityTable);
+		luaL_unref(L, LUA_REGISTRYINDEX, batch.createdTable);
+	}
+}
+
+hyp::ScriptSystem::Batch& hyp::ScriptSystem::getBatch(ScriptHandle script) {
+	uint32_t index = script.getIndex();
+	if (index >= m_batchIndices.size())
+	{
+		m_batchIndices.resize(index + 1, 0);
+	}
+
+	uint32_t& batchIndex = m_batchIndices[index];
+	if (batchIndex == 0 || m_batches[batchIndex - 1].script != script)
+	{
+		lua_State* L = ScriptEngine::getState();
+
+		Batch batch;
+		batch.script = script;
+		lua_newtable(L);
+		batch.entityTable = luaL_ref(L, LUA_REGISTRYINDEX);
+		lua_newtable(L);
+		batch.createdTable = luaL_ref(L, LUA_REGISTRYINDEX);
+
+		m_batches.push_back(std::move(batch));
+		batchIndex = (uint32_t)m_batches.size();
+	}
+
+	return m_batches[batchIndex - 1];
+}
+
+void hyp::ScriptSystem::onUpdate(entt::registry& registry, float dt) {
+	if (!ScriptEngine::isInitialized()) return;
+
+	HYP_PROFILE_SCOPE("ScriptSystem::onUpdate");
+	HYP_MEMORY_SCOPE(hyp::MemoryTag::Scripting);
+
+	for (auto& batch : m_batches)
+	{
+		batch.entities.clear();
+		batch.created.clear();
+	}
+
+	auto view = registry.view<ScriptComponent>();
+	for (auto entity : view)
+	{
+		auto& component = view.get<ScriptComponent>(entity);
+		if (!ScriptEngine::getScript(component.script)) continue;
+
+		Batch& batch = getBatch(component.script);
+		if (!component.created)
+		{
+			component.created = true;
+			batch.created.push_back((uint32_t)entity);
+		}
+		batch.entities.push_back((uint32_t)entity);
+	}
+
+	ScriptBindings::setRegistry(&registry);
+
+	for (auto& batch : m_batches)
+	{
+		Script* script = ScriptEngine::getScript(batch.script);
+		if (!script || batch.entities.empty()) continue;
+
+		if (!batch.created.empty() && script->onCreate != LUA_NOREF)
+		{
+			callScript(batch.script, *script, script->onCreate, batch.createdTable, batch.created, dt, false);
+		}
+
+		if (script->onUpdate != LUA_NOREF)
+		{
+			callScript(batch.script, *script, script->onUpdate, batch.entityTable, batch.entities, dt, true);
+		}
+	}
+
+	ScriptBindings::setRegistry(nullptr);
+}
+
+void hyp::ScriptSystem::callScript(ScriptHandle handle, const Script& script, int function, int table, const std::vector<uint32_t>& entities, float dt, bool passDt) {
+	lua_State* L = ScriptEngine::getState();
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, function);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, table);
+
+	// entries past `count` are stale ids from bigger frames, scripts iterate 1..count
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		lua_pushinteger(L, entities[i]);
+		lua_rawseti(L, -2, (lua_Integer)i + 1);
+	}
+
+	lua_pushinteger(L, (lua_Integer)entities.size());
+	if (passDt) lua_pushnumber(L, dt);
+
+	ScriptAllocator::Scope owner(ScriptEngine::getAllocator(), ScriptEngine::getMemoryOwner(handle));
+	ScriptArrays::setEntities(entities.data(), (uint32_t)entities.size());
+	ScriptEngine::call(script.path.c_str(), passDt ? 3 : 2);
+	ScriptArrays::setEntities(nullptr, 0);
+}
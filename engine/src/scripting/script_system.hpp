@@ -0,0 +1,49 @@
+#pragma once
+#ifndef HYPER_SCRIPT_SYSTEM_HPP
+	#define HYPER_SCRIPT_SYSTEM_HPP
+
+	#include <scripting/script_engine.hpp>
+	#include <entt.hpp>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief runs the scripts of a scene.
+	*
+	* Entities are grouped by script and each script is called once per frame with the whole
+	* batch, so the Lua call overhead scales with the number of scripts, not of entities.
+	*/
+	class ScriptSystem {
+	public:
+		ScriptSystem() = default;
+		~ScriptSystem();
+
+		ScriptSystem(const ScriptSystem&) = delete;
+		ScriptSystem& operator=(const ScriptSystem&) = delete;
+
+		void onUpdate(entt::registry& registry, float dt);
+
+	private:
+		struct Batch
+		{
+			ScriptHandle script;
+			std::vector<uint32_t> entities;
+			std::vector<uint32_t> created;
+
+			// Lua tables reused every frame to pass the entity ids
+			int entityTable = -2;
+			int createdTable = -2;
+		};
+
+		Batch& getBatch(ScriptHandle script);
+		void callScript(ScriptHandle handle, const Script& script, int function, int table, const std::vector<uint32_t>& entities, float dt, bool passDt);
+
+	private:
+		std::vector<Batch> m_batches;
+		// script slot index -> batch index + 1
+		std::vector<uint32_t> m_batchIndices;
+	};
+}
+
+#endif // !HYPER_SCRIPT_SYSTEM_HPP
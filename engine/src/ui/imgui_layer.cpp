@@ -6,9 +6,39 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <core/application.hpp>
+#include <debug/memory_tracker.hpp>
+#include <cstdlib>
+
+namespace {
+	// ImGui frees without a size, so every block carries its own and whether it was counted
+	struct alignas(alignof(std::max_align_t)) UIAllocationHeader
+	{
+		size_t size;
+		bool tracked;
+	};
+
+	void* uiAlloc(size_t size, void*) {
+		auto* header = static_cast<UIAllocationHeader*>(std::malloc(size + sizeof(UIAllocationHeader)));
+		if (!header) return nullptr;
+
+		header->size = size;
+		header->tracked = hyp::MemoryTracker::isEnabled();
+		if (header->tracked) hyp::MemoryTracker::onAllocate(hyp::MemoryTag::UI, size);
+		return header + 1;
+	}
+
+	void uiFree(void* ptr, void*) {
+		if (!ptr) return;
+
+		auto* header = static_cast<UIAllocationHeader*>(ptr) - 1;
+		if (header->tracked) hyp::MemoryTracker::onFree(hyp::MemoryTag::UI, header->size);
+		std::free(header);
+	}
+}
 
 void hyp::ImGuiLayer::onAttach() {
 	// Setup Dear ImGui context
+	ImGui::SetAllocatorFunctions(uiAlloc, uiFree);
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
 	ImGuiIO& io = ImGui::GetIO();
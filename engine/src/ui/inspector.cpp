@@ -0,0 +1,83 @@
+#include "inspector.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cctype>
+
+namespace {
+	// lets InputText edit a std::string in place, growing it as needed
+	int resizeString(ImGuiInputTextCallbackData* data) {
+		if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+		{
+			std::string* text = (std::string*)data->UserData;
+			text->resize((size_t)data->BufTextLen);
+			data->Buf = text->data();
+		}
+
+		return 0;
+	}
+}
+
+void hyp::getFieldLabel(const char* name, char* label, size_t size) {
+	if (size == 0) return;
+
+	size_t length = 0;
+	for (size_t i = 0; name[i] && length + 2 < size; i++)
+	{
+		char ch = name[i];
+		if (i == 0)
+		{
+			label[length++] = (char)std::toupper((unsigned char)ch);
+			continue;
+		}
+
+		if (std::isupper((unsigned char)ch))
+		{
+			label[length++] = ' ';
+			ch = (char)std::tolower((unsigned char)ch);
+		}
+
+		label[length++] = ch;
+	}
+
+	label[length] = '\0';
+}
+
+bool hyp::inspectField(const char* label, float& value, uint32_t flags, float speed, float min, float max) {
+	// ImGui leaves the value unbounded when min == max
+	return ImGui::DragFloat(label, &value, speed, min, max);
+}
+
+bool hyp::inspectField(const char* label, int32_t& value, uint32_t flags, float speed, float min, float max) {
+	return ImGui::DragInt(label, &value, speed, (int)min, (int)max);
+}
+
+bool hyp::inspectField(const char* label, uint32_t& value, uint32_t flags, float speed, float min, float max) {
+	int32_t edited = (int32_t)value;
+	if (!ImGui::DragInt(label, &edited, speed, std::max(0, (int)min), (int)max)) return false;
+
+	value = (uint32_t)std::max(edited, 0);
+	return true;
+}
+
+bool hyp::inspectField(const char* label, bool& value, uint32_t flags, float speed, float min, float max) {
+	return ImGui::Checkbox(label, &value);
+}
+
+bool hyp::inspectField(const char* label, glm::vec2& value, uint32_t flags, float speed, float min, float max) {
+	return ImGui::DragFloat2(label, glm::value_ptr(value), speed, min, max);
+}
+
+bool hyp::inspectField(const char* label, glm::vec3& value, uint32_t flags, float speed, float min, float max) {
+	if (flags & hyp::FieldColor) return ImGui::ColorEdit3(label, glm::value_ptr(value));
+	return ImGui::DragFloat3(label, glm::value_ptr(value), speed, min, max);
+}
+
+bool hyp::inspectField(const char* label, glm::vec4& value, uint32_t flags, float speed, float min, float max) {
+	if (flags & hyp::FieldColor) return ImGui::ColorEdit4(label, glm::value_ptr(value));
+	return ImGui::DragFloat4(label, glm::value_ptr(value), speed, min, max);
+}
+
+bool hyp::inspectField(const char* label, std::string& value, uint32_t flags, float speed, float min, float max) {
+	// capacity + 1 includes the terminator std::string always keeps
+	return ImGui::InputText(label, value.data(), value.capacity() + 1, ImGuiInputTextFlags_CallbackResize, resizeString, &value);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#ifndef HYP_INSPECTOR_HPP
+	#define HYP_INSPECTOR_HPP
+
+	#include <glm/glm.hpp>
+	#include <scene/reflection.hpp>
+	#include <imgui.h>
+	#include <cstdint>
+	#include <string>
+
+namespace hyp {
+
+	// "tilingFactor" -> "Tiling factor"
+	void getFieldLabel(const char* name, char* label, size_t size);
+
+	bool inspectField(const char* label, float& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, int32_t& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, uint32_t& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, bool& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, glm::vec2& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, glm::vec3& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, glm::vec4& value, uint32_t flags, float speed, float min, float max);
+	bool inspectField(const char* label, std::string& value, uint32_t flags, float speed, float min, float max);
+
+	// types without a widget are listed, not editable
+	template <typename M>
+	bool inspectField(const char* label, M&, uint32_t, float, float, float) {
+		ImGui::TextDisabled("%s", label);
+		return false;
+	}
+
+	template <Reflected T>
+	bool inspect(T& value, const char* id = Reflect<T>::name);
+
+	template <Reflected M>
+	bool inspectField(const char* label, M& value, uint32_t, float, float, float) {
+		if (!ImGui::TreeNode(label)) return false;
+		bool changed = hyp::inspect(value, label);
+		ImGui::TreePop();
+		return changed;
+	}
+
+	/**
+	* \brief one widget per reflected field of `value`, returns true when any was edited
+	*/
+	template <Reflected T>
+	bool inspect(T& value, const char* id) {
+		bool changed = false;
+		ImGui::PushID(id);
+		forEachField<T>([&](const auto& field) {
+			char label[64];
+			getFieldLabel(field.name, label, sizeof(label));
+			changed |= inspectField(label, field.get(value), field.flags, field.speed, field.min, field.max);
+		});
+		ImGui::PopID();
+		return changed;
+	}
+}
+
+#endif // !HYP_INSPECTOR_HPP
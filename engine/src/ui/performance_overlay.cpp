@@ -0,0 +1,181 @@
+#include "performance_overlay.hpp"
+#include <debug/memory_tracker.hpp>
+#include <event/key_event.hpp>
+#include <opengl/debug_output.hpp>
+#include <renderer/renderer2d.hpp>
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	const char* s_phaseNames[] = { "Fixed update", "Coroutines", "Scripts", "Update", "UI", "Idle", "Swap" };
+	static_assert(std::size(s_phaseNames) == (size_t)hyp::FramePhase::Count, "a frame phase has no name");
+
+	const char* s_counterNames[] = { "renderer.draw_calls", "renderer.quads", "renderer.lines", "gpu.uploads", "gpu.upload_bytes" };
+
+	// about half a second to settle at 60Hz
+	constexpr float PhaseSmoothing = 0.1f;
+	constexpr uint32_t PercentileInterval = 15;
+
+	float toMegabytes(int64_t bytes) {
+		return (float)bytes / (1024.f * 1024.f);
+	}
+}
+
+hyp::PerformanceOverlay::PerformanceOverlay()
+    : hyp::Layer("performance_overlay") {
+	static_assert(std::size(s_counterNames) == FrameCounterCount, "a frame counter has no metric");
+
+	for (uint32_t i = 0; i < FrameCounterCount; i++)
+	{
+		m_counters[i] = &hyp::Metrics::counter(s_counterNames[i]);
+		m_lastCounts[i] = m_counters[i]->get();
+	}
+}
+
+void hyp::PerformanceOverlay::onEvent(hyp::Event& event) {
+	hyp::EventDispatcher dispatcher(event);
+	dispatcher.dispatch<hyp::KeyPressedEvent>([this](const hyp::KeyPressedEvent& e) {
+		if (e.getkey() != m_toggleKey || e.isRepeat()) return false;
+
+		toggle();
+		return true;
+	});
+}
+
+void hyp::PerformanceOverlay::onUpdate(float dt) {
+	// keeps sampling while hidden, so the graphs have history when opened
+	sample();
+}
+
+void hyp::PerformanceOverlay::sample() {
+	const hyp::FrameTimings& timings = hyp::Application::get().getFrameTimings();
+
+	m_cpuMs[m_sampleIndex] = timings.cpuMs;
+	m_gpuMs[m_sampleIndex] = timings.gpuMs;
+	m_sampleIndex = (m_sampleIndex + 1) % SampleCount;
+	m_sampleCount = std::min(m_sampleCount + 1, SampleCount);
+
+	for (size_t i = 0; i < m_phaseMs.size(); i++)
+	{
+		m_phaseMs[i] += (timings.phaseMs[i] - m_phaseMs[i]) * PhaseSmoothing;
+	}
+
+	for (uint32_t i = 0; i < FrameCounterCount; i++)
+	{
+		uint64_t count = m_counters[i]->get();
+		m_frameCounts[i] = count - m_lastCounts[i];
+		m_lastCounts[i] = count;
+	}
+
+	if (++m_framesSincePercentiles >= PercentileInterval)
+	{
+		m_cpuPercentiles = computePercentiles(m_cpuMs, m_sampleCount);
+		m_gpuPercentiles = computePercentiles(m_gpuMs, m_sampleCount);
+		m_framesSincePercentiles = 0;
+	}
+}
+
+hyp::PerformanceOverlay::Percentiles hyp::PerformanceOverlay::computePercentiles(const std::array<float, SampleCount>& samples, uint32_t count) {
+	std::array<float, SampleCount> sorted;
+	uint32_t valid = 0;
+	// negative samples are frames without a GPU result yet
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (samples[i] >= 0.f) sorted[valid++] = samples[i];
+	}
+
+	Percentiles percentiles;
+	if (valid == 0) return percentiles;
+
+	std::sort(sorted.begin(), sorted.begin() + valid);
+	auto at = [&](float p) { return sorted[std::min(valid - 1, (uint32_t)(p * valid))]; };
+
+	percentiles.p50 = at(0.50f);
+	percentiles.p95 = at(0.95f);
+	percentiles.p99 = at(0.99f);
+	percentiles.max = sorted[valid - 1];
+	return percentiles;
+}
+
+void hyp::PerformanceOverlay::onUIRender() {
+	if (!m_visible) return;
+
+	auto start = std::chrono::steady_clock::now();
+
+	ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+	    | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+
+	const ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 10.f, viewport->WorkPos.y + 10.f), ImGuiCond_Always);
+	ImGui::SetNextWindowViewport(viewport->ID);
+	ImGui::SetNextWindowBgAlpha(0.65f);
+
+	if (ImGui::Begin("##performance_overlay", nullptr, flags))
+	{
+		const hyp::FrameTimings& timings = hyp::Application::get().getFrameTimings();
+		float scale = std::max(m_cpuPercentiles.max, m_gpuPercentiles.max) * 1.1f;
+		scale = std::max(scale, 1000.f / 60.f);
+
+		char label[64];
+		snprintf(label, sizeof(label), "CPU %.2f ms", timings.cpuMs);
+		ImGui::PlotLines("##cpu", m_cpuMs.data(), (int)SampleCount, (int)m_sampleIndex, label, 0.f, scale, ImVec2(260.f, 40.f));
+		ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f", m_cpuPercentiles.p50, m_cpuPercentiles.p95, m_cpuPercentiles.p99, m_cpuPercentiles.max);
+
+		if (timings.gpuMs >= 0.f)
+		{
+			snprintf(label, sizeof(label), "GPU %.2f ms", timings.gpuMs);
+		}
+		else
+		{
+			snprintf(label, sizeof(label), "GPU n/a");
+		}
+		ImGui::PlotLines("##gpu", m_gpuMs.data(), (int)SampleCount, (int)m_sampleIndex, label, 0.f, scale, ImVec2(260.f, 40.f));
+		ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f", m_gpuPercentiles.p50, m_gpuPercentiles.p95, m_gpuPercentiles.p99, m_gpuPercentiles.max);
+
+		ImGui::Separator();
+		for (size_t i = 0; i < m_phaseMs.size(); i++)
+		{
+			ImGui::Text("%-13s %6.3f ms", s_phaseNames[i], m_phaseMs[i]);
+		}
+
+		ImGui::Separator();
+		ImGui::Text("Draw calls %llu  quads %llu  lines %llu", (unsigned long long)m_frameCounts[DrawCalls],
+		    (unsigned long long)m_frameCounts[Quads], (unsigned long long)m_frameCounts[Lines]);
+		ImGui::Text("Uploads %llu  (%.1f KB)", (unsigned long long)m_frameCounts[Uploads], m_frameCounts[UploadBytes] / 1024.f);
+		if (hyp::OpenglDebugOutput::isInstalled())
+		{
+			ImGui::Text("GL perf warnings %u  (total %llu)", hyp::OpenglDebugOutput::getFramePerformanceWarnings(),
+			    (unsigned long long)hyp::OpenglDebugOutput::getTotalPerformanceWarnings());
+		}
+
+		using DebugView = hyp::Renderer2D::DebugView;
+		DebugView debugView = hyp::Renderer2D::getDebugView();
+		ImGui::SetNextItemWidth(160.f);
+		if (ImGui::BeginCombo("Debug view", hyp::Renderer2D::getDebugViewName(debugView)))
+		{
+			for (int i = 0; i < (int)DebugView::Count; i++)
+			{
+				if (ImGui::Selectable(hyp::Renderer2D::getDebugViewName((DebugView)i), (DebugView)i == debugView))
+				{
+					hyp::Renderer2D::setDebugView((DebugView)i);
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		ImGui::Separator();
+		hyp::MemoryStats memory = hyp::MemoryTracker::getStats();
+		ImGui::Text("CPU %.2f MB  GPU %.2f MB", toMegabytes(memory.getCpuBytes()), toMegabytes(memory.getGpuBytes()));
+		for (size_t i = 0; i < hyp::MemoryTagCount; i++)
+		{
+			if (memory.tags[i].currentBytes == 0) continue;
+			ImGui::Text("  %-10s %.2f MB", hyp::MemoryTracker::getTagName((hyp::MemoryTag)i), toMegabytes(memory.tags[i].currentBytes));
+		}
+
+		ImGui::TextDisabled("overlay %.3f ms", m_renderMs);
+	}
+	ImGui::End();
+
+	m_renderMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
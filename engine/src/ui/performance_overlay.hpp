@@ -0,0 +1,86 @@
+#pragma once
+#ifndef HYP_PERFORMANCE_OVERLAY_HPP
+	#define HYP_PERFORMANCE_OVERLAY_HPP
+
+	#include <core/application.hpp>
+	#include <core/layer.hpp>
+	#include <debug/metrics.hpp>
+	#include <io/key_code.hpp>
+	#include <array>
+	#include <cstdint>
+
+namespace hyp {
+
+	/**
+	* \brief frame-time graphs, percentiles, per-phase timings, batch/upload stats and memory usage,
+	* toggled with F3 in every build.
+	*
+	* Samples the Application's FrameTimings each frame into fixed rings; nothing is
+	* allocated, and percentiles are only recomputed a few times per second.
+	*/
+	class PerformanceOverlay : public hyp::Layer {
+	public:
+		// ~5s at 60Hz
+		static constexpr uint32_t SampleCount = 300;
+
+		PerformanceOverlay();
+
+		virtual void onEvent(hyp::Event& event) override;
+		virtual void onUpdate(float dt) override;
+		virtual void onUIRender() override;
+
+		void setVisible(bool visible) { m_visible = visible; }
+		bool isVisible() const { return m_visible; }
+		void toggle() { m_visible = !m_visible; }
+
+		void setToggleKey(hyp::Key key) { m_toggleKey = key; }
+
+	private:
+		struct Percentiles
+		{
+			float p50 = 0.f;
+			float p95 = 0.f;
+			float p99 = 0.f;
+			float max = 0.f;
+		};
+
+		void sample();
+		static Percentiles computePercentiles(const std::array<float, SampleCount>& samples, uint32_t count);
+
+	private:
+		bool m_visible = false;
+		hyp::Key m_toggleKey = hyp::Key::F3;
+
+		std::array<float, SampleCount> m_cpuMs {};
+		std::array<float, SampleCount> m_gpuMs {};
+		uint32_t m_sampleIndex = 0;
+		uint32_t m_sampleCount = 0;
+		uint32_t m_gpuSampleCount = 0;
+
+		Percentiles m_cpuPercentiles;
+		Percentiles m_gpuPercentiles;
+		uint32_t m_framesSincePercentiles = 0;
+
+		// exponentially smoothed, raw per-phase values flicker too much to read
+		std::array<float, (size_t)hyp::FramePhase::Count> m_phaseMs {};
+
+		// per-frame deltas of the renderer and upload metrics
+		enum FrameCounter
+		{
+			DrawCalls = 0,
+			Quads,
+			Lines,
+			Uploads,
+			UploadBytes,
+			FrameCounterCount
+		};
+
+		std::array<hyp::Counter*, FrameCounterCount> m_counters {};
+		std::array<uint64_t, FrameCounterCount> m_lastCounts {};
+		std::array<uint64_t, FrameCounterCount> m_frameCounts {};
+
+		float m_renderMs = 0.f;
+	};
+}
+
+#endif // !HYP_PERFORMANCE_OVERLAY_HPP
@@ -23,8 +23,11 @@ namespace hyp {
 		TRACE
 	};
 
-	template <typename... Types>
-	void log_output(hyp::LOG_TYPE type, const std::string& message, Types... args) {
+	// keeps the line in the flight recorder (debug/flight_recorder.cpp)
+	void recordLogLine(hyp::LOG_TYPE type, const char* line);
+
+	// colours and prints a formatted line, console output only exists in debug builds
+	inline void print_line(hyp::LOG_TYPE type, const char* line) {
 		std::stringstream ss;
 		int attribute;
 		switch (type)
@@ -70,17 +73,33 @@ namespace hyp {
 			break;
 		}
 
-		ss << message << "\n";
+		ss << line << "\n";
 	#ifdef _WIN32
 		HANDLE stdOutHandle = GetStdHandle(STD_OUTPUT_HANDLE);
 		SetConsoleTextAttribute(stdOutHandle, attribute);
-		printf(ss.str().c_str(), args...);
+		fputs(ss.str().c_str(), stdout);
 		SetConsoleTextAttribute(stdOutHandle, 7);
 	#else
-		printf(ss.str().c_str(), args...);
+		fputs(ss.str().c_str(), stdout);
 	#endif
 	}
 
+	// the flight recorder only, what release builds keep of warnings and errors
+	template <typename... Types>
+	void record_output(hyp::LOG_TYPE type, const std::string& message, Types... args) {
+		char line[1024];
+		snprintf(line, sizeof(line), message.c_str(), args...);
+		hyp::recordLogLine(type, line);
+	}
+
+	template <typename... Types>
+	void log_output(hyp::LOG_TYPE type, const std::string& message, Types... args) {
+		char line[1024];
+		snprintf(line, sizeof(line), message.c_str(), args...);
+		hyp::recordLogLine(type, line);
+		hyp::print_line(type, line);
+	}
+
 	#if defined(HYPER_DEBUG)
 		#define HYP_WARN(message, ...) log_output(hyp::LOG_TYPE::WARN, message, ##__VA_ARGS__);
 		#define HYP_INFO(message, ...) log_output(hyp::LOG_TYPE::INFO, message, ##__VA_ARGS__);
@@ -90,11 +109,12 @@ namespace hyp {
 		#define HYP_TRACE(message, ...) log_output(hyp::LOG_TYPE::TRACE, message, ##__VA_ARGS__);
 	#else
 
-		#define HYP_WARN(message, ...)
+		// no console, but the flight recorder is always on: its dumps keep the warnings and errors
+		#define HYP_WARN(message, ...) hyp::record_output(hyp::LOG_TYPE::WARN, message, ##__VA_ARGS__);
 		#define HYP_INFO(message, ...)
 		#define HYP_DEBUG(message, ...)
-		#define HYP_FATAL(message, ...)
-		#define HYP_ERROR(message, ...)
+		#define HYP_FATAL(message, ...) hyp::record_output(hyp::LOG_TYPE::FATAL, message, ##__VA_ARGS__);
+		#define HYP_ERROR(message, ...) hyp::record_output(hyp::LOG_TYPE::H_ERROR, message, ##__VA_ARGS__);
 		#define HYP_TRACE(message, ...)
 
 	#endif
@@ -0,0 +1,121 @@
+#include "pool_allocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace {
+	constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+	size_t alignUp(size_t size) {
+		return (size + BlockAlignment - 1) & ~(BlockAlignment - 1);
+	}
+}
+
+hyp::PoolAllocator::PoolAllocator(std::initializer_list<size_t> sizeClasses, size_t chunkSize, MemoryTag tag)
+    : m_chunkSize(chunkSize), m_tag(tag) {
+	std::vector<size_t> sizes(sizeClasses);
+	std::sort(sizes.begin(), sizes.end());
+
+	for (size_t size : sizes)
+	{
+		size_t blockSize = alignUp(std::max(size, sizeof(FreeBlock)));
+		if (m_classes.empty() || m_classes.back().blockSize != blockSize)
+		{
+			m_classes.push_back({ blockSize });
+		}
+	}
+
+	// a chunk has to hold at least one block of the biggest class
+	if (!m_classes.empty())
+	{
+		m_chunkSize = std::max(m_chunkSize, m_classes.back().blockSize);
+	}
+}
+
+hyp::PoolAllocator::~PoolAllocator() {
+	for (void* chunk : m_chunks)
+	{
+		MemoryTracker::deallocate(m_tag, chunk, m_chunkSize);
+	}
+}
+
+void* hyp::PoolAllocator::allocate(size_t size) {
+	m_stats.allocations++;
+
+	int index = findClass(size);
+	if (index < 0)
+	{
+		m_stats.oversizedBytes += size;
+		return MemoryTracker::allocate(m_tag, size);
+	}
+
+	SizeClass& sizeClass = m_classes[index];
+	if (!sizeClass.freeList)
+	{
+		refill(sizeClass);
+	}
+
+	FreeBlock* block = sizeClass.freeList;
+	sizeClass.freeList = block->next;
+	m_stats.usedBytes += sizeClass.blockSize;
+
+	return block;
+}
+
+void hyp::PoolAllocator::deallocate(void* ptr, size_t size) {
+	if (!ptr) return;
+	m_stats.frees++;
+
+	int index = findClass(size);
+	if (index < 0)
+	{
+		m_stats.oversizedBytes -= size;
+		MemoryTracker::deallocate(m_tag, ptr, size);
+		return;
+	}
+
+	SizeClass& sizeClass = m_classes[index];
+	FreeBlock* block = static_cast<FreeBlock*>(ptr);
+	block->next = sizeClass.freeList;
+	sizeClass.freeList = block;
+	m_stats.usedBytes -= sizeClass.blockSize;
+}
+
+void* hyp::PoolAllocator::reallocate(void* ptr, size_t oldSize, size_t newSize) {
+	if (!ptr) return allocate(newSize);
+
+	int oldClass = findClass(oldSize);
+	if (oldClass >= 0 && oldClass == findClass(newSize))
+	{
+		return ptr;
+	}
+
+	void* block = allocate(newSize);
+	std::memcpy(block, ptr, std::min(oldSize, newSize));
+	deallocate(ptr, oldSize);
+	return block;
+}
+
+int hyp::PoolAllocator::findClass(size_t size) const {
+	// there are only a handful of classes, a linear scan beats a binary search here
+	for (size_t i = 0; i < m_classes.size(); i++)
+	{
+		if (size <= m_classes[i].blockSize) return (int)i;
+	}
+
+	return -1;
+}
+
+void hyp::PoolAllocator::refill(SizeClass& sizeClass) {
+	char* chunk = static_cast<char*>(MemoryTracker::allocate(m_tag, m_chunkSize));
+	m_chunks.push_back(chunk);
+	m_stats.reservedBytes += m_chunkSize;
+
+	size_t count = m_chunkSize / sizeClass.blockSize;
+	for (size_t i = 0; i < count; i++)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * sizeClass.blockSize);
+		block->next = sizeClass.freeList;
+		sizeClass.freeList = block;
+	}
+}
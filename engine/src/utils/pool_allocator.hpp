@@ -0,0 +1,74 @@
+#pragma once
+#ifndef HYPER_POOL_ALLOCATOR_HPP
+	#define HYPER_POOL_ALLOCATOR_HPP
+
+	#include <debug/memory_tracker.hpp>
+	#include <cstddef>
+	#include <cstdint>
+	#include <initializer_list>
+	#include <vector>
+
+namespace hyp {
+
+	/**
+	* \brief size-class pool allocator.
+	*
+	* Requests are rounded up to the smallest size class that fits them and served from
+	* that class's free list; chunks are only ever added, so once a workload reached its
+	* steady state it performs no heap allocation. Requests larger than the biggest class
+	* go to the global heap. Chunks and oversized blocks are accounted to `tag`. Not thread-safe.
+	*/
+	class PoolAllocator {
+	public:
+		struct Stats
+		{
+			size_t reservedBytes = 0;  // bytes held in chunks
+			size_t usedBytes = 0;      // bytes handed out from the pools (rounded to their class)
+			size_t oversizedBytes = 0; // bytes handed out by the global heap
+			uint64_t allocations = 0;
+			uint64_t frees = 0;
+		};
+
+	public:
+		PoolAllocator(std::initializer_list<size_t> sizeClasses, size_t chunkSize = 64 * 1024, MemoryTag tag = MemoryTag::Unknown);
+		~PoolAllocator();
+
+		PoolAllocator(const PoolAllocator&) = delete;
+		PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+		void* allocate(size_t size);
+		void deallocate(void* ptr, size_t size);
+
+		/**
+		* \brief resizes a block, keeping it in place when the size class doesn't change
+		*/
+		void* reallocate(void* ptr, size_t oldSize, size_t newSize);
+
+		const Stats& getStats() const { return m_stats; }
+		size_t getMaxPooledSize() const { return m_classes.empty() ? 0 : m_classes.back().blockSize; }
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct SizeClass
+		{
+			size_t blockSize;
+			FreeBlock* freeList = nullptr;
+		};
+
+		int findClass(size_t size) const;
+		void refill(SizeClass& sizeClass);
+
+	private:
+		std::vector<SizeClass> m_classes;
+		std::vector<void*> m_chunks;
+		size_t m_chunkSize;
+		MemoryTag m_tag;
+		Stats m_stats;
+	};
+}
+
+#endif // !HYPER_POOL_ALLOCATOR_HPP
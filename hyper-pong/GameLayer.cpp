@@ -49,11 +49,8 @@ void GameLayer::onUIRender() {
 	// don't render the UI in release mode!
 	return;
 #endif
+	// renderer stats live in the engine's performance overlay (F3)
 	ImGui::Begin("Application");
-	ImGui::Text("Draw Calls: %d", hyp::Renderer2D::getStats().drawCalls);
-	ImGui::Text("No. Quads: %d", hyp::Renderer2D::getStats().getQuadCount());
-	ImGui::Text("No. Lines: %d", hyp::Renderer2D::getStats().getLineCount());
-	// unfortunately the current hyper API is does not have stats for circle's created..
 
 	//game stats
 	// (hurray! deprecated because Hyper support text rendering)
@@ -125,7 +122,7 @@ void GameLayer::onRender() {
 	std::stringstream ss;
 	ss << stat.score1 << ":" << stat.score2 << std::endl;
 
-	hyp::Renderer2D::drawString(ss.str(), hyp::Font::getDefault(), model, textParam);
+	hyp::Renderer2D::drawString(ss.str(), hyp::Resources::getDefaultFont(), model, textParam);
 
 	if (isPaused)
 	{
@@ -133,7 +130,7 @@ void GameLayer::onRender() {
 		model = glm::scale(model, glm::vec3(size, 0.f));
 
 		textParam.color = glm::vec4(1.f, 0.5f, 0.f, 1.f);
-		hyp::Renderer2D::drawString("Press Space to Resume!", hyp::Font::getDefault(), model, textParam);
+		hyp::Renderer2D::drawString("Press Space to Resume!", hyp::Resources::getDefaultFont(), model, textParam);
 	}
 
 	// draw the paddles
@@ -2,8 +2,29 @@
 
 out vec4 fragColor;
 
+// Renderer2D::DebugView, set per batch
+uniform int debugView;
+uniform int batchIndex;
+
+vec3 debugColor(int index) {
+  // golden-ratio hue steps keep neighbouring indices apart
+  float hue = fract(float(index) * 0.618034);
+  return clamp(abs(mod(hue * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+}
+
 in vec4 oColor;
 
 void main() {
+  // blended additively: ~10 layers saturate red, ~25 reach yellow
+  if (debugView == 1) {
+    fragColor = vec4(0.1, 0.04, 0.0, 1.0);
+    return;
+  }
+
+  if (debugView > 1) {
+    fragColor = vec4(debugView == 3 ? vec3(0.2) : debugColor(batchIndex), 1.0);
+    return;
+  }
+
   fragColor = oColor;
 }
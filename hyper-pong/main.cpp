@@ -3,6 +3,7 @@
 #include <utils/logger.hpp>
 #include <core/device.hpp>
 #include <core/application.hpp>
+#include <debug/metrics.hpp>
 
 int main(int argc, char** argv) {
 	hyp::Device::init({});
@@ -12,6 +13,7 @@ int main(int argc, char** argv) {
 	auto app = hyp::Application(props);
 	hyp::RenderCommand::init();
 	hyp::Renderer2D::init();
+	hyp::Metrics::startExporter(argc, argv); // --metrics[=path], see debug/metrics.hpp
 
 	app.pushLayer(new GameLayer({ 300.f, 300.f }));
 	app.run();
@@ -1,4 +1,16 @@
 include "dependencies.lua"
+
+newoption
+{
+	trigger = "track-allocations",
+	description = "Route every heap allocation through the engine's memory tracker"
+}
+
+newoption
+{
+	trigger = "with-lz4",
+	description = "Build LZ4 so asset archives can hold compressed entries"
+}
 workspace "Hyper"
 	architecture "x64"
 	startproject "sandbox"
@@ -20,9 +32,17 @@ group "Dependencies"
 	include "dependencies/glfw"
 	include "dependencies/imgui"
 	include "dependencies/freetype"
+	include "dependencies/lua"
+
+	if _OPTIONS["with-lz4"] then
+		include "dependencies/lz4"
+	end
 
 group "Hyper"
 	include "engine"
 	include "sandbox"
 	include "sandbox-editor"
 	include "hyper-pong"
+
+group "Tools"
+	include "tools/asset-packer"
@@ -2,6 +2,16 @@
 
 out vec4 fragColor;
 
+// Renderer2D::DebugView, set per batch
+uniform int debugView;
+uniform int batchIndex;
+
+vec3 debugColor(int index) {
+  // golden-ratio hue steps keep neighbouring indices apart
+  float hue = fract(float(index) * 0.618034);
+  return clamp(abs(mod(hue * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+}
+
 in vec4 inColor;
 in vec3 inFragPos;
 in vec2 inTexCoord;
@@ -42,6 +52,11 @@ vec3 CalcPointLight(Light light, vec3 normal, vec3 fragPos) {
 }
 
 void main() {
+  // blended additively: ~10 layers saturate red, ~25 reach yellow
+  if (debugView == 1) {
+    fragColor = vec4(0.1, 0.04, 0.0, 1.0);
+    return;
+  }
 
   vec4 texColor = inColor;
 
@@ -83,6 +98,11 @@ void main() {
 
   if (texColor.a == 0.0) discard;
 
+  if (debugView > 1) {
+    fragColor = vec4(debugView == 3 ? (textureIndex < 0.5 ? vec3(0.2) : debugColor(int(textureIndex))) : debugColor(batchIndex), 1.0);
+    return;
+  }
+
   if (!enableLighting) {
     fragColor = texColor;
     return;
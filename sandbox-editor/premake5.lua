@@ -1,7 +1,7 @@
 project "hyper-editor"
 	kind "ConsoleApp"
 	language "C++"
-	cppdialect "C++17"
+	cppdialect "C++20"
 	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
 	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
 
@@ -2,6 +2,8 @@
 #include <imgui.h>
 #include <renderer/renderer2d.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <string>
 
 EditorLayer::EditorLayer()
     : Layer("editor-layer") {
@@ -17,10 +19,25 @@ EditorLayer::EditorLayer()
 
 	m_scene = hyp::CreateScope<hyp::Scene>();
 
-	m_entity = m_scene->createEntity("Square");
+	hyp::Entity square = m_scene->createEntity("Square");
 
-	m_entity.get<hyp::TransformComponent>().size = { 100.f, 100.f };
-	m_entity.add<hyp::SpriteRendererComponent>(glm::vec4(1.0));
+	square.get<hyp::TransformComponent>().size = { 100.f, 100.f };
+	square.add<hyp::SpriteRendererComponent>(glm::vec4(1.0));
+
+	m_hierarchyPanel.setScene(m_scene.get());
+}
+
+void EditorLayer::spawnEntities(uint32_t count) {
+	// stress content for the hierarchy panel
+	uint32_t side = (uint32_t)std::ceil(std::sqrt((float)count));
+	for (uint32_t i = 0; i < count; i++)
+	{
+		hyp::Entity entity = m_scene->createEntity("Quad " + std::to_string(i));
+		auto& transform = entity.get<hyp::TransformComponent>();
+		transform.position = { (float)(i % side) * 12.f, (float)(i / side) * 12.f, 0.f };
+		transform.size = { 10.f, 10.f };
+		entity.add<hyp::SpriteRendererComponent>(glm::vec4((i % 7) / 7.f, (i % 5) / 5.f, (i % 3) / 3.f, 1.f));
+	}
 }
 
 void EditorLayer::onEvent(hyp::Event& event) {
@@ -37,8 +54,10 @@ void EditorLayer::onUpdate(float dt) {
 	hyp::RenderCommand::setClearColor(0.3, 0.4, 0.1, 1.f);
 	hyp::RenderCommand::clear();
 
+	m_scene->onUpdate(dt, m_renderList);
+
 	hyp::Renderer2D::beginScene(m_cameraController->getCamera().getViewProjectionMatrix());
-	m_scene->onUpdate(dt);
+	hyp::Renderer2D::drawRenderList(m_renderList);
 	hyp::Renderer2D::endScene();
 
 	m_framebuffer->unbind();
@@ -54,6 +73,13 @@ void EditorLayer::onUIRender() {
 			if (ImGui::MenuItem("Exit")) hyp::Application::get().close();
 			ImGui::EndMenu();
 		}
+		if (ImGui::BeginMenu("Scene"))
+		{
+			if (ImGui::MenuItem("Add entity")) m_scene->createEntity("Entity");
+			if (ImGui::MenuItem("Add 10k quads")) spawnEntities(10000);
+			if (ImGui::MenuItem("Add 100k quads")) spawnEntities(100000);
+			ImGui::EndMenu();
+		}
 		ImGui::EndMainMenuBar();
 	}
 
@@ -83,19 +109,5 @@ void EditorLayer::onUIRender() {
 	ImGui::PopStyleVar();
 	ImGui::ShowDemoWindow(&demo);
 
-	ImGui::Begin("Entity");
-	if (m_entity)
-	{
-		ImGui::Separator();
-		auto& tag = m_entity.get<hyp::TagComponent>().name;
-		ImGui::Text("%s", tag.c_str());
-		auto& pos = m_entity.get<hyp::TransformComponent>().position;
-		auto& size = m_entity.get<hyp::TransformComponent>().size;
-		auto& color = m_entity.get<hyp::SpriteRendererComponent>().color;
-		ImGui::DragFloat3("Position", glm::value_ptr(pos));
-		ImGui::DragFloat2("Size", glm::value_ptr(size));
-		ImGui::ColorEdit4("Color", glm::value_ptr(color));
-		ImGui::Separator();
-	}
-	ImGui::End();
+	m_hierarchyPanel.onUIRender();
 }
@@ -5,9 +5,11 @@
 	#include <glm/glm.hpp>
 	#include <renderer/framebuffer.hpp>
 	#include <renderer/orthographic_controller.hpp>
+	#include <renderer/render_list.hpp>
 	#include <scene/components.hpp>
 	#include <scene/entity.hpp>
 	#include <scene/scene.hpp>
+	#include "SceneHierarchyPanel.hpp"
 
 class EditorLayer : public hyp::Layer {
 public:
@@ -17,13 +19,18 @@ public:
 	virtual void onUpdate(float dt) override;
 	virtual void onUIRender();
 
+private:
+	void spawnEntities(uint32_t count);
+
 private:
 	hyp::Ref<hyp::Framebuffer> m_framebuffer;
 	glm::vec2 m_viewportSize;
 	hyp::Ref<hyp::OrthoGraphicCameraController> m_cameraController;
 	hyp::Unique<hyp::Scene> m_scene;
+	// extracted once per frame, shared by every view of the scene
+	hyp::RenderList m_renderList;
 	bool m_viewportFocused = false;
-	hyp::Entity m_entity;
+	SceneHierarchyPanel m_hierarchyPanel;
 };
 
 #endif //! HYPER_EDITOR_LAYER
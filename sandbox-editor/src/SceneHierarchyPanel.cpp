@@ -0,0 +1,332 @@
+#include "SceneHierarchyPanel.hpp"
+#include <imgui.h>
+#include <ui/inspector.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+	// rows re-tested per frame while a rescan is running
+	constexpr uint32_t ScanBudget = 16384;
+
+	uint32_t getIndex(entt::entity entity) {
+		return (uint32_t)entt::to_integral(entt::registry::entity(entity));
+	}
+
+	std::string toLower(std::string_view text) {
+		std::string lower(text);
+		std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return lower;
+	}
+
+	void copyToBuffer(char* buffer, size_t size, const std::string& text) {
+		size_t length = std::min(text.size(), size - 1);
+		std::memcpy(buffer, text.data(), length);
+		buffer[length] = '\0';
+	}
+}
+
+SceneHierarchyPanel::~SceneHierarchyPanel() {
+	disconnect();
+}
+
+void SceneHierarchyPanel::setScene(hyp::Scene* scene) {
+	disconnect();
+
+	m_scene = scene;
+	m_rows.clear();
+	m_matches.clear();
+	m_matchesStale = false;
+	m_scanning = false;
+	m_aliveCount = 0;
+	m_selected = entt::null;
+	m_nameInputEntity = entt::null;
+
+	if (!m_scene) return;
+
+	// the one full pass, everything afterwards is driven by signals
+	auto& registry = m_scene->getRegistry();
+	for (entt::entity entity : registry.view<hyp::TagComponent>())
+	{
+		Row& row = getRow(entity);
+		row.handle = entity;
+		row.alive = true;
+		updateName(row, registry.get<hyp::TagComponent>(entity).name);
+		if (registry.has<hyp::SpriteRendererComponent>(entity)) row.flags |= RowSprite;
+		if (registry.has<hyp::CircleRendererComponent>(entity)) row.flags |= RowCircle;
+		if (registry.has<hyp::ScriptComponent>(entity)) row.flags |= RowScript;
+		m_aliveCount++;
+	}
+
+	for (uint32_t i = 0; i < m_rows.size(); i++)
+	{
+		if (m_rows[i].alive && matchesFilter(m_rows[i])) list(i);
+	}
+
+	connect();
+}
+
+hyp::Entity SceneHierarchyPanel::getSelected() {
+	if (!m_scene || !m_scene->getRegistry().valid(m_selected)) return {};
+	return hyp::Entity(m_selected, m_scene);
+}
+
+void SceneHierarchyPanel::connect() {
+	auto& registry = m_scene->getRegistry();
+	registry.on_construct<hyp::TagComponent>().connect<&SceneHierarchyPanel::onTagConstructed>(*this);
+	registry.on_update<hyp::TagComponent>().connect<&SceneHierarchyPanel::onTagUpdated>(*this);
+	registry.on_destroy<hyp::TagComponent>().connect<&SceneHierarchyPanel::onTagDestroyed>(*this);
+
+	registry.on_construct<hyp::SpriteRendererComponent>().connect<&SceneHierarchyPanel::onComponentAdded<hyp::SpriteRendererComponent, RowSprite>>(*this);
+	registry.on_destroy<hyp::SpriteRendererComponent>().connect<&SceneHierarchyPanel::onComponentRemoved<hyp::SpriteRendererComponent, RowSprite>>(*this);
+	registry.on_construct<hyp::CircleRendererComponent>().connect<&SceneHierarchyPanel::onComponentAdded<hyp::CircleRendererComponent, RowCircle>>(*this);
+	registry.on_destroy<hyp::CircleRendererComponent>().connect<&SceneHierarchyPanel::onComponentRemoved<hyp::CircleRendererComponent, RowCircle>>(*this);
+	registry.on_construct<hyp::ScriptComponent>().connect<&SceneHierarchyPanel::onComponentAdded<hyp::ScriptComponent, RowScript>>(*this);
+	registry.on_destroy<hyp::ScriptComponent>().connect<&SceneHierarchyPanel::onComponentRemoved<hyp::ScriptComponent, RowScript>>(*this);
+}
+
+void SceneHierarchyPanel::disconnect() {
+	if (!m_scene) return;
+
+	auto& registry = m_scene->getRegistry();
+	registry.on_construct<hyp::TagComponent>().disconnect(*this);
+	registry.on_update<hyp::TagComponent>().disconnect(*this);
+	registry.on_destroy<hyp::TagComponent>().disconnect(*this);
+	registry.on_construct<hyp::SpriteRendererComponent>().disconnect(*this);
+	registry.on_destroy<hyp::SpriteRendererComponent>().disconnect(*this);
+	registry.on_construct<hyp::CircleRendererComponent>().disconnect(*this);
+	registry.on_destroy<hyp::CircleRendererComponent>().disconnect(*this);
+	registry.on_construct<hyp::ScriptComponent>().disconnect(*this);
+	registry.on_destroy<hyp::ScriptComponent>().disconnect(*this);
+}
+
+SceneHierarchyPanel::Row& SceneHierarchyPanel::getRow(entt::entity entity) {
+	uint32_t index = getIndex(entity);
+	if (index >= m_rows.size()) m_rows.resize(index + 1);
+	return m_rows[index];
+}
+
+bool SceneHierarchyPanel::matchesFilter(const Row& row) const {
+	return m_filter.empty() || row.lowerName.find(m_filter) != std::string::npos;
+}
+
+void SceneHierarchyPanel::updateName(Row& row, const std::string& name) {
+	row.name = name;
+	row.lowerName = toLower(name);
+}
+
+void SceneHierarchyPanel::list(uint32_t index) {
+	Row& row = m_rows[index];
+	if (row.listed) return;
+
+	row.listed = true;
+	m_matches.push_back(index);
+
+	// a full rescan has already passed this row and would drop it
+	if (m_scanning && !m_scanRefine && index < m_scanCursor) m_scanResult.push_back(index);
+}
+
+void SceneHierarchyPanel::onTagConstructed(entt::registry& registry, entt::entity entity) {
+	Row& row = getRow(entity);
+	// a recycled index keeps its place (and `listed`) in m_matches
+	row.handle = entity;
+	row.alive = true;
+	row.flags = RowNone;
+	updateName(row, registry.get<hyp::TagComponent>(entity).name);
+	m_aliveCount++;
+
+	if (matchesFilter(row)) list(getIndex(entity));
+}
+
+void SceneHierarchyPanel::onTagUpdated(entt::registry& registry, entt::entity entity) {
+	Row& row = getRow(entity);
+	updateName(row, registry.get<hyp::TagComponent>(entity).name);
+
+	if (matchesFilter(row))
+	{
+		list(getIndex(entity));
+	}
+	else if (row.listed)
+	{
+		m_matchesStale = true;
+	}
+}
+
+void SceneHierarchyPanel::onTagDestroyed(entt::registry& registry, entt::entity entity) {
+	Row& row = getRow(entity);
+	row.alive = false;
+	row.handle = entt::null;
+	m_aliveCount--;
+
+	if (row.listed) m_matchesStale = true;
+	if (m_selected == entity) m_selected = entt::null;
+}
+
+void SceneHierarchyPanel::setFilter(const std::string& filter) {
+	std::string lower = toLower(filter);
+	if (lower == m_filter) return;
+
+	// a longer filter containing the old one can only drop rows, so only the current matches are re-tested
+	bool refine = !m_scanning && !m_matchesStale && lower.find(m_filter) != std::string::npos;
+	m_filter = std::move(lower);
+	startScan(refine);
+}
+
+void SceneHierarchyPanel::startScan(bool refine) {
+	m_scanning = true;
+	m_scanRefine = refine;
+	m_scanCursor = 0;
+	m_scanResult.clear();
+}
+
+void SceneHierarchyPanel::continueScan() {
+	if (!m_scanning && m_matchesStale)
+	{
+		startScan(false);
+	}
+	if (!m_scanning) return;
+
+	const std::vector<uint32_t>* source = m_scanRefine ? &m_matches : nullptr;
+	uint32_t end = source ? (uint32_t)source->size() : (uint32_t)m_rows.size();
+	uint32_t stop = std::min(end, m_scanCursor + ScanBudget);
+
+	for (; m_scanCursor < stop; m_scanCursor++)
+	{
+		uint32_t index = source ? (*source)[m_scanCursor] : m_scanCursor;
+		const Row& row = m_rows[index];
+		if (row.alive && matchesFilter(row)) m_scanResult.push_back(index);
+	}
+
+	if (m_scanCursor < end) return;
+
+	for (uint32_t index : m_matches) m_rows[index].listed = false;
+	for (uint32_t index : m_scanResult) m_rows[index].listed = true;
+	m_matches.swap(m_scanResult);
+	m_scanResult.clear();
+
+	m_scanning = false;
+	m_matchesStale = false;
+}
+
+void SceneHierarchyPanel::onUIRender() {
+	continueScan();
+
+	renderOutliner();
+	renderInspector();
+}
+
+void SceneHierarchyPanel::renderOutliner() {
+	ImGui::Begin("Scene Hierarchy");
+	if (!m_scene)
+	{
+		ImGui::End();
+		return;
+	}
+
+	ImGui::SetNextItemWidth(-1.f);
+	if (ImGui::InputTextWithHint("##filter", "Filter", m_filterInput, sizeof(m_filterInput)))
+	{
+		setFilter(m_filterInput);
+	}
+
+	ImGui::TextDisabled("%u / %u entities", (uint32_t)m_matches.size(), m_aliveCount);
+	if (m_scanning)
+	{
+		uint32_t total = m_scanRefine ? (uint32_t)m_matches.size() : (uint32_t)m_rows.size();
+		ImGui::SameLine();
+		ImGui::TextDisabled("(filtering %u%%)", total ? m_scanCursor * 100 / total : 100);
+	}
+	ImGui::Separator();
+
+	entt::entity destroy = entt::null;
+
+	ImGui::BeginChild("##rows");
+	ImGuiListClipper clipper;
+	clipper.Begin((int)m_matches.size());
+	while (clipper.Step())
+	{
+		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+		{
+			uint32_t index = m_matches[i];
+			const Row& row = m_rows[index];
+
+			ImGui::PushID((int)index);
+			if (!row.alive)
+			{
+				// removed from the list by the next rescan
+				ImGui::TextDisabled("<destroyed>");
+				ImGui::PopID();
+				continue;
+			}
+
+			if (ImGui::Selectable(row.name.c_str(), m_selected == row.handle))
+			{
+				m_selected = row.handle;
+			}
+
+			if (ImGui::BeginPopupContextItem())
+			{
+				if (ImGui::MenuItem("Delete")) destroy = row.handle;
+				ImGui::EndPopup();
+			}
+
+			if (row.flags != RowNone)
+			{
+				ImGui::SameLine();
+				ImGui::TextDisabled("%s%s%s", (row.flags & RowSprite) ? " sprite" : "", (row.flags & RowCircle) ? " circle" : "",
+				    (row.flags & RowScript) ? " script" : "");
+			}
+			ImGui::PopID();
+		}
+	}
+	ImGui::EndChild();
+
+	// after the loop, the signal handlers edit the rows being drawn
+	if (destroy != entt::null) m_scene->destroyEntity(hyp::Entity(destroy, m_scene));
+
+	ImGui::End();
+}
+
+void SceneHierarchyPanel::renderInspector() {
+	ImGui::Begin("Inspector");
+
+	hyp::Entity entity = getSelected();
+	if (!entity)
+	{
+		ImGui::TextDisabled("Nothing selected");
+		ImGui::End();
+		return;
+	}
+
+	auto& registry = m_scene->getRegistry();
+	if (m_nameInputEntity != m_selected || !ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows))
+	{
+		copyToBuffer(m_nameInput, sizeof(m_nameInput), entity.get<hyp::TagComponent>().name);
+		m_nameInputEntity = m_selected;
+	}
+
+	if (ImGui::InputText("Name", m_nameInput, sizeof(m_nameInput)))
+	{
+		// patched so the outliner's on_update listener sees the rename
+		registry.patch<hyp::TagComponent>(m_selected, [&](hyp::TagComponent& tag) { tag.name = m_nameInput; });
+	}
+	ImGui::TextDisabled("id %u", (uint32_t)entt::to_integral(m_selected));
+
+	// widgets come from the components' HYP_REFLECT declarations
+	ImGui::Separator();
+	hyp::inspect(entity.get<hyp::TransformComponent>());
+
+	if (entity.has<hyp::SpriteRendererComponent>())
+	{
+		ImGui::Separator();
+		hyp::inspect(entity.get<hyp::SpriteRendererComponent>());
+	}
+
+	if (entity.has<hyp::CircleRendererComponent>())
+	{
+		ImGui::Separator();
+		hyp::inspect(entity.get<hyp::CircleRendererComponent>());
+	}
+
+	ImGui::End();
+}
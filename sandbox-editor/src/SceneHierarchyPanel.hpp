@@ -0,0 +1,107 @@
+#pragma once
+#ifndef HYPER_SCENE_HIERARCHY_PANEL
+	#define HYPER_SCENE_HIERARCHY_PANEL
+	#include <scene/components.hpp>
+	#include <scene/entity.hpp>
+	#include <scene/scene.hpp>
+	#include <cstdint>
+	#include <string>
+	#include <vector>
+
+/**
+* \brief outliner and inspector that cost the same per frame whether the scene has 10 or 100k entities.
+*
+* Each entity's row (name, lower-cased name for filtering, component flags) is cached, kept up to
+* date by registry signals, and never rebuilt per frame. Only the rows in view are submitted
+* (ImGuiListClipper). A filter that narrows the previous one only re-tests the previous matches.
+* Rescans happen a bounded number of rows per frame.
+*
+* Renames must go through registry.patch<TagComponent> (as the inspector does) to be seen.
+*/
+class SceneHierarchyPanel {
+public:
+	SceneHierarchyPanel() = default;
+	~SceneHierarchyPanel();
+
+	SceneHierarchyPanel(const SceneHierarchyPanel&) = delete;
+	SceneHierarchyPanel& operator=(const SceneHierarchyPanel&) = delete;
+
+	void setScene(hyp::Scene* scene);
+
+	void onUIRender();
+
+	hyp::Entity getSelected();
+
+private:
+	enum RowFlags : uint8_t
+	{
+		RowNone = 0,
+		RowSprite = 1 << 0,
+		RowCircle = 1 << 1,
+		RowScript = 1 << 2,
+	};
+
+	struct Row
+	{
+		entt::entity handle = entt::null;
+		std::string name;
+		std::string lowerName;
+		uint8_t flags = RowNone;
+		bool alive = false;
+		bool listed = false; // in m_matches
+	};
+
+	void renderOutliner();
+	void renderInspector();
+
+	Row& getRow(entt::entity entity);
+	bool matchesFilter(const Row& row) const;
+	void updateName(Row& row, const std::string& name);
+	void list(uint32_t index);
+
+	void setFilter(const std::string& filter);
+	void startScan(bool refine);
+	void continueScan();
+
+	void onTagConstructed(entt::registry& registry, entt::entity entity);
+	void onTagUpdated(entt::registry& registry, entt::entity entity);
+	void onTagDestroyed(entt::registry& registry, entt::entity entity);
+
+	template <typename T, RowFlags Flag>
+	void onComponentAdded(entt::registry& registry, entt::entity entity) {
+		getRow(entity).flags |= Flag;
+	}
+
+	template <typename T, RowFlags Flag>
+	void onComponentRemoved(entt::registry& registry, entt::entity entity) {
+		getRow(entity).flags &= ~Flag;
+	}
+
+	void connect();
+	void disconnect();
+
+private:
+	hyp::Scene* m_scene = nullptr;
+
+	// indexed by the entity index (without its version), so lookups from signals are O(1)
+	std::vector<Row> m_rows;
+	// row indices shown in the outliner
+	std::vector<uint32_t> m_matches;
+	bool m_matchesStale = false; // contains destroyed or renamed-away rows
+	uint32_t m_aliveCount = 0;
+
+	std::string m_filter; // lower-cased
+	char m_filterInput[128] = {};
+
+	// bounded rescan that replaces m_matches when finished
+	bool m_scanning = false;
+	bool m_scanRefine = false; // only re-test m_matches
+	uint32_t m_scanCursor = 0;
+	std::vector<uint32_t> m_scanResult;
+
+	entt::entity m_selected = entt::null;
+	char m_nameInput[128] = {};
+	entt::entity m_nameInputEntity = entt::null;
+};
+
+#endif //! HYPER_SCENE_HIERARCHY_PANEL
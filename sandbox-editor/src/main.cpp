@@ -3,6 +3,7 @@
 #include <renderer/renderer2d.hpp>
 #include <renderer/render_command.hpp>
 #include "EditorLayer.hpp"
+#include <debug/metrics.hpp>
 
 int main(int argc, char** argv) {
 	hyp::Device::init({});
@@ -13,6 +14,7 @@ int main(int argc, char** argv) {
 	hyp::Application app(props);
 	hyp::RenderCommand::init();
 	hyp::Renderer2D::init();
+	hyp::Metrics::startExporter(argc, argv); // --metrics[=path], see debug/metrics.hpp
 
 	app.pushLayer(new EditorLayer());
 
@@ -6,6 +6,7 @@
 #include <core/device.hpp>
 #include <core/window.hpp>
 #include "game_layer.hpp"
+#include <debug/metrics.hpp>
 
 int main(int argc, char** argv) {
 	hyp::Device::init({});
@@ -15,6 +16,7 @@ int main(int argc, char** argv) {
 	auto app = hyp::Application(props);
 	hyp::RenderCommand::init();
 	hyp::Renderer2D::init();
+	hyp::Metrics::startExporter(argc, argv); // --metrics[=path], see debug/metrics.hpp
 
 	app.pushLayer(new GameLayer());
 	app.run();
@@ -1,7 +1,7 @@
 project "sandbox"
 	kind "ConsoleApp"
 	language "C++"
-	cppdialect "C++17"
+	cppdialect "C++20"
 	staticruntime "off"
 	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
 	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
@@ -0,0 +1,40 @@
+-- packs asset directories into a single .hpak archive, see engine/src/io/archive_format.hpp
+project "asset-packer"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+	targetdir ("%{wks.location}/bin/%{wks.name}/%{cfg.longname}")
+	objdir ("%{wks.location}/bin-int/%{wks.name}/%{cfg.longname}")
+
+	files
+	{
+		"src/**.hpp", "src/**.cpp"
+	}
+
+	-- only the header-only archive format is shared, the packer doesn't link the engine
+	includedirs
+	{
+		"%{wks.location}/engine/src"
+	}
+
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	filter "options:with-lz4"
+		defines "HYPER_ARCHIVE_LZ4"
+		includedirs "%{includes.LZ4}"
+		links "LZ4"
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
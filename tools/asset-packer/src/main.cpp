@@ -0,0 +1,246 @@
+// asset-packer: packs asset directories into a single .hpak archive
+//
+//   asset-packer <output.hpak> <directory>... [--lz4] [--align <bytes>]
+//
+// Files are stored relative to the parent of the directory they were found in, so packing
+// `sandbox/assets` produces `assets/shaders/...`, the same paths the loaders ask for.
+
+#include <io/archive_format.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef HYPER_ARCHIVE_LZ4
+	#include <lz4hc.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+	struct InputFile
+	{
+		fs::path source;
+		std::string path;
+	};
+
+	struct Options
+	{
+		std::string output;
+		std::vector<std::string> directories;
+		uint32_t alignment = hyp::archive::DefaultAlignment;
+		bool compress = false;
+	};
+
+	void printUsage() {
+		std::fprintf(stderr, "usage: asset-packer <output.hpak> <directory>... [--lz4] [--align <bytes>]\n");
+	}
+
+	bool parseArguments(int argc, char** argv, Options& options) {
+		for (int i = 1; i < argc; i++)
+		{
+			std::string arg = argv[i];
+
+			if (arg == "--lz4")
+			{
+				options.compress = true;
+			}
+			else if (arg == "--align" && i + 1 < argc)
+			{
+				options.alignment = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+			}
+			else if (options.output.empty())
+			{
+				options.output = arg;
+			}
+			else
+			{
+				options.directories.push_back(arg);
+			}
+		}
+
+		bool powerOfTwo = options.alignment != 0 && (options.alignment & (options.alignment - 1)) == 0;
+		if (!powerOfTwo)
+		{
+			std::fprintf(stderr, "alignment must be a power of two\n");
+			return false;
+		}
+
+		return !options.output.empty() && !options.directories.empty();
+	}
+
+	bool readFile(const fs::path& path, std::vector<uint8_t>& data) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) return false;
+
+		std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+		data.resize((size_t)size);
+		return size == 0 || (bool)file.read((char*)data.data(), size);
+	}
+
+	void pad(std::ofstream& out, uint64_t alignment) {
+		static const char zeros[4096] = {};
+		uint64_t position = (uint64_t)out.tellp();
+		uint64_t padding = hyp::archive::alignUp(position, alignment) - position;
+		while (padding > 0)
+		{
+			uint64_t chunk = std::min<uint64_t>(padding, sizeof(zeros));
+			out.write(zeros, (std::streamsize)chunk);
+			padding -= chunk;
+		}
+	}
+
+	// compressed data is only kept when it saves at least an eighth, otherwise the
+	// entry stays uncompressed and can be handed out in place at runtime
+	bool compress(const std::vector<uint8_t>& data, std::vector<uint8_t>& compressed) {
+#ifdef HYPER_ARCHIVE_LZ4
+		if (data.empty()) return false;
+
+		compressed.resize((size_t)LZ4_compressBound((int)data.size()));
+		int size = LZ4_compress_HC((const char*)data.data(), (char*)compressed.data(), (int)data.size(),
+		    (int)compressed.size(), LZ4HC_CLEVEL_DEFAULT);
+		if (size <= 0 || (size_t)size > data.size() - data.size() / 8) return false;
+
+		compressed.resize((size_t)size);
+		return true;
+#else
+		(void)data;
+		(void)compressed;
+		return false;
+#endif
+	}
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parseArguments(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+#ifndef HYPER_ARCHIVE_LZ4
+	if (options.compress)
+	{
+		std::fprintf(stderr, "built without LZ4 support (premake --with-lz4), storing uncompressed\n");
+		options.compress = false;
+	}
+#endif
+
+	std::vector<InputFile> inputs;
+	for (const std::string& directory : options.directories)
+	{
+		fs::path root = fs::path(directory).lexically_normal();
+		if (!root.has_filename()) root = root.parent_path();
+
+		if (!fs::is_directory(root))
+		{
+			std::fprintf(stderr, "%s is not a directory\n", directory.c_str());
+			return 1;
+		}
+
+		for (const auto& item : fs::recursive_directory_iterator(root))
+		{
+			if (!item.is_regular_file()) continue;
+
+			fs::path relative = item.path().lexically_relative(root.parent_path());
+			inputs.push_back({ item.path(), hyp::archive::normalizePath(relative.generic_string()) });
+		}
+	}
+
+	// sorted input keeps the output byte-identical between runs
+	std::sort(inputs.begin(), inputs.end(), [](const InputFile& a, const InputFile& b) { return a.path < b.path; });
+
+	std::ofstream out(options.output, std::ios::binary | std::ios::trunc);
+	if (!out.is_open())
+	{
+		std::fprintf(stderr, "couldn't open %s for writing\n", options.output.c_str());
+		return 1;
+	}
+
+	hyp::archive::Header header {};
+	out.write((const char*)&header, sizeof(header));
+
+	std::vector<hyp::archive::Entry> entries;
+	std::string strings;
+	std::vector<uint8_t> data, compressed;
+	uint64_t totalSize = 0, totalStored = 0;
+
+	entries.reserve(inputs.size());
+	for (const InputFile& input : inputs)
+	{
+		if (!readFile(input.source, data))
+		{
+			std::fprintf(stderr, "couldn't read %s\n", input.source.string().c_str());
+			return 1;
+		}
+
+		bool compressedEntry = options.compress && compress(data, compressed);
+		const std::vector<uint8_t>& stored = compressedEntry ? compressed : data;
+
+		pad(out, options.alignment);
+
+		hyp::archive::Entry entry {};
+		entry.pathHash = hyp::archive::hashPath(input.path);
+		entry.offset = (uint64_t)out.tellp();
+		entry.storedSize = stored.size();
+		entry.size = data.size();
+		entry.pathOffset = (uint32_t)strings.size();
+		entry.pathLength = (uint32_t)input.path.size();
+		entry.flags = compressedEntry ? hyp::archive::EntryLZ4 : hyp::archive::EntryNone;
+		entries.push_back(entry);
+
+		out.write((const char*)stored.data(), (std::streamsize)stored.size());
+		strings += input.path;
+
+		totalSize += entry.size;
+		totalStored += entry.storedSize;
+	}
+
+	std::stable_sort(entries.begin(), entries.end(),
+	    [](const hyp::archive::Entry& a, const hyp::archive::Entry& b) { return a.pathHash < b.pathHash; });
+
+	for (size_t i = 1; i < entries.size(); i++)
+	{
+		if (entries[i].pathHash != entries[i - 1].pathHash) continue;
+
+		std::string_view a(strings.data() + entries[i - 1].pathOffset, entries[i - 1].pathLength);
+		std::string_view b(strings.data() + entries[i].pathOffset, entries[i].pathLength);
+		if (a == b)
+		{
+			std::fprintf(stderr, "%.*s is packed twice\n", (int)a.size(), a.data());
+			return 1;
+		}
+	}
+
+	pad(out, alignof(hyp::archive::Entry));
+	header.tocOffset = (uint64_t)out.tellp();
+	out.write((const char*)entries.data(), (std::streamsize)(entries.size() * sizeof(hyp::archive::Entry)));
+
+	header.stringsOffset = (uint64_t)out.tellp();
+	header.stringsSize = strings.size();
+	out.write(strings.data(), (std::streamsize)strings.size());
+
+	std::memcpy(header.magic, hyp::archive::Magic, sizeof(header.magic));
+	header.version = hyp::archive::Version;
+	header.entryCount = (uint32_t)entries.size();
+	header.alignment = options.alignment;
+
+	out.seekp(0);
+	out.write((const char*)&header, sizeof(header));
+
+	if (!out.good())
+	{
+		std::fprintf(stderr, "failed writing %s\n", options.output.c_str());
+		return 1;
+	}
+
+	std::printf("packed %zu files into %s: %llu bytes, %llu stored\n", entries.size(), options.output.c_str(),
+	    (unsigned long long)totalSize, (unsigned long long)totalStored);
+	return 0;
+}